@@ -0,0 +1,31 @@
+#include <Arduino.h>
+#include <HwTimer.h>
+
+#define LED_PIN 13
+
+
+static void blink()
+{
+  digitalWrite(LED_PIN, !digitalRead(LED_PIN));
+}
+
+/* the application binds the interrupt vector of the mode */
+ISR(TIMER1_CAPT_vect)
+{
+  HwTimer1Ctc::handleInterrupt();
+}
+
+void setup() {
+  // put your setup code here, to run once:
+  pinMode(LED_PIN, OUTPUT);
+  HwTimer1Ctc::init(500000uL, blink);
+  HwTimer1Ctc::start();
+  HwTimer2Pwm::init(1000uL);
+  HwTimer2Pwm::enablePwm(HwTimer2Pwm::CHANNEL_B, 64u);
+  HwTimer2Pwm::start();
+}
+
+void loop() {
+  // put your main code here, to run repeatedly:
+
+}
@@ -0,0 +1,685 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       HwTimer.h
+ *      \brief      Main header file of HwTimer library
+ *
+ *      \details    One driver for Timer1 and Timer2, the timer is selected by a traits class (see HwTimerTraits.h) and the
+ *                  waveform generation mode by a mode policy. Everything is resolved during compilation, all members
+ *                  are static, so no object is needed and the registers are accessed directly.
+ *                  The interrupt vector is bound by the application:
+ *                  ISR(TIMER1_OVF_vect) { HwTimer1Pwm::handleInterrupt(); }
+ *
+ *****************************************************************************************************************************************************/
+#ifndef _HWTIMER_H_
+#define _HWTIMER_H_
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include "Arduino.h"
+#include <avr/io.h>
+#include <util/atomic.h>
+#include <StandardTypes.h>
+#include <HwTimerTraits.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define HWTIMER_REG_CS_GP                           0u
+#define HWTIMER_REG_CS_GM                           B111
+
+/* waveform generation mode bits WGMn0 and WGMn1 in TCCRnA, WGMn2 and WGMn3 in TCCRnB */
+#define HWTIMER_REG_WGM_A_GP                        0u
+#define HWTIMER_REG_WGM_A_GM                        B11
+#define HWTIMER_REG_WGM_B_GP                        3u
+#define HWTIMER_REG_WGM_B_GM                        B11000
+
+#if __cplusplus < 201103L
+# define nullptr NULL
+#endif
+
+/******************************************************************************************************************************************************
+ *  LOCAL FUNCTION MACROS
+ *****************************************************************************************************************************************************/
+
+
+/******************************************************************************************************************************************************
+ *  GLOBAL DATA TYPES AND STRUCTURES
+ *****************************************************************************************************************************************************/
+/* mode policies, every policy describes the counting and the waveform generation mode of each timer */
+
+/* clear timer on compare match, counter counts up to TOP, interrupt at TOP */
+struct HwTimerModeCtc
+{
+    static const bool DUAL_SLOPE = false;
+    static const bool PWM = false;
+    template <class Traits> struct Waveform { static const byte Value = Traits::WGM_CTC; };
+};
+
+/* fast pwm, counter counts up to TOP, interrupt at TOP */
+struct HwTimerModeFastPwm
+{
+    static const bool DUAL_SLOPE = false;
+    static const bool PWM = true;
+    template <class Traits> struct Waveform { static const byte Value = Traits::WGM_FAST_PWM; };
+};
+
+/* phase correct pwm, counter counts up to TOP and down to BOTTOM, interrupt at BOTTOM */
+struct HwTimerModePhaseCorrect
+{
+    static const bool DUAL_SLOPE = true;
+    static const bool PWM = true;
+    template <class Traits> struct Waveform { static const byte Value = Traits::WGM_PHASE_CORRECT; };
+};
+
+/* phase and frequency correct pwm, like phase correct but compare registers are updated at BOTTOM, only Timer1 */
+struct HwTimerModePhaseFrequencyCorrect
+{
+    static const bool DUAL_SLOPE = true;
+    static const bool PWM = true;
+    template <class Traits> struct Waveform { static const byte Value = Traits::WGM_PHASE_FREQUENCY_CORRECT; };
+};
+
+
+/* compile time prescaler ladder, selects the smallest prescaler where the timer cycles fit into the counter */
+template <class Traits, uint32_t TimerCycles, byte ClockSelect, bool Last = (ClockSelect >= Traits::NUMBER_OF_PRESCALERS)>
+struct HwTimerClockSelect
+{
+    static const byte Value = ((TimerCycles >> Traits::template PrescaleShift<ClockSelect>::Value) < (1uL << Traits::NUMBER_OF_BITS)) ?
+                              ClockSelect : HwTimerClockSelect<Traits, TimerCycles, ClockSelect + 1u>::Value;
+};
+
+template <class Traits, uint32_t TimerCycles, byte ClockSelect>
+struct HwTimerClockSelect<Traits, TimerCycles, ClockSelect, true>
+{
+    static const byte Value = ClockSelect;
+};
+
+
+/* access of timer registers, 16 bit registers share the TEMP register, so their access has to be atomic */
+template <bool Atomic>
+struct HwTimerAccess
+{
+    template <typename R, typename T> static void write(R& Register, T Value) { ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { Register = Value; } }
+    template <typename T, typename R> static T read(R& Register) { T Value; ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { Value = Register; } return Value; }
+};
+
+template <>
+struct HwTimerAccess<false>
+{
+    template <typename R, typename T> static void write(R& Register, T Value) { Register = Value; }
+    template <typename T, typename R> static T read(R& Register) { return Register; }
+};
+
+
+/******************************************************************************************************************************************************
+ *  CLASS  HwTimer
+ *****************************************************************************************************************************************************/
+template <class Traits, class Mode>
+class HwTimer
+{
+/******************************************************************************************************************************************************
+ *  P U B L I C   D A T A   T Y P E S   A N D   S T R U C T U R E S
+******************************************************************************************************************************************************/
+  public:
+    /* Timer ISR callback function */
+    typedef void (*TimerIsrCallbackF_void)(void);
+    typedef typename Traits::CounterType CounterType;
+
+    /* Type which describes the internal state of the HwTimer */
+    enum StateType {
+        STATE_INIT,
+        STATE_IDLE,
+        STATE_RUNNING,
+        STATE_STOPPED
+    };
+
+    /* Type which includes the pwm channels */
+    enum ChannelType {
+        CHANNEL_A,
+        CHANNEL_B
+    };
+
+    /* compile time calculation of prescaler and timer top value, same ladder as setPeriod(uint32_t) */
+    template <uint32_t Microseconds>
+    struct Period
+    {
+        /* in dual slope modes one period is counting up and down, so divide timer cycles by 2 */
+        static const uint32_t TimerCycles = ((F_CPU / 1000000uL) * Microseconds) >> (Mode::DUAL_SLOPE ? 1u : 0u);
+        static const byte ClockSelectBitGroup = HwTimerClockSelect<Traits, TimerCycles, 1u>::Value;
+        static const byte PrescaleShiftScale = Traits::template PrescaleShift<ClockSelectBitGroup>::Value;
+        static const CounterType Top = (TimerCycles >> PrescaleShiftScale) - (Mode::DUAL_SLOPE ? 0u : 1u);
+        /* request out of bounds? */
+        STATIC_ASSERT((Microseconds > 0u) && (Microseconds <= (0xFFFFFFFFuL / (F_CPU / 1000000uL))) &&
+                      ((TimerCycles >> PrescaleShiftScale) < (1uL << Traits::NUMBER_OF_BITS)), PeriodOutOfBounds);
+    };
+
+/******************************************************************************************************************************************************
+ *  P R I V A T E   D A T A   A N D   F U N C T I N O N S
+******************************************************************************************************************************************************/
+  private:
+    typedef HwTimerAccess<Traits::ATOMIC_ACCESS> Access;
+
+    /* all members are static, the timer is not instantiated */
+    HwTimer();
+    ~HwTimer();
+    HwTimer(const HwTimer&);
+
+    /* mode has to be supported by the timer */
+    STATIC_ASSERT(Mode::template Waveform<Traits>::Value != HWTIMER_WGM_NOT_AVAILABLE, HwTimerModeNotAvailable);
+
+    static TimerIsrCallbackF_void TimerCallback;
+    static StateType State;
+    static byte ClockSelectBitGroup;
+    static byte PrescaleShiftScale;
+    /* copy of TOP, used by setPwmDuty and read */
+    static CounterType Top;
+    /* counting direction in dual slope modes, kept by read and interrupt */
+    static volatile bool CountingDown;
+
+    static void setTop(byte, CounterType);
+    static byte getInterruptBit() { return (Mode::PWM) ? Traits::OVERFLOW_INTERRUPT : Traits::TOP_INTERRUPT; }
+
+/******************************************************************************************************************************************************
+ *  P U B L I C   F U N C T I O N S
+******************************************************************************************************************************************************/
+  public:
+    // get methods
+    static StateType getState() { return State; }
+    static CounterType getTop() { return Top; }
+    static stdReturnType read(uint32_t&);
+    static stdReturnType readCounter(uint32_t&);
+
+    // set methods
+    static stdReturnType init(uint32_t = 1000uL, TimerIsrCallbackF_void = nullptr);
+    static stdReturnType setPeriod(uint32_t);
+    template <uint32_t Microseconds> static stdReturnType setPeriod();
+    static stdReturnType enablePwm(ChannelType, CounterType);
+    static stdReturnType disablePwm(ChannelType);
+    static stdReturnType setPwmDuty(ChannelType, CounterType);
+    static stdReturnType start();
+    static void stop();
+    static stdReturnType resume();
+    static stdReturnType attachInterrupt(TimerIsrCallbackF_void);
+    static void detachInterrupt();
+    static void handleInterrupt();
+};
+
+
+/* the four drivers of this repository */
+typedef HwTimer<HwTimer1Traits, HwTimerModeCtc> HwTimer1Ctc;
+typedef HwTimer<HwTimer1Traits, HwTimerModePhaseFrequencyCorrect> HwTimer1Pwm;
+typedef HwTimer<HwTimer2Traits, HwTimerModeCtc> HwTimer2Ctc;
+typedef HwTimer<HwTimer2Traits, HwTimerModePhaseCorrect> HwTimer2Pwm;
+
+
+/******************************************************************************************************************************************************
+ * S T A T I C   D A T A
+ *****************************************************************************************************************************************************/
+template <class Traits, class Mode>
+typename HwTimer<Traits, Mode>::TimerIsrCallbackF_void HwTimer<Traits, Mode>::TimerCallback = nullptr;
+
+template <class Traits, class Mode>
+typename HwTimer<Traits, Mode>::StateType HwTimer<Traits, Mode>::State = HwTimer<Traits, Mode>::STATE_INIT;
+
+template <class Traits, class Mode>
+byte HwTimer<Traits, Mode>::ClockSelectBitGroup = 0u;
+
+template <class Traits, class Mode>
+byte HwTimer<Traits, Mode>::PrescaleShiftScale = 0u;
+
+template <class Traits, class Mode>
+typename HwTimer<Traits, Mode>::CounterType HwTimer<Traits, Mode>::Top = 0u;
+
+template <class Traits, class Mode>
+volatile bool HwTimer<Traits, Mode>::CountingDown = false;
+
+
+/******************************************************************************************************************************************************
+ * P U B L I C   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  init()
+******************************************************************************************************************************************************/
+/*! \brief          initialization of the timer hardware
+ *  \details        this functions initializes the timer hardware with the waveform generation mode of the mode policy
+ *
+ *  \param[in]      Microseconds				period of the timer interrupt
+ *  \param[in]      sTimerCallback				timer callback function
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre			Timer has to be in INIT STATE
+ *****************************************************************************************************************************************************/
+template <class Traits, class Mode>
+stdReturnType HwTimer<Traits, Mode>::init(uint32_t Microseconds, TimerIsrCallbackF_void sTimerCallback)
+{
+    stdReturnType ReturnValue = E_NOT_OK;
+
+    if(STATE_INIT == State) {
+        ReturnValue = E_OK;
+        /* clear control register */
+        Traits::tccra() = 0u;
+        Traits::tccrb() = 0u;
+        /* set waveform generation mode */
+        writeBitGroup(Traits::tccra(), HWTIMER_REG_WGM_A_GM, HWTIMER_REG_WGM_A_GP, Mode::template Waveform<Traits>::Value);
+        writeBitGroup(Traits::tccrb(), HWTIMER_REG_WGM_B_GM, HWTIMER_REG_WGM_B_GP, (Mode::template Waveform<Traits>::Value >> 2u));
+
+        if(E_NOT_OK == setPeriod(Microseconds)) ReturnValue = E_NOT_OK;
+        if(sTimerCallback != nullptr) TimerCallback = sTimerCallback;
+        State = STATE_IDLE;
+    }
+    return ReturnValue;
+} /* init */
+
+
+/******************************************************************************************************************************************************
+  setPeriod()
+******************************************************************************************************************************************************/
+/*! \brief          set period of timer interrupt
+ *  \details        the prescaler is selected as small as possible to get the best resolution
+ *
+ *  \param[in]      Microseconds				period of the timer interrupt
+ *  \return         E_OK
+ *                  E_NOT_OK					period out of bounds, maximum period is set
+ *****************************************************************************************************************************************************/
+template <class Traits, class Mode>
+stdReturnType HwTimer<Traits, Mode>::setPeriod(uint32_t Microseconds)
+{
+    stdReturnType ReturnValue = E_NOT_OK;
+    uint32_t TimerCycles;
+    byte sClockSelectBitGroup = 1u;
+
+    /* was request out of bounds? */
+    if((Microseconds > 0u) && (Microseconds <= (0xFFFFFFFFuL / (F_CPU / 1000000uL)))) {
+        /* in dual slope modes one period is counting up and down, so divide timer cycles by 2 */
+        TimerCycles = ((F_CPU / 1000000uL) * Microseconds) >> (Mode::DUAL_SLOPE ? 1u : 0u);
+        /* calculate timer prescaler */
+        while((sClockSelectBitGroup < Traits::NUMBER_OF_PRESCALERS) &&
+              ((TimerCycles >> Traits::getPrescaleShift(sClockSelectBitGroup)) >= (1uL << Traits::NUMBER_OF_BITS))) {
+            sClockSelectBitGroup++;
+        }
+        TimerCycles >>= Traits::getPrescaleShift(sClockSelectBitGroup);
+        if(TimerCycles < (1uL << Traits::NUMBER_OF_BITS)) {
+            ReturnValue = E_OK;
+            setTop(sClockSelectBitGroup, TimerCycles - (Mode::DUAL_SLOPE ? 0u : 1u));
+        }
+    }
+    /* request was out of bounds, set as maximum */
+    if(E_NOT_OK == ReturnValue) setTop(Traits::NUMBER_OF_PRESCALERS, (CounterType) ((1uL << Traits::NUMBER_OF_BITS) - 1u));
+    return ReturnValue;
+} /* setPeriod */
+
+
+/******************************************************************************************************************************************************
+  setPeriod()
+******************************************************************************************************************************************************/
+/*! \brief          set period of timer interrupt at compile time
+ *  \details        prescaler and timer top value are calculated during compilation, so only the register stores
+ *                  remain. Out of bounds requests fail to compile.
+ *  \tparam         Microseconds				period of the timer interrupt
+ *  \return         E_OK
+ *****************************************************************************************************************************************************/
+template <class Traits, class Mode>
+template <uint32_t Microseconds>
+stdReturnType HwTimer<Traits, Mode>::setPeriod()
+{
+    setTop(Period<Microseconds>::ClockSelectBitGroup, Period<Microseconds>::Top);
+    return E_OK;
+} /* setPeriod */
+
+
+/******************************************************************************************************************************************************
+  enablePwm()
+******************************************************************************************************************************************************/
+/*! \brief          enable pwm on given channel
+ *  \details        this function enables non-inverting pwm on given channel with given duty cycle
+ *
+ *  \param[in]      Channel					channel where pwm should be enabled
+ *  \param[in]      DutyCycle				duty cycle of pwm, full range of the counter width
+ *  \return         E_OK
+ *                  E_NOT_OK				channel not available or mode is not a pwm mode
+ *  \pre			Timer has to be in IDLE, RUNNING or STOPPED STATE
+ *****************************************************************************************************************************************************/
+template <class Traits, class Mode>
+stdReturnType HwTimer<Traits, Mode>::enablePwm(ChannelType Channel, CounterType DutyCycle)
+{
+    stdReturnType ReturnValue = setPwmDuty(Channel, DutyCycle);
+
+    if(E_OK == ReturnValue) {
+        if(CHANNEL_A == Channel) {
+            pinMode(Traits::CHANNEL_A_ARDUINO_PIN, OUTPUT);
+            /* activate compare output mode in timer control register */
+            writeBit(Traits::tccra(), Traits::COM_A1, 1u);
+        } else {
+            pinMode(Traits::CHANNEL_B_ARDUINO_PIN, OUTPUT);
+            /* activate compare output mode in timer control register */
+            writeBit(Traits::tccra(), Traits::COM_B1, 1u);
+        }
+    }
+    return ReturnValue;
+} /* enablePwm */
+
+
+/******************************************************************************************************************************************************
+  disablePwm()
+******************************************************************************************************************************************************/
+/*! \brief          disable pwm on given channel
+ *  \details
+ *
+ *  \param[in]      Channel					channel where pwm should be disabled
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *****************************************************************************************************************************************************/
+template <class Traits, class Mode>
+stdReturnType HwTimer<Traits, Mode>::disablePwm(ChannelType Channel)
+{
+    stdReturnType ReturnValue = E_NOT_OK;
+
+    if((CHANNEL_A == Channel) && Traits::CHANNEL_A_AVAILABLE) {
+        ReturnValue = E_OK;
+        /* deactivate compare output mode in timer control register */
+        writeBit(Traits::tccra(), Traits::COM_A1, 0u);
+    } else if(CHANNEL_B == Channel) {
+        ReturnValue = E_OK;
+        /* deactivate compare output mode in timer control register */
+        writeBit(Traits::tccra(), Traits::COM_B1, 0u);
+    }
+    return ReturnValue;
+} /* disablePwm */
+
+
+/******************************************************************************************************************************************************
+  setPwmDuty()
+******************************************************************************************************************************************************/
+/*! \brief          set pwm duty cycle on given channel
+ *  \details        the compare value is calculated from the cached TOP value
+ *
+ *  \param[in]      Channel					channel where pwm duty cycle should be set
+ *  \param[in]      DutyCycle				duty cycle of pwm, full range of the counter width
+ *  \return         E_OK
+ *                  E_NOT_OK				channel not available or mode is not a pwm mode
+ *  \pre			Timer has to be in IDLE, RUNNING or STOPPED STATE
+ *****************************************************************************************************************************************************/
+template <class Traits, class Mode>
+stdReturnType HwTimer<Traits, Mode>::setPwmDuty(ChannelType Channel, CounterType DutyCycle)
+{
+    stdReturnType ReturnValue = E_NOT_OK;
+    CounterType DutyCycleTrans;
+
+    if(Mode::PWM && (STATE_INIT != State)) {
+        /* use rule of three to calculate duty cycle related to timer top value */
+        DutyCycleTrans = ((uint32_t) Top * DutyCycle) >> Traits::NUMBER_OF_BITS;
+        /* set output compare register value for given channel */
+        if((CHANNEL_A == Channel) && Traits::CHANNEL_A_AVAILABLE) {
+            ReturnValue = E_OK;
+            Access::write(Traits::ocra(), DutyCycleTrans);
+        } else if(CHANNEL_B == Channel) {
+            ReturnValue = E_OK;
+            Access::write(Traits::ocrb(), DutyCycleTrans);
+        }
+    }
+    return ReturnValue;
+} /* setPwmDuty */
+
+
+/******************************************************************************************************************************************************
+  start()
+******************************************************************************************************************************************************/
+/*! \brief          start timer
+ *  \details        the counter is reset and the interrupt is enabled if a callback is set
+ *
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre			Timer has to be in IDLE or STOPPED STATE
+ *****************************************************************************************************************************************************/
+template <class Traits, class Mode>
+stdReturnType HwTimer<Traits, Mode>::start()
+{
+    stdReturnType ReturnValue = E_NOT_OK;
+
+    if((STATE_IDLE == State) || (STATE_STOPPED == State)) {
+        ReturnValue = E_OK;
+        /* reset counter value and direction */
+        Access::write(Traits::tcnt(), (CounterType) 0u);
+        CountingDown = false;
+        /* clear flags of the stopped counter, otherwise get phantom interrupt */
+        Traits::tifr() = (1u << Traits::OVERFLOW_FLAG) | (1u << Traits::TOP_FLAG);
+        if(TimerCallback != nullptr) writeBit(Traits::timsk(), getInterruptBit(), 1u);
+        /* start counter by setting clock select register */
+        writeBitGroup(Traits::tccrb(), HWTIMER_REG_CS_GM, HWTIMER_REG_CS_GP, ClockSelectBitGroup);
+        State = STATE_RUNNING;
+    }
+    return ReturnValue;
+} /* start */
+
+
+/******************************************************************************************************************************************************
+  stop()
+******************************************************************************************************************************************************/
+/*! \brief          stop timer
+ *  \details
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+template <class Traits, class Mode>
+void HwTimer<Traits, Mode>::stop()
+{
+    /* stop counter by clearing clock select register */
+    writeBitGroup(Traits::tccrb(), HWTIMER_REG_CS_GM, HWTIMER_REG_CS_GP, 0u);
+    if(STATE_RUNNING == State) State = STATE_STOPPED;
+} /* stop */
+
+
+/******************************************************************************************************************************************************
+  resume()
+******************************************************************************************************************************************************/
+/*! \brief          resume timer
+ *  \details
+ *
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre			Timer has to be in STOPPED STATE
+ *****************************************************************************************************************************************************/
+template <class Traits, class Mode>
+stdReturnType HwTimer<Traits, Mode>::resume()
+{
+    stdReturnType ReturnValue = E_NOT_OK;
+
+    if(STATE_STOPPED == State) {
+        ReturnValue = E_OK;
+        /* resume counter by setting clock select register */
+        writeBitGroup(Traits::tccrb(), HWTIMER_REG_CS_GM, HWTIMER_REG_CS_GP, ClockSelectBitGroup);
+        State = STATE_RUNNING;
+    }
+    return ReturnValue;
+} /* resume */
+
+
+/******************************************************************************************************************************************************
+  attachInterrupt()
+******************************************************************************************************************************************************/
+/*! \brief          set timer callback
+ *  \details        the callback is called at TOP in CTC and fast pwm mode, at BOTTOM in dual slope modes
+ *
+ *  \param[in]      sTimerCallback				timer callback function
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *****************************************************************************************************************************************************/
+template <class Traits, class Mode>
+stdReturnType HwTimer<Traits, Mode>::attachInterrupt(TimerIsrCallbackF_void sTimerCallback)
+{
+    stdReturnType ReturnValue = E_NOT_OK;
+
+    if(sTimerCallback != nullptr) {
+        ReturnValue = E_OK;
+        TimerCallback = sTimerCallback;
+        /* enable timer interrupt */
+        if(STATE_RUNNING == State) writeBit(Traits::timsk(), getInterruptBit(), 1u);
+    }
+    return ReturnValue;
+} /* attachInterrupt */
+
+
+/******************************************************************************************************************************************************
+  detachInterrupt()
+******************************************************************************************************************************************************/
+/*! \brief          disable timer interrupt
+ *  \details
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+template <class Traits, class Mode>
+void HwTimer<Traits, Mode>::detachInterrupt()
+{
+    writeBit(Traits::timsk(), getInterruptBit(), 0u);
+    TimerCallback = nullptr;
+} /* detachInterrupt */
+
+
+/******************************************************************************************************************************************************
+  read()
+******************************************************************************************************************************************************/
+/*! \brief          read current position in the period in microseconds
+ *  \details
+ *
+ *  \param[out]     Microseconds				time since begin of period
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre			Timer has to be in RUNNING or STOPPED STATE
+ *****************************************************************************************************************************************************/
+template <class Traits, class Mode>
+stdReturnType HwTimer<Traits, Mode>::read(uint32_t& Microseconds)
+{
+    stdReturnType ReturnValue;
+    uint32_t Ticks;
+
+    ReturnValue = readCounter(Ticks);
+    /* transform timer ticks to microseconds, prescaler is a power of two */
+    if(E_OK == ReturnValue) Microseconds = (Ticks << PrescaleShiftScale) / (F_CPU / 1000000uL);
+    return ReturnValue;
+} /* read */
+
+
+/******************************************************************************************************************************************************
+  readCounter()
+******************************************************************************************************************************************************/
+/*! \brief          read current position in the period in timer ticks
+ *  \details        in dual slope modes the counting direction is taken from the TOP and BOTTOM flags, so no waiting
+ *                  for the counter is needed. Only if neither the interrupt is enabled nor the counter was read within
+ *                  half a period, both flags are set and the direction is found out by waiting one counter tick.
+ *  \param[out]     Ticks						timer ticks since begin of period
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre			Timer has to be in RUNNING or STOPPED STATE
+ *****************************************************************************************************************************************************/
+template <class Traits, class Mode>
+stdReturnType HwTimer<Traits, Mode>::readCounter(uint32_t& Ticks)
+{
+    const byte PhaseFlags = (1u << Traits::OVERFLOW_FLAG) | (1u << Traits::TOP_FLAG);
+    stdReturnType ReturnValue = E_NOT_OK;
+    CounterType CounterValue;
+    CounterType CounterValueNext;
+    byte Flags;
+
+    if((STATE_RUNNING == State) || (STATE_STOPPED == State)) {
+        ReturnValue = E_OK;
+        if(Mode::DUAL_SLOPE) {
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+                /* save current timer value, read it again if TOP or BOTTOM was passed while reading */
+                Flags = Traits::tifr() & PhaseFlags;
+                CounterValue = Traits::tcnt();
+                if(Flags != (Traits::tifr() & PhaseFlags)) {
+                    Flags = Traits::tifr() & PhaseFlags;
+                    CounterValue = Traits::tcnt();
+                }
+                if((1u << Traits::TOP_FLAG) == Flags) {
+                    /* TOP was passed since last BOTTOM */
+                    CountingDown = true;
+                } else if(Flags & (1u << Traits::OVERFLOW_FLAG)) {
+                    if(((1u << Traits::OVERFLOW_FLAG) == Flags) || (Traits::timsk() & (1u << Traits::OVERFLOW_INTERRUPT))) {
+                        /* BOTTOM was passed, pending interrupt means BOTTOM was passed last */
+                        CountingDown = false;
+                    } else if(STATE_RUNNING == State) {
+                        /* TOP and BOTTOM were passed, wait one counter tick, needed to find out counter counting up or down */
+                        do { CounterValueNext = Traits::tcnt(); } while (CounterValueNext == CounterValue);
+                        CountingDown = (CounterValueNext < CounterValue);
+                    }
+                }
+                /* clear evaluated flags, a pending interrupt is cleared by hardware */
+                if(Traits::timsk() & (1u << Traits::OVERFLOW_INTERRUPT)) Flags &= ~(1u << Traits::OVERFLOW_FLAG);
+                Traits::tifr() = Flags;
+            }
+            /* if counter counting down, add top value to current value */
+            if(CountingDown) Ticks = (2uL * Top) - CounterValue;
+            else Ticks = CounterValue;
+        } else {
+            Ticks = Access::template read<CounterType>(Traits::tcnt());
+        }
+    }
+    return ReturnValue;
+} /* readCounter */
+
+
+/******************************************************************************************************************************************************
+  handleInterrupt()
+******************************************************************************************************************************************************/
+/*! \brief          handle timer interrupt
+ *  \details        this function has to be called by the interrupt of the application, TIMERn_OVF_vect in pwm modes,
+ *                  TIMER1_CAPT_vect or TIMER2_COMPA_vect in CTC mode
+ *  \return         -
+ *****************************************************************************************************************************************************/
+template <class Traits, class Mode>
+void HwTimer<Traits, Mode>::handleInterrupt()
+{
+    if(Mode::DUAL_SLOPE) {
+        /* counter is at BOTTOM, so it counts up again */
+        CountingDown = false;
+        Traits::tifr() = (1u << Traits::TOP_FLAG);
+    }
+    if(TimerCallback != nullptr) TimerCallback();
+} /* handleInterrupt */
+
+
+/******************************************************************************************************************************************************
+ * P R I V A T E   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  setTop()
+******************************************************************************************************************************************************/
+/*! \brief          set prescaler and timer top value
+ *  \details        the prescaler is only written to the hardware if the timer is running
+ *
+ *  \param[in]      sClockSelectBitGroup		value of clock select bit group
+ *  \param[in]      sTop						timer top value
+ *  \return         -
+ *****************************************************************************************************************************************************/
+template <class Traits, class Mode>
+void HwTimer<Traits, Mode>::setTop(byte sClockSelectBitGroup, CounterType sTop)
+{
+    ClockSelectBitGroup = sClockSelectBitGroup;
+    PrescaleShiftScale = Traits::getPrescaleShift(sClockSelectBitGroup);
+    Top = sTop;
+    Access::write(Traits::top(), sTop);
+
+    if(STATE_RUNNING == State) {
+        /* reset clock select register, and starts the clock */
+        writeBitGroup(Traits::tccrb(), HWTIMER_REG_CS_GM, HWTIMER_REG_CS_GP, ClockSelectBitGroup);
+    }
+} /* setTop */
+
+#endif
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
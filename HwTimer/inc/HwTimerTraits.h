@@ -0,0 +1,169 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       HwTimerTraits.h
+ *      \brief      Hardware description of Timer1 and Timer2 for HwTimer
+ *
+ *      \details    Register access, counter width, prescaler set and waveform generation modes of every timer.
+ *                  All functions are inline, so the registers are accessed directly.
+ *
+ *****************************************************************************************************************************************************/
+#ifndef _HWTIMERTRAITS_H_
+#define _HWTIMERTRAITS_H_
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include "Arduino.h"
+#include <avr/io.h>
+#include <StandardTypes.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL FUNCTION MACROS
+ *****************************************************************************************************************************************************/
+
+
+/******************************************************************************************************************************************************
+ *  GLOBAL DATA TYPES AND STRUCTURES
+ *****************************************************************************************************************************************************/
+/* type of a register, on the host simulator registers are objects instead of memory locations */
+#define HwTimerRegister(Register)                   __typeof__(Register)
+
+/* waveform generation mode which is not supported by a timer */
+#define HWTIMER_WGM_NOT_AVAILABLE                   0xFFu
+
+
+/******************************************************************************************************************************************************
+ *  CLASS  HwTimer1Traits
+ *****************************************************************************************************************************************************/
+/* Timer1: 16 bit, TOP is ICR1 in all modes, so OC1A and OC1B are available for pwm */
+struct HwTimer1Traits
+{
+    typedef uint16_t CounterType;
+
+    static const byte NUMBER_OF_BITS = 16u;
+    /* 16 bit registers are accessed through the shared TEMP register, so accesses have to be atomic */
+    static const bool ATOMIC_ACCESS = true;
+    static const bool CHANNEL_A_AVAILABLE = true;
+    static const byte CHANNEL_A_ARDUINO_PIN = 9u;
+    static const byte CHANNEL_B_ARDUINO_PIN = 10u;
+
+    /* waveform generation modes with TOP in ICR1 */
+    static const byte WGM_CTC = 12u;
+    static const byte WGM_FAST_PWM = 14u;
+    static const byte WGM_PHASE_CORRECT = 10u;
+    static const byte WGM_PHASE_FREQUENCY_CORRECT = 8u;
+
+    /* flag and interrupt enable bit set when counter reaches TOP in CTC mode */
+    static const byte TOP_FLAG = ICF1;
+    static const byte TOP_INTERRUPT = ICIE1;
+    /* flag and interrupt enable bit set at BOTTOM in dual slope modes, at TOP in fast pwm mode */
+    static const byte OVERFLOW_FLAG = TOV1;
+    static const byte OVERFLOW_INTERRUPT = TOIE1;
+    /* compare output mode bits for non-inverting pwm */
+    static const byte COM_A1 = COM1A1;
+    static const byte COM_B1 = COM1B1;
+
+    /* clock select values 1 to 5: no prescaler, 8, 64, 256, 1024 */
+    static const byte NUMBER_OF_PRESCALERS = 5u;
+    template <byte ClockSelect> struct PrescaleShift {
+        static const byte Value = (1u == ClockSelect) ? 0u : (2u == ClockSelect) ? 3u : (3u == ClockSelect) ? 6u :
+                                  (4u == ClockSelect) ? 8u : 10u;
+    };
+    static byte getPrescaleShift(byte ClockSelect) {
+        switch(ClockSelect) {
+            case 1u: return PrescaleShift<1u>::Value;
+            case 2u: return PrescaleShift<2u>::Value;
+            case 3u: return PrescaleShift<3u>::Value;
+            case 4u: return PrescaleShift<4u>::Value;
+            default: return PrescaleShift<5u>::Value;
+        }
+    }
+
+    static HwTimerRegister(TCCR1A)& tccra() { return TCCR1A; }
+    static HwTimerRegister(TCCR1B)& tccrb() { return TCCR1B; }
+    static HwTimerRegister(TIMSK1)& timsk() { return TIMSK1; }
+    static HwTimerRegister(TIFR1)& tifr() { return TIFR1; }
+    static HwTimerRegister(TCNT1)& tcnt() { return TCNT1; }
+    static HwTimerRegister(ICR1)& top() { return ICR1; }
+    static HwTimerRegister(OCR1A)& ocra() { return OCR1A; }
+    static HwTimerRegister(OCR1B)& ocrb() { return OCR1B; }
+};
+
+
+/******************************************************************************************************************************************************
+ *  CLASS  HwTimer2Traits
+ *****************************************************************************************************************************************************/
+/* Timer2: 8 bit, TOP is OCR2A, so only OC2B is available for pwm */
+struct HwTimer2Traits
+{
+    typedef uint8_t CounterType;
+
+    static const byte NUMBER_OF_BITS = 8u;
+    static const bool ATOMIC_ACCESS = false;
+    static const bool CHANNEL_A_AVAILABLE = false;
+    static const byte CHANNEL_A_ARDUINO_PIN = 11u;
+    static const byte CHANNEL_B_ARDUINO_PIN = 3u;
+
+    /* waveform generation modes with TOP in OCR2A */
+    static const byte WGM_CTC = 2u;
+    static const byte WGM_FAST_PWM = 7u;
+    static const byte WGM_PHASE_CORRECT = 5u;
+    static const byte WGM_PHASE_FREQUENCY_CORRECT = HWTIMER_WGM_NOT_AVAILABLE;
+
+    /* flag and interrupt enable bit set when counter reaches TOP in CTC mode */
+    static const byte TOP_FLAG = OCF2A;
+    static const byte TOP_INTERRUPT = OCIE2A;
+    /* flag and interrupt enable bit set at BOTTOM in dual slope modes, at TOP in fast pwm mode */
+    static const byte OVERFLOW_FLAG = TOV2;
+    static const byte OVERFLOW_INTERRUPT = TOIE2;
+    /* compare output mode bits for non-inverting pwm */
+    static const byte COM_A1 = COM2A1;
+    static const byte COM_B1 = COM2B1;
+
+    /* clock select values 1 to 7: no prescaler, 8, 32, 64, 128, 256, 1024 */
+    static const byte NUMBER_OF_PRESCALERS = 7u;
+    template <byte ClockSelect> struct PrescaleShift {
+        static const byte Value = (1u == ClockSelect) ? 0u : (2u == ClockSelect) ? 3u : (3u == ClockSelect) ? 5u :
+                                  (4u == ClockSelect) ? 6u : (5u == ClockSelect) ? 7u : (6u == ClockSelect) ? 8u : 10u;
+    };
+    static byte getPrescaleShift(byte ClockSelect) {
+        switch(ClockSelect) {
+            case 1u: return PrescaleShift<1u>::Value;
+            case 2u: return PrescaleShift<2u>::Value;
+            case 3u: return PrescaleShift<3u>::Value;
+            case 4u: return PrescaleShift<4u>::Value;
+            case 5u: return PrescaleShift<5u>::Value;
+            case 6u: return PrescaleShift<6u>::Value;
+            default: return PrescaleShift<7u>::Value;
+        }
+    }
+
+    static HwTimerRegister(TCCR2A)& tccra() { return TCCR2A; }
+    static HwTimerRegister(TCCR2B)& tccrb() { return TCCR2B; }
+    static HwTimerRegister(TIMSK2)& timsk() { return TIMSK2; }
+    static HwTimerRegister(TIFR2)& tifr() { return TIFR2; }
+    static HwTimerRegister(TCNT2)& tcnt() { return TCNT2; }
+    static HwTimerRegister(OCR2A)& top() { return OCR2A; }
+    static HwTimerRegister(OCR2A)& ocra() { return OCR2A; }
+    static HwTimerRegister(OCR2B)& ocrb() { return OCR2B; }
+};
+
+#endif
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
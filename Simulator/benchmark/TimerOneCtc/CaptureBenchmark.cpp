@@ -0,0 +1,141 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       CaptureBenchmark.cpp
+ *      \brief      Replay of synthetic edge traces on ICP1 and cost of the TimerOne capture interrupt per edge
+ *
+ *      \details    Timer1 runs without prescaler in tickless mode, both edges are captured. Every trace reports the
+ *                  interrupt cycles per edge, lost edges and the largest deviation of a timestamp from the cycle of its
+ *                  edge. The simulator counts cycles of register accesses, interrupt entry and exit.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerOne.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define BENCHMARK_PIN_ICP1                          8u
+#define BENCHMARK_MAX_EDGES                         2048u
+/* captures are read before a gap of at least this number of cycles */
+#define BENCHMARK_DRAIN_GAP                         1000u
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA
+ *****************************************************************************************************************************************************/
+static uint32_t Intervals[BENCHMARK_MAX_EDGES];
+static uint64_t EdgeCycles[BENCHMARK_MAX_EDGES];
+static uint64_t StartCycle;
+static unsigned int NumberOfEdges;
+static unsigned int NumberOfCaptures;
+static unsigned long MaxDeviation;
+static uint8_t Level;
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+static void drain()
+{
+    TimerOneCaptureType Captures[TIMERONE_CAPTURE_BUFFER_SIZE];
+    byte Count = Timer1.readCapture(Captures, TIMERONE_CAPTURE_BUFFER_SIZE);
+
+    for(byte Index = 0u; Index < Count; Index++) {
+        /* edges of lost captures are skipped by their timestamp */
+        while((NumberOfCaptures < NumberOfEdges) && (EdgeCycles[NumberOfCaptures] - StartCycle + 16u < Captures[Index].Ticks)) NumberOfCaptures++;
+        if(NumberOfCaptures < NumberOfEdges) {
+            long Deviation = (long) (Captures[Index].Ticks - (EdgeCycles[NumberOfCaptures] - StartCycle));
+            if((unsigned long) labs(Deviation) > MaxDeviation) MaxDeviation = labs(Deviation);
+            NumberOfCaptures++;
+        }
+    }
+}
+
+static void replay(const char* Name, unsigned int Length)
+{
+    const AvrSim::StatisticType& Capture = AvrSim::getStatistic(AvrSim::VECTOR_TIMER1_CAPT);
+
+    NumberOfEdges = 0u;
+    NumberOfCaptures = 0u;
+    MaxDeviation = 0u;
+    Timer1.stopCapture();
+    Timer1.stop();
+    Timer1.start();
+    /* TCNT1 was cleared by the register write just before the clock select */
+    StartCycle = AvrSim::getCycles() - 2u;
+    Timer1.startCapture(TIMERONE_CAPTURE_EDGE_BOTH);
+    AvrSim::clearStatistics();
+    for(unsigned int Edge = 0u; Edge < Length; Edge++) {
+        if(Intervals[Edge] >= BENCHMARK_DRAIN_GAP) drain();
+        AvrSim::run(Intervals[Edge] - (uint32_t) (AvrSim::getCycles() - (Edge ? EdgeCycles[Edge - 1u] : AvrSim::getCycles())));
+        Level = (HIGH == Level) ? LOW : HIGH;
+        AvrSim::writePin(BENCHMARK_PIN_ICP1, Level);
+        EdgeCycles[Edge] = AvrSim::getCycles() + 1u;
+        NumberOfEdges++;
+    }
+    AvrSim::run(BENCHMARK_DRAIN_GAP);
+    drain();
+    printf("%-16s edges %5u  captured %5lu  overruns %4u  isr %3lu/%3lu cycles (avg/max)  max deviation %lu ticks\n", Name, NumberOfEdges,
+           (unsigned long) Capture.Count, Timer1.getCaptureOverruns(), (unsigned long) (Capture.Count ? Capture.SumCycles / Capture.Count : 0u),
+           (unsigned long) Capture.MaxCycles, MaxDeviation);
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    Timer1.init(1000);
+    Timer1.setMode(TIMERONE_MODE_TICKLESS);
+    Timer1.start();
+    srand(1u);
+
+    /* 1 kHz square wave with 1 % jitter */
+    for(unsigned int Edge = 0u; Edge < 1000u; Edge++) Intervals[Edge] = 8000u - 40u + (rand() % 80u);
+    replay("square 1 kHz", 1000u);
+
+    /* servo pulses of 1..2 ms every 20 ms, crosses many counter overflows */
+    for(unsigned int Edge = 0u; Edge < 200u; Edge += 2u) {
+        Intervals[Edge] = 16000u + (rand() % 16000u);
+        Intervals[Edge + 1u] = 320000u - Intervals[Edge];
+    }
+    replay("servo 50 Hz", 200u);
+
+    /* random edges 200..2000 cycles apart */
+    for(unsigned int Edge = 0u; Edge < BENCHMARK_MAX_EDGES; Edge++) Intervals[Edge] = 200u + (rand() % 1800u);
+    replay("random", BENCHMARK_MAX_EDGES);
+
+    /* bursts of 24 edges 100 cycles apart, more than the capture buffer holds */
+    for(unsigned int Edge = 0u; Edge < 480u; Edge++) Intervals[Edge] = (0u == Edge % 24u) ? 50000u : 100u;
+    replay("burst", 480u);
+
+    /* shortest distance of two edges which is still captured */
+    for(unsigned int Edge = 0u; Edge < 240u; Edge++) Intervals[Edge] = (0u == Edge % 12u) ? 50000u : 40u;
+    replay("burst 40 cycles", 240u);
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
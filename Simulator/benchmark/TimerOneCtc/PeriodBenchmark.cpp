@@ -0,0 +1,100 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       PeriodBenchmark.cpp
+ *      \brief      Cycles of setPeriod(unsigned long) versus setPeriod<Microseconds>() of TimerOne, one period per prescaler
+ *
+ *      \details    The simulator counts cycles of register accesses and atomic blocks, both paths write the same registers.
+ *                  The arithmetic of the prescaler ladder, which setPeriod<Microseconds>() does at compile time, is not
+ *                  counted by the simulator. It is estimated from the 32 bit operations of the ladder: 4 cycles per
+ *                  shift by one bit, 6 cycles per compare with branch, the multiplication by 16 is 4 shifts.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerOne.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define BENCHMARK_CALLS                             10000uL
+#define BENCHMARK_SHIFT_CYCLES                      4u
+#define BENCHMARK_COMPARE_CYCLES                    6u
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+/* cycles of the arithmetic of setPeriod(unsigned long), same ladder */
+static unsigned int estimateArithmetic(unsigned long Microseconds)
+{
+    const byte Shifts[] = { 3u, 3u, 2u, 2u };
+    unsigned long TimerCycles = (F_CPU / 1000000) * Microseconds;
+    /* bound check and multiplication */
+    unsigned int Cycles = BENCHMARK_COMPARE_CYCLES + 4u * BENCHMARK_SHIFT_CYCLES;
+
+    for(byte Step = 0u; Step <= sizeof(Shifts); Step++) {
+        Cycles += BENCHMARK_COMPARE_CYCLES;
+        if(TimerCycles < TIMERONE_RESOLUTION) break;
+        if(Step < sizeof(Shifts)) {
+            TimerCycles >>= Shifts[Step];
+            Cycles += Shifts[Step] * BENCHMARK_SHIFT_CYCLES;
+        }
+    }
+    return Cycles;
+}
+
+template <unsigned long Microseconds>
+static void benchmarkPeriod()
+{
+    uint64_t Runtime;
+    uint64_t Compiled;
+
+    Runtime = AvrSim::getCycles();
+    for(unsigned long Call = 0u; Call < BENCHMARK_CALLS; Call++) Timer1.setPeriod(Microseconds);
+    Runtime = AvrSim::getCycles() - Runtime;
+    Compiled = AvrSim::getCycles();
+    for(unsigned long Call = 0u; Call < BENCHMARK_CALLS; Call++) Timer1.setPeriod<Microseconds>();
+    Compiled = AvrSim::getCycles() - Compiled;
+    printf("period %7lu us: setPeriod() %5.2f cycles + %3u cycles arithmetic, setPeriod<Microseconds>() %5.2f cycles\n", Microseconds,
+           (double) Runtime / BENCHMARK_CALLS, estimateArithmetic(Microseconds), (double) Compiled / BENCHMARK_CALLS);
+    AVRSIM_CHECK(Compiled <= Runtime);
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    Timer1.init(1000);
+    Timer1.start();
+
+    benchmarkPeriod<1000uL>();
+    benchmarkPeriod<20000uL>();
+    benchmarkPeriod<100000uL>();
+    benchmarkPeriod<500000uL>();
+    benchmarkPeriod<4000000uL>();
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
@@ -0,0 +1,89 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       ServoBenchmark.cpp
+ *      \brief      Timer1 compare B interrupts and cycles of the servos per channel count
+ *
+ *      \details    Each channel count is measured with pulse widths 100 us apart, each pulse end has its own
+ *                  interrupt, and with pulse widths 1 us apart, all pulse ends chain in one interrupt, which is the
+ *                  worst case of one interrupt. The simulator counts cycles of register accesses, interrupt entry and
+ *                  exit, the arithmetic of the interrupt is not counted.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerOne.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define BENCHMARK_FRAME_MICROSECONDS                20000uL
+#define BENCHMARK_FRAME_CYCLES                      (BENCHMARK_FRAME_MICROSECONDS * (F_CPU / 1000000uL))
+#define BENCHMARK_FRAMES                            10u
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+static void measure(byte NumberOfServos, unsigned int Distance)
+{
+    const AvrSim::StatisticType& Edge = AvrSim::getStatistic(AvrSim::VECTOR_TIMER1_COMPB);
+
+    Timer1.stopServos();
+    /* servos 0..7 on PORTD, 8..11 on PORTB */
+    while(Timer1.getNumberOfServos() < NumberOfServos) {
+        byte Servo = Timer1.getNumberOfServos();
+        if(E_OK != Timer1.attachServo(Servo < 8u ? TIMERONE_SERVO_PORT_D : TIMERONE_SERVO_PORT_B, Servo % 8u)) AVRSIM_CHECK(false);
+    }
+    for(byte Servo = 0u; Servo < NumberOfServos; Servo++) {
+        if(E_OK != Timer1.setServoPulse(Servo, 1000u + Distance * Servo)) AVRSIM_CHECK(false);
+    }
+    if(E_OK != Timer1.updateServos()) AVRSIM_CHECK(false);
+    if(E_OK != Timer1.startServos()) AVRSIM_CHECK(false);
+    AVRSIM_CHECK(NumberOfServos == Timer1.getNumberOfServoEdges());
+    /* first frame starts at the next BOTTOM */
+    AvrSim::run(BENCHMARK_FRAME_CYCLES);
+    AvrSim::clearStatistics();
+    AvrSim::run(BENCHMARK_FRAMES * BENCHMARK_FRAME_CYCLES);
+    printf("%2u servos %3u us apart  interrupts %5.1f  cycles %6.1f per frame  isr %3lu cycles max\n", NumberOfServos, Distance,
+           (double) Edge.Count / BENCHMARK_FRAMES, (double) Edge.SumCycles / BENCHMARK_FRAMES, (unsigned long) Edge.MaxCycles);
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    const byte NumberOfServos[] = { 1u, 2u, 4u, 8u, TIMERONE_SERVO_MAX_CHANNELS };
+
+    Timer1.init(BENCHMARK_FRAME_MICROSECONDS);
+    Timer1.start();
+
+    for(byte Index = 0u; Index < sizeof(NumberOfServos); Index++) {
+        measure(NumberOfServos[Index], 100u);
+        measure(NumberOfServos[Index], 1u);
+    }
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
@@ -0,0 +1,91 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       StepperBenchmark.cpp
+ *      \brief      Cycles of the Stepper interrupt per step and the step rate which is reached at cruise speed
+ *
+ *      \details    Moves with ramps of STEPPER_MAX_ACCELERATION are run up to STEPPER_MAX_SPEED, the cruise rate is
+ *                  taken from the middle half of the steps. The simulator counts cycles of register accesses,
+ *                  interrupt entry and exit, the 32 bit arithmetic of the ramps is not counted, so the reached rate
+ *                  is an upper bound for the device.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <Stepper.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+/* ramps of STEPPER_MAX_SPEED take 1000 steps each */
+#define BENCHMARK_STEPS                             8000u
+/* cycles between two reads of the step count */
+#define BENCHMARK_POLL_CYCLES                       64u
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA
+ *****************************************************************************************************************************************************/
+static uint64_t StepCycles[BENCHMARK_STEPS];
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+static void measure(uint16_t Speed)
+{
+    const AvrSim::StatisticType& Step = AvrSim::getStatistic(AvrSim::VECTOR_TIMER1_COMPA);
+    uint32_t FirstStep = StepperMotor.getStepCount();
+    uint32_t Steps = 0u;
+    double Rate;
+
+    AvrSim::clearStatistics();
+    if(E_OK != StepperMotor.queueMove(BENCHMARK_STEPS, Speed)) AVRSIM_CHECK(false);
+    while(Stepper::STATE_RUNNING == StepperMotor.getState()) {
+        AvrSim::run(BENCHMARK_POLL_CYCLES);
+        while((Steps < BENCHMARK_STEPS) && (StepperMotor.getStepCount() - FirstStep > Steps)) StepCycles[Steps++] = AvrSim::getCycles();
+    }
+    AVRSIM_CHECK(BENCHMARK_STEPS == Steps);
+    Rate = (double) F_CPU * (BENCHMARK_STEPS / 2u) / (StepCycles[3u * BENCHMARK_STEPS / 4u] - StepCycles[BENCHMARK_STEPS / 4u]);
+    printf("speed %5u steps/s  reached %8.1f steps/s  isr %4.1f/%2lu cycles (avg/max)\n", Speed, Rate,
+           (double) Step.SumCycles / Step.Count, (unsigned long) Step.MaxCycles);
+    AVRSIM_CHECK(Rate >= 0.99 * Speed);
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    if(E_OK != StepperMotor.init(Stepper::PORT_D, 2u, Stepper::PORT_D, 3u)) AVRSIM_CHECK(false);
+    if(E_OK != StepperMotor.setAcceleration(STEPPER_MAX_ACCELERATION, STEPPER_MAX_ACCELERATION)) AVRSIM_CHECK(false);
+
+    measure(1000u);
+    measure(5000u);
+    measure(10000u);
+    measure(15000u);
+    measure(STEPPER_MAX_SPEED);
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
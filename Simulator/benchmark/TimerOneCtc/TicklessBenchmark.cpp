@@ -0,0 +1,114 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       TicklessBenchmark.cpp
+ *      \brief      Interrupts and wakeups of TimerOne in periodic and tickless mode
+ *
+ *      \details    Two jobs are due every 10 ms and every 250 ms. In periodic mode a 1 ms tick polls the jobs, in
+ *                  tickless mode the compare interrupt is set to the next deadline. Both runs last one second.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerOne.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define BENCHMARK_TICK_MICROSECONDS                 1000u
+#define BENCHMARK_FAST_JOB_TICKS                    10u
+#define BENCHMARK_SLOW_JOB_TICKS                    250u
+#define BENCHMARK_MILLISECONDS                      1000u
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA
+ *****************************************************************************************************************************************************/
+static unsigned long Tick;
+static unsigned long FastJobs;
+static unsigned long SlowJobs;
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+static void runJobs()
+{
+    if(0u == Tick % BENCHMARK_FAST_JOB_TICKS) FastJobs++;
+    if(0u == Tick % BENCHMARK_SLOW_JOB_TICKS) SlowJobs++;
+}
+
+static void periodicCallback()
+{
+    Tick++;
+    runJobs();
+}
+
+static void ticklessCallback()
+{
+    unsigned long Next;
+
+    Tick += BENCHMARK_FAST_JOB_TICKS;
+    runJobs();
+    /* the slow job is due at a multiple of the fast job */
+    Next = (Tick + BENCHMARK_FAST_JOB_TICKS) * Timer1.getPeriodTicks();
+    Timer1.setCompare(Next);
+}
+
+static void report(const char* Mode)
+{
+    printf("%-9s interrupts %5lu  wakeups %5lu  jobs %3lu + %lu  compare isr %llu cycles  overflow isr %llu cycles\n", Mode,
+           Timer1.getInterruptCounter(), Timer1.getWakeupCounter(), FastJobs, SlowJobs,
+           (unsigned long long) AvrSim::getStatistic(AvrSim::VECTOR_TIMER1_COMPA).SumCycles,
+           (unsigned long long) AvrSim::getStatistic(AvrSim::VECTOR_TIMER1_OVF).SumCycles);
+}
+
+static void measure(TimerOneModeType Mode, TimerIsrCallbackF_void Callback)
+{
+    Tick = 0u;
+    FastJobs = 0u;
+    SlowJobs = 0u;
+    Timer1.setMode(Mode);
+    Timer1.attachInterrupt(Callback);
+    Timer1.clearCounter();
+    AvrSim::clearStatistics();
+    Timer1.start();
+    if(TIMERONE_MODE_TICKLESS == Mode) Timer1.setCompare((unsigned long) BENCHMARK_FAST_JOB_TICKS * Timer1.getPeriodTicks());
+    delay(BENCHMARK_MILLISECONDS);
+    Timer1.stop();
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    Timer1.init(BENCHMARK_TICK_MICROSECONDS);
+    measure(TIMERONE_MODE_PERIODIC, periodicCallback);
+    report("periodic");
+    measure(TIMERONE_MODE_TICKLESS, ticklessCallback);
+    report("tickless");
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
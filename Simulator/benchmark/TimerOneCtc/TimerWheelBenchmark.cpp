@@ -0,0 +1,177 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       TimerWheelBenchmark.cpp
+ *      \brief      Cost of insert and tick of the TimerWheel versus the number of armed timers and the cascaded levels
+ *
+ *      \details    The simulator only counts cycles of register accesses and of interrupt entry and exit, which is the
+ *                  same for every tick. So the work of the wheel is measured in host nanoseconds: every tick is timed on
+ *                  its own and sorted by the highest level it cascades, a tick without cascade only takes the expired
+ *                  timers of its first level slot. The periodic timers have periods from 16 up to 2^16 ticks, so they are
+ *                  spread over all levels and cascaded down again after each expiry. The measured ticks wrap every
+ *                  level of the wheel. A tick costs the expired timers of its slot, a cascade also the timers it moves
+ *                  down. Only the average is printed, the longest tick is disturbed by the host.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerWheel.h>
+#include <stdio.h>
+#include <time.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define BENCHMARK_MAX_TIMERS                        4096u
+/* all levels of the wheel are cascaded within the measured ticks */
+#define BENCHMARK_TICKS                             0x10000uL
+/* samples of the overhead of a time measurement */
+#define BENCHMARK_OVERHEAD_SAMPLES                  1000u
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA TYPES AND STRUCTURES
+ *****************************************************************************************************************************************************/
+/* host time of the ticks which cascade up to one level */
+struct TickTimeType {
+    unsigned long Count;
+    double Sum;
+};
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA
+ *****************************************************************************************************************************************************/
+static TimerWheelTimer Timers[BENCHMARK_MAX_TIMERS];
+static unsigned long Periods[BENCHMARK_MAX_TIMERS];
+static unsigned long Expiries;
+static double Overhead;
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+static void expired()
+{
+    Expiries++;
+}
+
+static double getNanoseconds()
+{
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+    return Now.tv_sec * 1e9 + Now.tv_nsec;
+}
+
+/* shortest time between two measurements, it is subtracted from each tick */
+static void measureOverhead()
+{
+    double Start;
+    double Time;
+
+    Overhead = 1e9;
+    for(unsigned int Sample = 0u; Sample < BENCHMARK_OVERHEAD_SAMPLES; Sample++) {
+        Start = getNanoseconds();
+        Time = getNanoseconds() - Start;
+        if(Time < Overhead) Overhead = Time;
+    }
+}
+
+/* pseudo random periods, the same number of timers starts in each upper level of the wheel */
+static void initPeriods()
+{
+    unsigned long Random = 1u;
+    unsigned long Span;
+
+    for(unsigned int Index = 0u; Index < BENCHMARK_MAX_TIMERS; Index++) {
+        Random = (Random * 1103515245uL + 12345uL) & 0xFFFFFFFFuL;
+        Span = 1uL << ((1u + Index % (TIMERWHEEL_NUMBER_OF_LEVELS - 1u)) * TIMERWHEEL_LEVEL_BITS);
+        Periods[Index] = Span + (Random >> 8) % ((TIMERWHEEL_SLOTS_PER_LEVEL - 1u) * Span);
+    }
+}
+
+/* highest level of the wheel which is cascaded by the tick after Ticks */
+static byte getCascadeLevel(unsigned long Ticks)
+{
+    byte Level = 0u;
+
+    Ticks++;
+    while((Level < TIMERWHEEL_NUMBER_OF_LEVELS - 1u) && (0u == ((Ticks >> (Level * TIMERWHEEL_LEVEL_BITS)) & TIMERWHEEL_SLOT_MASK))) Level++;
+    return Level;
+}
+
+static void measure(unsigned int NumberOfTimers)
+{
+    TickTimeType TickTimes[TIMERWHEEL_NUMBER_OF_LEVELS] = { };
+    double Start;
+    double AtomicTime;
+    double InsertTime;
+    double Time;
+    byte Level;
+
+    /* host time of insert without the simulated SREG accesses of its atomic block */
+    Start = getNanoseconds();
+    for(unsigned int Index = 0u; Index < NumberOfTimers; Index++) { ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { } }
+    AtomicTime = getNanoseconds() - Start;
+    Start = getNanoseconds();
+    for(unsigned int Index = 0u; Index < NumberOfTimers; Index++) Wheel.startTimer(Timers[Index], Periods[Index], expired, Periods[Index]);
+    InsertTime = getNanoseconds() - Start - AtomicTime;
+
+    /* host time of each tick, the wheel is stopped so tick() is called directly */
+    Expiries = 0u;
+    for(unsigned long Tick = 0u; Tick < BENCHMARK_TICKS; Tick++) {
+        Level = getCascadeLevel(Wheel.getTicks());
+        Start = getNanoseconds();
+        Wheel.tick();
+        Time = getNanoseconds() - Start - Overhead;
+        TickTimes[Level].Count++;
+        TickTimes[Level].Sum += Time;
+    }
+
+    printf("%5u timers  insert %5.1f ns  expiries per tick %5.3f  tick ns by cascaded levels:", NumberOfTimers,
+           NumberOfTimers ? InsertTime / NumberOfTimers : 0.0, (double) Expiries / BENCHMARK_TICKS);
+    for(Level = 0u; Level < TIMERWHEEL_NUMBER_OF_LEVELS; Level++) {
+        printf("  %u: %6.1f", Level, TickTimes[Level].Sum / TickTimes[Level].Count);
+    }
+    printf("\n");
+    for(unsigned int Index = 0u; Index < NumberOfTimers; Index++) Wheel.stopTimer(Timers[Index]);
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    Wheel.init(1000u);
+    Timer1.stop();
+    measureOverhead();
+    initPeriods();
+    measure(0u);
+    measure(16u);
+    measure(256u);
+    measure(1024u);
+    measure(BENCHMARK_MAX_TIMERS);
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
@@ -0,0 +1,91 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       DutyBenchmark.cpp
+ *      \brief      Cycles per duty update of TimerOne, the former setPwmDuty() versus the cached TOP or the duty table
+ *
+ *      \details    The former setPwmDuty() read ICR1 and multiplied in an atomic block, it is rebuilt here as reference.
+ *                  The simulator counts cycles of register accesses and atomic blocks, the multiplication is not counted.
+ *                  DutyTableBenchmark is the same sketch built with TIMERONE_DUTY_TABLE.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerOne.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define BENCHMARK_UPDATES                           100000uL
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+/* setPwmDuty() before the TOP cache, without state checks */
+static void setPwmDutyFormer(unsigned int DutyCycle)
+{
+    unsigned long DutyCycleTrans;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        DutyCycleTrans = (unsigned long) ICR1 * DutyCycle;
+        DutyCycleTrans >>= TIMERONE_NUMBER_OF_BITS;
+        OCR1A = DutyCycleTrans;
+    }
+}
+
+static void report(const char* Name, uint64_t Cycles)
+{
+    printf("%-24s %6.2f cycles per update\n", Name, (double) Cycles / BENCHMARK_UPDATES);
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    uint64_t Cycles;
+    /* duty wraps like the 16 bit int of AVR */
+    volatile uint16_t Duty = 0u;
+
+    Timer1.init(1000);
+    Timer1.enablePwm(TIMERONE_PWM_PIN_9, 0u);
+    Timer1.start();
+
+    Cycles = AvrSim::getCycles();
+    for(unsigned long Update = 0u; Update < BENCHMARK_UPDATES; Update++) setPwmDutyFormer(Duty += 7u);
+    report("former", AvrSim::getCycles() - Cycles);
+
+    Cycles = AvrSim::getCycles();
+    for(unsigned long Update = 0u; Update < BENCHMARK_UPDATES; Update++) {
+        if(E_OK != Timer1.setPwmDuty(TIMERONE_PWM_PIN_9, Duty += 7u)) AVRSIM_CHECK(false);
+    }
+#if (TIMERONE_DUTY_TABLE == STD_ON)
+    report("setPwmDuty, duty table", AvrSim::getCycles() - Cycles);
+#else
+    report("setPwmDuty, cached TOP", AvrSim::getCycles() - Cycles);
+#endif
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
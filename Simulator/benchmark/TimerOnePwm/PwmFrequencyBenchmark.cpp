@@ -0,0 +1,102 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       PwmFrequencyBenchmark.cpp
+ *      \brief      Pwm frequency and resolution of TimerOne per period in phase and frequency correct mode 8
+ *
+ *      \details    The frequency is measured from the rising edges on pin 9 and compared with getPwmFrequency(), the
+ *                  resolution is the number of compare values given by getPwmResolution().
+ *                  FastPwmFrequencyBenchmark is the same sketch in fast pwm mode 14.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerOne.h>
+#include <math.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#ifndef BENCHMARK_MODE
+# define BENCHMARK_MODE                             TIMERONE_MODE_PHASE_FREQUENCY_CORRECT
+#endif
+/* periods which are measured after the period is set */
+#define BENCHMARK_PERIODS                           4u
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA
+ *****************************************************************************************************************************************************/
+static const uint16_t Prescalers[8] = { 0u, 1u, 8u, 64u, 256u, 1024u, 0u, 0u };
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+static void measure(unsigned long Microseconds)
+{
+    unsigned long Frequency = 0u;
+    uint64_t First = 0u;
+    uint64_t Last = 0u;
+    unsigned int Edges = 0u;
+    uint8_t LastLevel = AvrSim::readPin(TIMERONE_PWM_PIN_9);
+    uint8_t Level;
+    double Measured;
+
+    if(E_OK != Timer1.setPeriod(Microseconds)) AVRSIM_CHECK(false);
+    if(E_OK != Timer1.setPwmDuty(TIMERONE_PWM_PIN_9, TIMERONE_RESOLUTION / 2u)) AVRSIM_CHECK(false);
+    if(E_OK != Timer1.getPwmFrequency(&Frequency)) AVRSIM_CHECK(false);
+    /* one edge of the old period and the first edge of the new one are not measured */
+    while(Edges < BENCHMARK_PERIODS + 2u) {
+        AvrSim::run(1u);
+        Level = AvrSim::readPin(TIMERONE_PWM_PIN_9);
+        if((HIGH == Level) && (LOW == LastLevel)) {
+            if(1u == Edges) First = AvrSim::getCycles();
+            Last = AvrSim::getCycles();
+            Edges++;
+        }
+        LastLevel = Level;
+    }
+    Measured = (double) F_CPU * BENCHMARK_PERIODS / (Last - First);
+    printf("period %6lu us  prescaler %4u  top %5u  frequency %6lu Hz (measured %9.2f Hz)  resolution %5lu (%4.1f bits)\n", Microseconds,
+           Prescalers[TCCR1B.Value & TIMERONE_REG_CS_GM], ICR1.Value, Frequency, Measured, Timer1.getPwmResolution(),
+           log((double) Timer1.getPwmResolution()) / log(2.0));
+    /* getPwmFrequency() rounds down */
+    AVRSIM_CHECK(fabs(Measured - Frequency) <= 1.0);
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    const unsigned long Periods[] = { 10u, 50u, 100u, 1000u, 4000u, 20000u, 100000u };
+
+    if(E_OK != Timer1.init(1000, NULL, BENCHMARK_MODE)) AVRSIM_CHECK(false);
+    if(E_OK != Timer1.enablePwm(TIMERONE_PWM_PIN_9, TIMERONE_RESOLUTION / 2u)) AVRSIM_CHECK(false);
+    if(E_OK != Timer1.start()) AVRSIM_CHECK(false);
+    for(byte Index = 0u; Index < sizeof(Periods) / sizeof(Periods[0]); Index++) measure(Periods[Index]);
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
@@ -0,0 +1,146 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       HwTimerBenchmark.cpp
+ *      \brief      Cycles of TimerTwo on HwTimer2Ctc versus the former hand-written TimerTwo
+ *
+ *      \details    The former setPeriod() and read() are rebuilt here as reference. The simulator counts cycles of
+ *                  register accesses, interrupt entry and exit, arithmetic is not counted. The compare interrupt
+ *                  of both versions has no register access, so its cycles are those of entry and exit.
+ *                  Flash size is not reported, the host build has no avr-size.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerTwo.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define BENCHMARK_CALLS                             10000uL
+#define BENCHMARK_INTERRUPT_MICROSECONDS            100uL
+#define BENCHMARK_INTERRUPT_MILLISECONDS            100uL
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA
+ *****************************************************************************************************************************************************/
+static byte ClockSelectFormer;
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+static void callback()
+{
+
+}
+
+/* setPeriod() before the port, without post-scaler */
+static void setPeriodFormer(unsigned long Microseconds)
+{
+    unsigned long TimerCycles = (F_CPU / 1000000) * Microseconds;
+
+    if(TimerCycles < TIMERTWO_RESOLUTION)              ClockSelectFormer = TIMERTWO_REG_CS_NO_PRESCALER;
+    else if((TimerCycles >>= 3) < TIMERTWO_RESOLUTION) ClockSelectFormer = TIMERTWO_REG_CS_PRESCALE_8;
+    else if((TimerCycles >>= 2) < TIMERTWO_RESOLUTION) ClockSelectFormer = TIMERTWO_REG_CS_PRESCALE_32;
+    else if((TimerCycles >>= 1) < TIMERTWO_RESOLUTION) ClockSelectFormer = TIMERTWO_REG_CS_PRESCALE_64;
+    else if((TimerCycles >>= 1) < TIMERTWO_RESOLUTION) ClockSelectFormer = TIMERTWO_REG_CS_PRESCALE_128;
+    else if((TimerCycles >>= 1) < TIMERTWO_RESOLUTION) ClockSelectFormer = TIMERTWO_REG_CS_PRESCALE_256;
+    else {
+        TimerCycles >>= 2;
+        ClockSelectFormer = TIMERTWO_REG_CS_PRESCALE_1024;
+    }
+    OCR2A = TimerCycles;
+    writeBitGroup(TCCR2B, TIMERTWO_REG_CS_GM, TIMERTWO_REG_CS_GP, ClockSelectFormer);
+}
+
+/* read() before the port */
+static unsigned int readFormer()
+{
+    int CounterValue = TCNT2;
+    byte PrescaleShiftScale;
+
+    switch(ClockSelectFormer) {
+        case TIMERTWO_REG_CS_NO_PRESCALER: PrescaleShiftScale = 0u; break;
+        case TIMERTWO_REG_CS_PRESCALE_8: PrescaleShiftScale = 3u; break;
+        case TIMERTWO_REG_CS_PRESCALE_32: PrescaleShiftScale = 5u; break;
+        case TIMERTWO_REG_CS_PRESCALE_64: PrescaleShiftScale = 6u; break;
+        case TIMERTWO_REG_CS_PRESCALE_128: PrescaleShiftScale = 7u; break;
+        case TIMERTWO_REG_CS_PRESCALE_256: PrescaleShiftScale = 8u; break;
+        default: PrescaleShiftScale = 10u; break;
+    }
+    return ((CounterValue * 1000UL) / (F_CPU / 1000UL)) << PrescaleShiftScale;
+}
+
+static void report(const char* Name, uint64_t Cycles)
+{
+    printf("%-28s %6.2f cycles per call\n", Name, (double) Cycles / BENCHMARK_CALLS);
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    const AvrSim::StatisticType& Compare = AvrSim::getStatistic(AvrSim::VECTOR_TIMER2_COMPA);
+    uint64_t Cycles;
+    unsigned int Microseconds;
+    volatile unsigned long Sum = 0u;
+
+    Timer2.init(BENCHMARK_INTERRUPT_MICROSECONDS, callback);
+    Timer2.start();
+
+    Cycles = AvrSim::getCycles();
+    for(unsigned long Call = 0u; Call < BENCHMARK_CALLS; Call++) setPeriodFormer((Call & 1u) ? 1000u : 4000u);
+    report("former setPeriod()", AvrSim::getCycles() - Cycles);
+    Cycles = AvrSim::getCycles();
+    for(unsigned long Call = 0u; Call < BENCHMARK_CALLS; Call++) Timer2.setPeriod((Call & 1u) ? 1000u : 4000u);
+    report("setPeriod()", AvrSim::getCycles() - Cycles);
+    Cycles = AvrSim::getCycles();
+    for(unsigned long Call = 0u; Call < BENCHMARK_CALLS; Call++) {
+        if(Call & 1u) Timer2.setPeriod<1000u>();
+        else Timer2.setPeriod<4000u>();
+    }
+    report("setPeriod<Microseconds>()", AvrSim::getCycles() - Cycles);
+
+    Cycles = AvrSim::getCycles();
+    for(unsigned long Call = 0u; Call < BENCHMARK_CALLS; Call++) Sum += readFormer();
+    report("former read()", AvrSim::getCycles() - Cycles);
+    Cycles = AvrSim::getCycles();
+    for(unsigned long Call = 0u; Call < BENCHMARK_CALLS; Call++) {
+        if(E_OK != Timer2.read(&Microseconds)) AVRSIM_CHECK(false);
+        Sum += Microseconds;
+    }
+    report("read()", AvrSim::getCycles() - Cycles);
+
+    Timer2.setPeriod(BENCHMARK_INTERRUPT_MICROSECONDS);
+    AvrSim::clearStatistics();
+    delay(BENCHMARK_INTERRUPT_MILLISECONDS);
+    printf("%-28s %6lu interrupts  %2lu cycles max  %5.2f cycles avg\n", "compare interrupt", (unsigned long) Compare.Count,
+           (unsigned long) Compare.MaxCycles, (double) Compare.SumCycles / Compare.Count);
+    AVRSIM_CHECK(Compare.Count + 1u >= BENCHMARK_INTERRUPT_MILLISECONDS * 1000uL / BENCHMARK_INTERRUPT_MICROSECONDS);
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
@@ -0,0 +1,90 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       SoftPwmBenchmark.cpp
+ *      \brief      Timer2 compare B interrupts and cycles per frame of SoftPwm at 8, 16 and 24 channels
+ *
+ *      \details    24 channels are added on PORTD, PORTB and PORTC, channels which are not measured keep duty 0 and
+ *                  have no edge. Each channel count is measured with distinct duty cycles and once more with 24
+ *                  channels sharing 4 duty cycles. The simulator counts cycles of register accesses, interrupt entry
+ *                  and exit, the arithmetic of the interrupt is not counted.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerTwo.h>
+#include <SoftPwm.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define BENCHMARK_FRAME_MICROSECONDS                4000uL
+#define BENCHMARK_FRAME_CYCLES                      (BENCHMARK_FRAME_MICROSECONDS * (F_CPU / 1000000uL))
+#define BENCHMARK_FRAMES                            20u
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+static void measure(const char* Name, byte NumberOfChannels, byte NumberOfDuties)
+{
+    const AvrSim::StatisticType& Edge = AvrSim::getStatistic(AvrSim::VECTOR_TIMER2_COMPB);
+
+    for(byte Channel = 0u; Channel < SOFTPWM_MAX_CHANNELS; Channel++) {
+        /* duty cycles 10 apart are at least 9 timer ticks apart */
+        byte Duty = (Channel < NumberOfChannels) ? (byte) (10u * (Channel % NumberOfDuties + 1u)) : 0u;
+        if(E_OK != SoftwarePwm.setDuty(Channel, Duty)) AVRSIM_CHECK(false);
+    }
+    if(E_OK != SoftwarePwm.update()) AVRSIM_CHECK(false);
+    /* the new edges are active from the next frame on */
+    AvrSim::run(2u * BENCHMARK_FRAME_CYCLES);
+    AVRSIM_CHECK(NumberOfDuties == SoftwarePwm.getNumberOfEdges());
+    AvrSim::clearStatistics();
+    AvrSim::run(BENCHMARK_FRAMES * BENCHMARK_FRAME_CYCLES);
+    printf("%-24s edges %2u  interrupts %5.1f  cycles %6.1f per frame  isr %2lu cycles max\n", Name, SoftwarePwm.getNumberOfEdges(),
+           (double) Edge.Count / BENCHMARK_FRAMES, (double) Edge.SumCycles / BENCHMARK_FRAMES, (unsigned long) Edge.MaxCycles);
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    Timer2.init();
+    if(E_OK != SoftwarePwm.init(BENCHMARK_FRAME_MICROSECONDS)) AVRSIM_CHECK(false);
+    for(byte Bit = 0u; Bit < 8u; Bit++) {
+        SoftwarePwm.addChannel(SoftPwm::PORT_D, Bit);
+        SoftwarePwm.addChannel(SoftPwm::PORT_B, Bit);
+        SoftwarePwm.addChannel(SoftPwm::PORT_C, Bit);
+    }
+    AVRSIM_CHECK(SOFTPWM_MAX_CHANNELS == SoftwarePwm.getNumberOfChannels());
+    if(E_OK != SoftwarePwm.start()) AVRSIM_CHECK(false);
+
+    measure("8 channels", 8u, 8u);
+    measure("16 channels", 16u, 16u);
+    measure("24 channels", 24u, 24u);
+    measure("24 channels, 4 duties", 24u, 4u);
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
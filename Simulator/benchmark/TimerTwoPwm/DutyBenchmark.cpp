@@ -0,0 +1,90 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       DutyBenchmark.cpp
+ *      \brief      Cycles per duty update of TimerTwo, the former setPwmDuty() versus the 8 bit rule of three or the duty
+ *                  table
+ *
+ *      \details    The former setPwmDuty() multiplied with 32 bit and read TOP from OCR2A, it is rebuilt here as reference.
+ *                  The simulator counts cycles of register accesses and critical sections, the multiplication is not
+ *                  counted. setPwmDuty() takes TOP from its copy, only the write of OCR2B remains.
+ *                  DutyTableBenchmark is the same sketch built with TIMERTWO_DUTY_TABLE.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerTwo.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define BENCHMARK_UPDATES                           100000uL
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+/* setPwmDuty() before the change, without state checks */
+static void setPwmDutyFormer(byte DutyCycle)
+{
+    uint32_t DutyCycleTrans;
+
+    DutyCycleTrans = OCR2A * DutyCycle;
+    DutyCycleTrans >>= TIMERTWO_NUMBER_OF_BITS;
+    OCR2B = DutyCycleTrans;
+}
+
+static void report(const char* Name, uint64_t Cycles)
+{
+    printf("%-24s %6.2f cycles per update\n", Name, (double) Cycles / BENCHMARK_UPDATES);
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    uint64_t Cycles;
+    volatile byte Duty = 0u;
+
+    Timer2.init(1000u);
+    Timer2.enablePwm(TimerTwo::PWM_PIN_3, 0u);
+    Timer2.start();
+
+    Cycles = AvrSim::getCycles();
+    for(unsigned long Update = 0u; Update < BENCHMARK_UPDATES; Update++) setPwmDutyFormer(Duty += 7u);
+    report("former", AvrSim::getCycles() - Cycles);
+
+    Cycles = AvrSim::getCycles();
+    for(unsigned long Update = 0u; Update < BENCHMARK_UPDATES; Update++) {
+        if(E_OK != Timer2.setPwmDuty(TimerTwo::PWM_PIN_3, Duty += 7u)) AVRSIM_CHECK(false);
+    }
+#if (TIMERTWO_DUTY_TABLE == STD_ON)
+    report("setPwmDuty, duty table", AvrSim::getCycles() - Cycles);
+#else
+    report("setPwmDuty, cached TOP", AvrSim::getCycles() - Cycles);
+#endif
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
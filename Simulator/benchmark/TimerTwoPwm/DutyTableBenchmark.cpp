@@ -0,0 +1,17 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       DutyTableBenchmark.cpp
+ *      \brief      DutyBenchmark with the duty table of TimerTwo
+ *
+ *      \details    The Makefile builds this sketch with TIMERTWO_DUTY_TABLE.
+ *
+ *****************************************************************************************************************************************************/
+#include "DutyBenchmark.cpp"
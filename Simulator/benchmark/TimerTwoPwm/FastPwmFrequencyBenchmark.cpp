@@ -0,0 +1,18 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       FastPwmFrequencyBenchmark.cpp
+ *      \brief      PwmFrequencyBenchmark in fast pwm mode 7
+ *
+ *      \details
+ *
+ *****************************************************************************************************************************************************/
+#define BENCHMARK_MODE                              TimerTwo::MODE_FAST_PWM
+#include "PwmFrequencyBenchmark.cpp"
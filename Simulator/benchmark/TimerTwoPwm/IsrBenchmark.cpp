@@ -0,0 +1,93 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       IsrBenchmark.cpp
+ *      \brief      Cycles of the overflow interrupt of TimerTwo, callback by function pointer or handler bound at compile time
+ *
+ *      \details    StaticIsrBenchmark is the same sketch built with TIMERTWO_STATIC_ISR, the handler is then called
+ *                  directly by the vector defined with TIMERTWO_ISR(). The simulator counts the entry, the exit and the
+ *                  register accesses of the interrupt. The indirect call is not counted: it loads the pointer and
+ *                  forces the prologue and epilogue to save the 12 call-clobbered registers r18..r27, r30 and r31.
+ *                  Its cost is estimated from the instructions: 4 cycles LDS, 3 cycles ICALL, 4 cycles RET, 2 cycles
+ *                  per PUSH and per POP.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerTwo.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define BENCHMARK_PERIOD_MICROSECONDS               1000uL
+#define BENCHMARK_MILLISECONDS                      100uL
+#if (TIMERTWO_STATIC_ISR == STD_ON)
+# define BENCHMARK_BINDING                          "static handler"
+# define BENCHMARK_CALL_CYCLES                      0u
+#else
+# define BENCHMARK_BINDING                          "function pointer"
+# define BENCHMARK_CALL_CYCLES                      (4u + 3u + 4u + 12u * 2u * 2u)
+#endif
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA
+ *****************************************************************************************************************************************************/
+static volatile unsigned long Overflows = 0u;
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+static void overflow()
+{
+    Overflows++;
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    const AvrSim::StatisticType& Overflow = AvrSim::getStatistic(AvrSim::VECTOR_TIMER2_OVF);
+
+    Timer2.init(BENCHMARK_PERIOD_MICROSECONDS, overflow);
+    Timer2.start();
+    AvrSim::clearStatistics();
+    delay(BENCHMARK_MILLISECONDS);
+    printf("%-17s %4lu interrupts  %2lu cycles max  %5.2f cycles avg  + %2u cycles of the call estimated\n", BENCHMARK_BINDING,
+           (unsigned long) Overflow.Count, (unsigned long) Overflow.MaxCycles, (double) Overflow.SumCycles / Overflow.Count, BENCHMARK_CALL_CYCLES);
+    AVRSIM_CHECK(Overflows >= Overflow.Count);
+    AVRSIM_CHECK(Overflow.Count + 1u >= BENCHMARK_MILLISECONDS * 1000uL / BENCHMARK_PERIOD_MICROSECONDS);
+}
+
+void loop()
+{
+
+}
+
+
+#if (TIMERTWO_STATIC_ISR == STD_ON)
+/******************************************************************************************************************************************************
+ * I S R   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+TIMERTWO_ISR(overflow)
+#endif
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
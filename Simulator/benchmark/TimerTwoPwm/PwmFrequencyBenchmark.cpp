@@ -0,0 +1,103 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       PwmFrequencyBenchmark.cpp
+ *      \brief      Pwm frequency and resolution of TimerTwo per period in phase correct mode 5
+ *
+ *      \details    The frequency is measured from the rising edges on pin 3 and compared with getPwmFrequency(), the
+ *                  resolution is the number of compare values given by getPwmResolution().
+ *                  FastPwmFrequencyBenchmark is the same sketch in fast pwm mode 7.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerTwo.h>
+#include <math.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#ifndef BENCHMARK_MODE
+# define BENCHMARK_MODE                             TimerTwo::MODE_PHASE_CORRECT
+#endif
+/* periods which are measured after the period is set */
+#define BENCHMARK_DUTY                              128u
+#define BENCHMARK_PERIODS                           4u
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA
+ *****************************************************************************************************************************************************/
+static const uint16_t Prescalers[8] = { 0u, 1u, 8u, 32u, 64u, 128u, 256u, 1024u };
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+static void measure(unsigned long Microseconds)
+{
+    uint32_t Frequency = 0u;
+    uint64_t First = 0u;
+    uint64_t Last = 0u;
+    unsigned int Edges = 0u;
+    uint8_t LastLevel = AvrSim::readPin(TimerTwo::PWM_PIN_3);
+    uint8_t Level;
+    double Measured;
+
+    if(E_OK != Timer2.setPeriod(Microseconds)) AVRSIM_CHECK(false);
+    if(E_OK != Timer2.setPwmDuty(TimerTwo::PWM_PIN_3, BENCHMARK_DUTY)) AVRSIM_CHECK(false);
+    if(E_OK != Timer2.getPwmFrequency(Frequency)) AVRSIM_CHECK(false);
+    /* one edge of the old period and the first edge of the new one are not measured */
+    while(Edges < BENCHMARK_PERIODS + 2u) {
+        AvrSim::run(1u);
+        Level = AvrSim::readPin(TimerTwo::PWM_PIN_3);
+        if((HIGH == Level) && (LOW == LastLevel)) {
+            if(1u == Edges) First = AvrSim::getCycles();
+            Last = AvrSim::getCycles();
+            Edges++;
+        }
+        LastLevel = Level;
+    }
+    Measured = (double) F_CPU * BENCHMARK_PERIODS / (Last - First);
+    printf("period %6lu us  prescaler %4u  top %5u  frequency %6lu Hz (measured %9.2f Hz)  resolution %5u (%4.1f bits)\n", Microseconds,
+           Prescalers[TCCR2B.Value & TIMERTWO_REG_CS_GM], OCR2A.Value, (unsigned long) Frequency, Measured, Timer2.getPwmResolution(),
+           log((double) Timer2.getPwmResolution()) / log(2.0));
+    /* getPwmFrequency() rounds down */
+    AVRSIM_CHECK(fabs(Measured - Frequency) <= 1.0);
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    const unsigned long Periods[] = { 10u, 50u, 100u, 1000u, 4000u, 16000u };
+
+    if(E_OK != Timer2.init(1000u, nullptr, BENCHMARK_MODE)) AVRSIM_CHECK(false);
+    if(E_OK != Timer2.enablePwm(TimerTwo::PWM_PIN_3, BENCHMARK_DUTY)) AVRSIM_CHECK(false);
+    if(E_OK != Timer2.start()) AVRSIM_CHECK(false);
+    for(byte Index = 0u; Index < sizeof(Periods) / sizeof(Periods[0]); Index++) measure(Periods[Index]);
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
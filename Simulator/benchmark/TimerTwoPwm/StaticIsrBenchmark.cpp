@@ -0,0 +1,17 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       StaticIsrBenchmark.cpp
+ *      \brief      IsrBenchmark with the overflow interrupt of TimerTwo bound at compile time
+ *
+ *      \details    The Makefile builds this sketch with TIMERTWO_STATIC_ISR.
+ *
+ *****************************************************************************************************************************************************/
+#include "IsrBenchmark.cpp"
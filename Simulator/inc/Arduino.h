@@ -0,0 +1,89 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       Arduino.h
+ *      \brief      Host simulator replacement of the Arduino core header
+ *
+ *      \details    Types, constants and functions of the Arduino core used by the timer drivers and sketches. Time
+ *                  functions use the simulated clock.
+ *
+ *****************************************************************************************************************************************************/
+#ifndef _AVRSIM_ARDUINO_H_
+#define _AVRSIM_ARDUINO_H_
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define HIGH                                        0x1
+#define LOW                                         0x0
+
+#define INPUT                                       0x0
+#define OUTPUT                                      0x1
+#define INPUT_PULLUP                                0x2
+
+/* binary constants of binary.h used by the drivers */
+#define B0                                          0
+#define B1                                          1
+#define B10                                         2
+#define B11                                         3
+#define B100                                        4
+#define B101                                        5
+#define B110                                        6
+#define B111                                        7
+#define B11000                                      24
+
+/******************************************************************************************************************************************************
+ *  LOCAL FUNCTION MACROS
+ *****************************************************************************************************************************************************/
+#define interrupts()                                sei()
+#define noInterrupts()                              cli()
+
+#define clockCyclesPerMicrosecond()                 (F_CPU / 1000000L)
+#define bitRead(Value, Bit)                         (((Value) >> (Bit)) & 0x01)
+
+/******************************************************************************************************************************************************
+ *  GLOBAL DATA TYPES AND STRUCTURES
+ *****************************************************************************************************************************************************/
+typedef bool boolean;
+typedef uint8_t byte;
+typedef unsigned int word;
+
+
+/******************************************************************************************************************************************************
+ *  GLOBAL FUNCTIONS
+ *****************************************************************************************************************************************************/
+void pinMode(uint8_t, uint8_t);
+void digitalWrite(uint8_t, uint8_t);
+int digitalRead(uint8_t);
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long);
+void delayMicroseconds(unsigned int);
+void yield(void);
+
+void setup(void);
+void loop(void);
+
+#endif
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
@@ -0,0 +1,246 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       AvrSim.h
+ *      \brief      Main header file of the host simulator of the ATmega328P timers
+ *
+ *      \details    Replaces <avr/io.h>, <avr/interrupt.h>, <util/atomic.h> and "Arduino.h" on a Linux host, so the timer
+ *                  drivers and their Sketch.cpp run against a virtual clock. Timer1 and Timer2 are simulated with
+ *                  prescaler, waveform generation modes, TOP, counting direction, double buffered compare registers,
+ *                  flags, interrupts and input capture on pin 8. With AS2 set in ASSR Timer2 is clocked by a 32.768 kHz
+ *                  watch crystal and its update busy flags are set by writes and cleared at the next crystal clock.
+ *                  The clock advances by two cycles on every register access, by four cycles on interrupt entry and
+ *                  exit and by AvrSim::run(), delay() and sleep_cpu(). Interrupt latency and cycles spent in every
+ *                  interrupt are recorded.
+ *
+ *                  A sketch is built with all sources of the project and of Simulator/src:
+ *                  g++ -std=gnu++98 -DF_CPU=16000000L -ISimulator/inc -I<Project>/inc <sources> -o Sketch && ./Sketch 1000
+ *
+ *                  Simulator/Makefile builds the sketches of all projects and runs the tests and benchmarks in
+ *                  Simulator/test and Simulator/benchmark. A test fails if one of its AvrSim::check() fails.
+ *
+ *                  On AVR int is 16 bit and long is 32 bit, add -m32 if available to get at least the width of long.
+ *
+ *****************************************************************************************************************************************************/
+#ifndef _AVRSIM_H_
+#define _AVRSIM_H_
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#ifndef F_CPU
+# define F_CPU                                      16000000L
+#endif
+
+/* cycles of a register access (LDS/STS), of interrupt entry and of RETI */
+#define AVRSIM_ACCESS_CYCLES                        2u
+#define AVRSIM_INTERRUPT_ENTRY_CYCLES               4u
+#define AVRSIM_INTERRUPT_EXIT_CYCLES                4u
+
+#define AVRSIM_NUMBER_OF_PINS                       20u
+
+/* watch crystal of Timer2 in asynchronous mode */
+#define AVRSIM_ASYNC_FREQUENCY                      32768uL
+
+/******************************************************************************************************************************************************
+ *  LOCAL FUNCTION MACROS
+ *****************************************************************************************************************************************************/
+/* check a condition of a test sketch and print it if it fails */
+#define AVRSIM_CHECK(Condition)                     AvrSim::check((Condition), #Condition)
+
+
+/******************************************************************************************************************************************************
+ *  GLOBAL DATA TYPES AND STRUCTURES
+ *****************************************************************************************************************************************************/
+
+
+/******************************************************************************************************************************************************
+ *  CLASS  AvrSim
+ *****************************************************************************************************************************************************/
+class AvrSim
+{
+/******************************************************************************************************************************************************
+ *  P U B L I C   D A T A   T Y P E S   A N D   S T R U C T U R E S
+******************************************************************************************************************************************************/
+  public:
+    /* Type which includes the simulated interrupt vectors, ordered by priority */
+    enum VectorType {
+        VECTOR_TIMER2_COMPA,
+        VECTOR_TIMER2_COMPB,
+        VECTOR_TIMER2_OVF,
+        VECTOR_TIMER1_CAPT,
+        VECTOR_TIMER1_COMPA,
+        VECTOR_TIMER1_COMPB,
+        VECTOR_TIMER1_OVF,
+        NUMBER_OF_VECTORS
+    };
+
+    /* Type which describes the measurements of one interrupt vector */
+    struct StatisticType {
+        uint32_t Count;
+        /* cycles from raising the flag to the first instruction of the interrupt */
+        uint32_t MaxLatency;
+        /* cycles of the interrupt including entry and exit */
+        uint32_t MaxCycles;
+        uint64_t SumCycles;
+    };
+
+/******************************************************************************************************************************************************
+ *  P R I V A T E   D A T A   A N D   F U N C T I N O N S
+******************************************************************************************************************************************************/
+  private:
+    AvrSim();
+    ~AvrSim();
+    AvrSim(const AvrSim&);
+
+    static uint64_t Cycles;
+    static uint64_t RaiseCycle[NUMBER_OF_VECTORS];
+    static StatisticType Statistic[NUMBER_OF_VECTORS];
+    static uint32_t InterruptCount;
+    static uint8_t Pins[AVRSIM_NUMBER_OF_PINS];
+    /* square wave generator on one pin */
+    static uint8_t SignalPin;
+    static uint32_t SignalFrequency;
+    static uint32_t SignalPhase;
+    /* clock of Timer2 in asynchronous mode */
+    static uint32_t AsyncPhase;
+    static uint64_t AsyncCycles;
+    /* failed checks of a test sketch */
+    static uint32_t Failures;
+
+    static void step();
+
+/******************************************************************************************************************************************************
+ *  P U B L I C   F U N C T I O N S
+******************************************************************************************************************************************************/
+  public:
+    // get methods
+    static uint64_t getCycles() { return Cycles; }
+    static const StatisticType& getStatistic(VectorType Vector) { return Statistic[Vector]; }
+    static uint8_t readPin(uint8_t);
+    static bool isCompareBuffered(uint8_t);
+    static uint32_t getFailures() { return Failures; }
+
+    // set methods
+    static void run(uint32_t);
+    static void access(uint8_t);
+    static bool sleep(uint32_t);
+    static void writePin(uint8_t, uint8_t);
+    static void setSignal(uint8_t, uint32_t);
+    static void setBusy(uint8_t);
+    static void raiseFlag(VectorType);
+    static void dispatch();
+    static void clearStatistics();
+    static void printStatistics();
+    static bool check(bool, const char*);
+};
+
+
+/******************************************************************************************************************************************************
+ *  CLASS  AvrSimRegister
+ *****************************************************************************************************************************************************/
+/* simulated I/O register, every access costs cycles and lets the simulated timers run */
+template <typename T>
+class AvrSimRegister
+{
+  public:
+    /* Type which describes the write behaviour of the register */
+    enum KindType {
+        KIND_PLAIN,
+        /* interrupt flag register, writing a one clears the flag */
+        KIND_FLAGS,
+        /* output compare register, double buffered in pwm modes */
+        KIND_COMPARE,
+        /* status register, enabling interrupts dispatches pending interrupts */
+        KIND_STATUS,
+        /* port input register, writing a one toggles the bit of the port register */
+        KIND_PIN
+    };
+
+    /* value used by the hardware, the buffer is the CPU view of double buffered registers; both are accessed by the
+       simulator without cost. The value is not initialized by the constructor, because registers may be written during
+       static initialization of other translation units. */
+    T Value;
+    T Buffer;
+
+    AvrSimRegister(KindType sKind = KIND_PLAIN, uint8_t sTimer = 0u, AvrSimRegister* sPort = 0, uint8_t sBusy = 0u) :
+        Kind(sKind), Timer(sTimer), Port(sPort), Busy(sBusy) {}
+
+    /* a 16 bit register is accessed by two instructions, the high byte is buffered by the TEMP register which is
+       shared by all 16 bit registers, so an interrupt in between which accesses a 16 bit register corrupts it */
+    operator T() const {
+        T sValue = (KIND_COMPARE == Kind) ? Buffer : Value;
+        if(sizeof(T) > 1u) {
+            Temp = (uint8_t) (sValue >> 8);
+            AvrSim::access(AVRSIM_ACCESS_CYCLES);
+            sValue = (T) ((Temp << 8) | (sValue & 0xFFu));
+        }
+        AvrSim::access(AVRSIM_ACCESS_CYCLES);
+        return sValue;
+    }
+    AvrSimRegister& operator=(T sValue) {
+        if(sizeof(T) > 1u) {
+            Temp = (uint8_t) (sValue >> 8);
+            AvrSim::access(AVRSIM_ACCESS_CYCLES);
+            sValue = (T) ((Temp << 8) | (sValue & 0xFFu));
+        }
+        AvrSim::access(AVRSIM_ACCESS_CYCLES);
+        write(sValue);
+        if(0u != Busy) AvrSim::setBusy(Busy);
+        return *this;
+    }
+    AvrSimRegister& operator|=(T sValue) { return *this = (T) (*this | sValue); }
+    AvrSimRegister& operator&=(T sValue) { return *this = (T) (*this & sValue); }
+    AvrSimRegister& operator^=(T sValue) { return *this = (T) (*this ^ sValue); }
+
+  private:
+    static uint8_t Temp;
+    KindType Kind;
+    uint8_t Timer;
+    AvrSimRegister* Port;
+    /* update busy flag in ASSR of a register of the asynchronous timer */
+    uint8_t Busy;
+
+    AvrSimRegister(const AvrSimRegister&);
+    AvrSimRegister& operator=(const AvrSimRegister&);
+
+    void write(T sValue) {
+        if(KIND_FLAGS == Kind) {
+            Value &= (T) ~sValue;
+        } else if(KIND_COMPARE == Kind) {
+            Buffer = sValue;
+            if(!AvrSim::isCompareBuffered(Timer)) Value = sValue;
+        } else if(KIND_PIN == Kind) {
+            Port->Value ^= sValue;
+        } else {
+            Value = sValue;
+            if(KIND_STATUS == Kind) AvrSim::dispatch();
+        }
+    }
+};
+
+template <typename T>
+uint8_t AvrSimRegister<T>::Temp;
+
+typedef AvrSimRegister<uint8_t> AvrSimRegister8;
+typedef AvrSimRegister<uint16_t> AvrSimRegister16;
+
+#endif
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
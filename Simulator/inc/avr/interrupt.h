@@ -0,0 +1,54 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       interrupt.h
+ *      \brief      Host simulator replacement of <avr/interrupt.h>
+ *
+ *      \details    Interrupt vectors are C functions which are called by the simulator, vectors which are not defined
+ *                  by the application are weak and not called.
+ *
+ *****************************************************************************************************************************************************/
+#ifndef _AVRSIM_INTERRUPT_H_
+#define _AVRSIM_INTERRUPT_H_
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <avr/io.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define TIMER2_COMPA_vect                           __vector_7
+#define TIMER2_COMPB_vect                           __vector_8
+#define TIMER2_OVF_vect                             __vector_9
+#define TIMER1_CAPT_vect                            __vector_10
+#define TIMER1_COMPA_vect                           __vector_11
+#define TIMER1_COMPB_vect                           __vector_12
+#define TIMER1_OVF_vect                             __vector_13
+
+#define ISR_BLOCK
+#define ISR_NOBLOCK
+#define ISR_NAKED
+
+/******************************************************************************************************************************************************
+ *  LOCAL FUNCTION MACROS
+ *****************************************************************************************************************************************************/
+#define ISR(Vector, ...)                            extern "C" void Vector(void); extern "C" void Vector(void)
+
+#define sei()                                       (SREG = SREG | (1 << SREG_I))
+#define cli()                                       (SREG = SREG & ~(1 << SREG_I))
+
+#endif
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
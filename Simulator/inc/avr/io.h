@@ -0,0 +1,140 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       io.h
+ *      \brief      Host simulator replacement of <avr/io.h>
+ *
+ *      \details    ATmega328P registers and bit positions used by the timer drivers, the registers are simulated by
+ *                  AvrSimRegister objects
+ *
+ *****************************************************************************************************************************************************/
+#ifndef _AVRSIM_IO_H_
+#define _AVRSIM_IO_H_
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <AvrSim.h>
+
+
+/******************************************************************************************************************************************************
+ *  GLOBAL DATA
+ *****************************************************************************************************************************************************/
+/* status register */
+extern AvrSimRegister8 SREG;
+
+/* Timer0, not simulated */
+extern AvrSimRegister8 TCCR0A, TCCR0B, TCNT0, OCR0A, OCR0B, TIMSK0, TIFR0;
+
+/* Timer1 */
+extern AvrSimRegister8 TCCR1A, TCCR1B, TCCR1C, TIMSK1, TIFR1;
+extern AvrSimRegister16 TCNT1, OCR1A, OCR1B, ICR1;
+
+/* Timer2 */
+extern AvrSimRegister8 TCCR2A, TCCR2B, TCNT2, OCR2A, OCR2B, TIMSK2, TIFR2, ASSR;
+
+/* general timer control, sleep mode control and ports */
+extern AvrSimRegister8 GTCCR, SMCR;
+extern AvrSimRegister8 PORTB, PORTC, PORTD, DDRB, DDRC, DDRD, PINB, PINC, PIND;
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+/* SREG */
+#define SREG_I                                      7
+
+/* TCCR1A */
+#define WGM10                                       0
+#define WGM11                                       1
+#define COM1B0                                      4
+#define COM1B1                                      5
+#define COM1A0                                      6
+#define COM1A1                                      7
+/* TCCR1B */
+#define CS10                                        0
+#define CS11                                        1
+#define CS12                                        2
+#define WGM12                                       3
+#define WGM13                                       4
+#define ICES1                                       6
+#define ICNC1                                       7
+/* TCCR1C */
+#define FOC1B                                       6
+#define FOC1A                                       7
+/* TIMSK1 */
+#define TOIE1                                       0
+#define OCIE1A                                      1
+#define OCIE1B                                      2
+#define ICIE1                                       5
+/* TIFR1 */
+#define TOV1                                        0
+#define OCF1A                                       1
+#define OCF1B                                       2
+#define ICF1                                        5
+
+/* TCCR2A */
+#define WGM20                                       0
+#define WGM21                                       1
+#define COM2B0                                      4
+#define COM2B1                                      5
+#define COM2A0                                      6
+#define COM2A1                                      7
+/* TCCR2B */
+#define CS20                                        0
+#define CS21                                        1
+#define CS22                                        2
+#define WGM22                                       3
+#define FOC2B                                       6
+#define FOC2A                                       7
+/* TIMSK2 */
+#define TOIE2                                       0
+#define OCIE2A                                      1
+#define OCIE2B                                      2
+/* TIFR2 */
+#define TOV2                                        0
+#define OCF2A                                       1
+#define OCF2B                                       2
+/* ASSR */
+#define TCR2BUB                                     0
+#define TCR2AUB                                     1
+#define OCR2BUB                                     2
+#define OCR2AUB                                     3
+#define TCN2UB                                      4
+#define AS2                                         5
+#define EXCLK                                       6
+
+/* GTCCR */
+#define PSRSYNC                                     0
+#define PSRASY                                      1
+#define TSM                                         7
+
+/* SMCR */
+#define SE                                          0
+#define SM0                                         1
+#define SM1                                         2
+#define SM2                                         3
+
+/* ports */
+#define PORTB0                                      0
+#define PORTB1                                      1
+#define PORTB2                                      2
+#define PORTB3                                      3
+#define PORTD3                                      3
+#define PORTD5                                      5
+#define DDD5                                        5
+#define PINB0                                       0
+#define PIND5                                       5
+
+#endif
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
@@ -0,0 +1,42 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       pgmspace.h
+ *      \brief      Host simulator replacement of <avr/pgmspace.h>
+ *
+ *      \details    the host has one address space, so flash data is ordinary constant data
+ *
+ *****************************************************************************************************************************************************/
+#ifndef _AVRSIM_PGMSPACE_H_
+#define _AVRSIM_PGMSPACE_H_
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <stdint.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define PROGMEM
+
+/******************************************************************************************************************************************************
+ *  LOCAL FUNCTION MACROS
+ *****************************************************************************************************************************************************/
+#define pgm_read_byte(Address)                      (*(const uint8_t*) (Address))
+#define pgm_read_word(Address)                      (*(const uint16_t*) (Address))
+#define pgm_read_dword(Address)                     (*(const uint32_t*) (Address))
+
+#endif
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
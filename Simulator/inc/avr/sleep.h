@@ -0,0 +1,52 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       sleep.h
+ *      \brief      Host simulator replacement of <avr/sleep.h>
+ *
+ *      \details    sleep_cpu() advances the clock until an interrupt was executed, the sleep mode is not simulated
+ *
+ *****************************************************************************************************************************************************/
+#ifndef _AVRSIM_SLEEP_H_
+#define _AVRSIM_SLEEP_H_
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <avr/io.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define SLEEP_MODE_IDLE                             (0)
+#define SLEEP_MODE_ADC                              (1 << SM0)
+#define SLEEP_MODE_PWR_DOWN                         (1 << SM1)
+#define SLEEP_MODE_PWR_SAVE                         ((1 << SM0) | (1 << SM1))
+#define SLEEP_MODE_STANDBY                          ((1 << SM1) | (1 << SM2))
+#define SLEEP_MODE_EXT_STANDBY                      ((1 << SM0) | (1 << SM1) | (1 << SM2))
+
+/* longest sleep without interrupt, one second */
+#define AVRSIM_MAX_SLEEP_CYCLES                     ((uint32_t) F_CPU)
+
+/******************************************************************************************************************************************************
+ *  LOCAL FUNCTION MACROS
+ *****************************************************************************************************************************************************/
+#define set_sleep_mode(Mode)                        (SMCR = (SMCR & ~((1 << SM0) | (1 << SM1) | (1 << SM2))) | (Mode))
+#define sleep_enable()                              (SMCR = SMCR | (1 << SE))
+#define sleep_disable()                             (SMCR = SMCR & ~(1 << SE))
+#define sleep_cpu()                                 ((void) AvrSim::sleep(AVRSIM_MAX_SLEEP_CYCLES))
+#define sleep_mode()                                do { sleep_enable(); sleep_cpu(); sleep_disable(); } while(0)
+
+#endif
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
@@ -0,0 +1,50 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       atomic.h
+ *      \brief      Host simulator replacement of <util/atomic.h>
+ *
+ *      \details    Same construction as avr-libc, the status register is restored by a cleanup function when the block
+ *                  is left
+ *
+ *****************************************************************************************************************************************************/
+#ifndef _AVRSIM_ATOMIC_H_
+#define _AVRSIM_ATOMIC_H_
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <avr/interrupt.h>
+
+
+/******************************************************************************************************************************************************
+ *  GLOBAL FUNCTIONS
+ *****************************************************************************************************************************************************/
+static inline uint8_t AvrSim_disableInterrupts(void) { cli(); return 1u; }
+static inline void AvrSim_restoreState(const uint8_t* State) { SREG = *State; }
+static inline void AvrSim_enableInterrupts(const uint8_t*) { sei(); }
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define ATOMIC_RESTORESTATE                         uint8_t AvrSim_State __attribute__((__cleanup__(AvrSim_restoreState))) = SREG
+#define ATOMIC_FORCEON                              uint8_t AvrSim_State __attribute__((__cleanup__(AvrSim_enableInterrupts))) = 0u
+
+/******************************************************************************************************************************************************
+ *  LOCAL FUNCTION MACROS
+ *****************************************************************************************************************************************************/
+#define ATOMIC_BLOCK(Type)                          for(Type, AvrSim_ToDo = AvrSim_disableInterrupts(); AvrSim_ToDo; AvrSim_ToDo = 0u)
+
+#endif
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
@@ -0,0 +1,813 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       AvrSim.cpp
+ *      \brief      Main file of the host simulator of the ATmega328P timers
+ *
+ *      \details    Simulated registers, Timer1 and Timer2, interrupt dispatching and the Arduino core functions.
+ *
+ *
+ *****************************************************************************************************************************************************/
+#define _AVRSIM_SOURCE_
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include "Arduino.h"
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define AVRSIM_PIN_OC1A                             9u
+#define AVRSIM_PIN_OC1B                             10u
+#define AVRSIM_PIN_OC2A                             11u
+#define AVRSIM_PIN_OC2B                             3u
+#define AVRSIM_PIN_T1                               5u
+#define AVRSIM_PIN_ICP1                             8u
+#define AVRSIM_PIN_NONE                             0xFFu
+
+#define AVRSIM_REG_CS_GM                            B111
+/* clock select of the external clock on pin Tn */
+#define AVRSIM_REG_CS_EXTERNAL_FALLING              6u
+#define AVRSIM_REG_CS_EXTERNAL_RISING               7u
+#define AVRSIM_REG_COM_A_GP                         6u
+#define AVRSIM_REG_COM_B_GP                         4u
+#define AVRSIM_REG_COM_GM                           B11
+
+/******************************************************************************************************************************************************
+ *  LOCAL DATA TYPES AND STRUCTURES
+ *****************************************************************************************************************************************************/
+/* Type which describes how the counter counts */
+enum CountingType {
+    COUNTING_NORMAL,
+    COUNTING_CTC,
+    COUNTING_FAST_PWM,
+    COUNTING_PHASE_CORRECT,
+    COUNTING_RESERVED
+};
+
+/* Type which describes where TOP comes from */
+enum TopType {
+    TOP_MAX,
+    TOP_8BIT,
+    TOP_9BIT,
+    TOP_10BIT,
+    TOP_OCRA,
+    TOP_ICR
+};
+
+/* Type which describes when double buffered compare registers are updated */
+enum UpdateType {
+    UPDATE_IMMEDIATE,
+    UPDATE_TOP,
+    UPDATE_BOTTOM
+};
+
+/* Type which describes when the overflow flag is set */
+enum OverflowType {
+    OVERFLOW_MAX,
+    OVERFLOW_TOP,
+    OVERFLOW_BOTTOM
+};
+
+/* Type which describes one waveform generation mode */
+struct ModeType {
+    CountingType Counting;
+    TopType Top;
+    UpdateType Update;
+    OverflowType Overflow;
+};
+
+/* Type which describes one simulated timer */
+template <typename T>
+struct TimerType {
+    AvrSimRegister8* Tccra;
+    AvrSimRegister8* Tccrb;
+    AvrSimRegister<T>* Tcnt;
+    AvrSimRegister<T>* Ocra;
+    AvrSimRegister<T>* Ocrb;
+    AvrSimRegister16* Icr;
+    const ModeType* Modes;
+    uint8_t WaveformMask;
+    const uint16_t* Prescalers;
+    T Max;
+    AvrSim::VectorType VectorCompareA;
+    AvrSim::VectorType VectorCompareB;
+    AvrSim::VectorType VectorOverflow;
+    AvrSim::VectorType VectorCapture;
+    uint8_t PinA;
+    uint8_t PinB;
+    bool CountingDown;
+    uint8_t OutputA;
+    uint8_t OutputB;
+    /* external clock pin and its level of the last cycle */
+    uint8_t PinClock;
+    uint8_t ClockLevel;
+    /* input capture pin and its level of the last cycle */
+    uint8_t PinCapture;
+    uint8_t CaptureLevel;
+};
+
+/* Type which describes one interrupt vector */
+struct VectorDescriptionType {
+    const char* Name;
+    AvrSimRegister8* FlagRegister;
+    uint8_t Flag;
+    AvrSimRegister8* MaskRegister;
+    uint8_t Enable;
+    void (*Handler)(void);
+};
+
+
+/******************************************************************************************************************************************************
+ * GLOBAL DATA
+ *****************************************************************************************************************************************************/
+AvrSimRegister8 SREG(AvrSimRegister8::KIND_STATUS);
+
+AvrSimRegister8 TCCR0A, TCCR0B, TCNT0, OCR0A, OCR0B, TIMSK0;
+AvrSimRegister8 TIFR0(AvrSimRegister8::KIND_FLAGS);
+
+AvrSimRegister8 TCCR1A, TCCR1B, TCCR1C, TIMSK1;
+AvrSimRegister8 TIFR1(AvrSimRegister8::KIND_FLAGS);
+AvrSimRegister16 TCNT1, ICR1;
+AvrSimRegister16 OCR1A(AvrSimRegister16::KIND_COMPARE, 1u);
+AvrSimRegister16 OCR1B(AvrSimRegister16::KIND_COMPARE, 1u);
+
+AvrSimRegister8 TIMSK2, ASSR;
+AvrSimRegister8 TCCR2A(AvrSimRegister8::KIND_PLAIN, 0u, NULL, 1u << TCR2AUB);
+AvrSimRegister8 TCCR2B(AvrSimRegister8::KIND_PLAIN, 0u, NULL, 1u << TCR2BUB);
+AvrSimRegister8 TCNT2(AvrSimRegister8::KIND_PLAIN, 0u, NULL, 1u << TCN2UB);
+AvrSimRegister8 TIFR2(AvrSimRegister8::KIND_FLAGS);
+AvrSimRegister8 OCR2A(AvrSimRegister8::KIND_COMPARE, 2u, NULL, 1u << OCR2AUB);
+AvrSimRegister8 OCR2B(AvrSimRegister8::KIND_COMPARE, 2u, NULL, 1u << OCR2BUB);
+
+AvrSimRegister8 GTCCR, SMCR;
+AvrSimRegister8 PORTB, PORTC, PORTD, DDRB, DDRC, DDRD;
+AvrSimRegister8 PINB(AvrSimRegister8::KIND_PIN, 0u, &PORTB);
+AvrSimRegister8 PINC(AvrSimRegister8::KIND_PIN, 0u, &PORTC);
+AvrSimRegister8 PIND(AvrSimRegister8::KIND_PIN, 0u, &PORTD);
+
+uint64_t AvrSim::Cycles = 0u;
+uint64_t AvrSim::RaiseCycle[AvrSim::NUMBER_OF_VECTORS];
+AvrSim::StatisticType AvrSim::Statistic[AvrSim::NUMBER_OF_VECTORS];
+uint32_t AvrSim::InterruptCount = 0u;
+uint8_t AvrSim::Pins[AVRSIM_NUMBER_OF_PINS];
+uint8_t AvrSim::SignalPin = AVRSIM_PIN_NONE;
+uint32_t AvrSim::SignalFrequency = 0u;
+uint32_t AvrSim::SignalPhase = 0u;
+uint32_t AvrSim::AsyncPhase = 0u;
+uint64_t AvrSim::AsyncCycles = 0u;
+uint32_t AvrSim::Failures = 0u;
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA
+ *****************************************************************************************************************************************************/
+/* interrupt vectors of the application, vectors which are not defined are null */
+extern "C" void TIMER2_COMPA_vect(void) __attribute__((weak));
+extern "C" void TIMER2_COMPB_vect(void) __attribute__((weak));
+extern "C" void TIMER2_OVF_vect(void) __attribute__((weak));
+extern "C" void TIMER1_CAPT_vect(void) __attribute__((weak));
+extern "C" void TIMER1_COMPA_vect(void) __attribute__((weak));
+extern "C" void TIMER1_COMPB_vect(void) __attribute__((weak));
+extern "C" void TIMER1_OVF_vect(void) __attribute__((weak));
+
+static const VectorDescriptionType Vectors[AvrSim::NUMBER_OF_VECTORS] = {
+    { "TIMER2_COMPA", &TIFR2, OCF2A, &TIMSK2, OCIE2A, TIMER2_COMPA_vect },
+    { "TIMER2_COMPB", &TIFR2, OCF2B, &TIMSK2, OCIE2B, TIMER2_COMPB_vect },
+    { "TIMER2_OVF",   &TIFR2, TOV2,  &TIMSK2, TOIE2,  TIMER2_OVF_vect },
+    { "TIMER1_CAPT",  &TIFR1, ICF1,  &TIMSK1, ICIE1,  TIMER1_CAPT_vect },
+    { "TIMER1_COMPA", &TIFR1, OCF1A, &TIMSK1, OCIE1A, TIMER1_COMPA_vect },
+    { "TIMER1_COMPB", &TIFR1, OCF1B, &TIMSK1, OCIE1B, TIMER1_COMPB_vect },
+    { "TIMER1_OVF",   &TIFR1, TOV1,  &TIMSK1, TOIE1,  TIMER1_OVF_vect }
+};
+
+/* waveform generation modes of Timer1, WGM13:0 */
+static const ModeType Timer1Modes[16] = {
+    { COUNTING_NORMAL,        TOP_MAX,   UPDATE_IMMEDIATE, OVERFLOW_MAX },
+    { COUNTING_PHASE_CORRECT, TOP_8BIT,  UPDATE_TOP,       OVERFLOW_BOTTOM },
+    { COUNTING_PHASE_CORRECT, TOP_9BIT,  UPDATE_TOP,       OVERFLOW_BOTTOM },
+    { COUNTING_PHASE_CORRECT, TOP_10BIT, UPDATE_TOP,       OVERFLOW_BOTTOM },
+    { COUNTING_CTC,           TOP_OCRA,  UPDATE_IMMEDIATE, OVERFLOW_MAX },
+    { COUNTING_FAST_PWM,      TOP_8BIT,  UPDATE_BOTTOM,    OVERFLOW_TOP },
+    { COUNTING_FAST_PWM,      TOP_9BIT,  UPDATE_BOTTOM,    OVERFLOW_TOP },
+    { COUNTING_FAST_PWM,      TOP_10BIT, UPDATE_BOTTOM,    OVERFLOW_TOP },
+    { COUNTING_PHASE_CORRECT, TOP_ICR,   UPDATE_BOTTOM,    OVERFLOW_BOTTOM },
+    { COUNTING_PHASE_CORRECT, TOP_OCRA,  UPDATE_BOTTOM,    OVERFLOW_BOTTOM },
+    { COUNTING_PHASE_CORRECT, TOP_ICR,   UPDATE_TOP,       OVERFLOW_BOTTOM },
+    { COUNTING_PHASE_CORRECT, TOP_OCRA,  UPDATE_TOP,       OVERFLOW_BOTTOM },
+    { COUNTING_CTC,           TOP_ICR,   UPDATE_IMMEDIATE, OVERFLOW_MAX },
+    { COUNTING_RESERVED,      TOP_MAX,   UPDATE_IMMEDIATE, OVERFLOW_MAX },
+    { COUNTING_FAST_PWM,      TOP_ICR,   UPDATE_BOTTOM,    OVERFLOW_TOP },
+    { COUNTING_FAST_PWM,      TOP_OCRA,  UPDATE_BOTTOM,    OVERFLOW_TOP }
+};
+
+/* waveform generation modes of Timer2, WGM22:0 */
+static const ModeType Timer2Modes[8] = {
+    { COUNTING_NORMAL,        TOP_MAX,   UPDATE_IMMEDIATE, OVERFLOW_MAX },
+    { COUNTING_PHASE_CORRECT, TOP_8BIT,  UPDATE_TOP,       OVERFLOW_BOTTOM },
+    { COUNTING_CTC,           TOP_OCRA,  UPDATE_IMMEDIATE, OVERFLOW_MAX },
+    { COUNTING_FAST_PWM,      TOP_8BIT,  UPDATE_BOTTOM,    OVERFLOW_TOP },
+    { COUNTING_RESERVED,      TOP_MAX,   UPDATE_IMMEDIATE, OVERFLOW_MAX },
+    { COUNTING_PHASE_CORRECT, TOP_OCRA,  UPDATE_TOP,       OVERFLOW_BOTTOM },
+    { COUNTING_RESERVED,      TOP_MAX,   UPDATE_IMMEDIATE, OVERFLOW_MAX },
+    { COUNTING_FAST_PWM,      TOP_OCRA,  UPDATE_BOTTOM,    OVERFLOW_TOP }
+};
+
+/* prescaler of every clock select value, 0 is stopped; external clock of Timer1 is not simulated */
+static const uint16_t Timer1Prescalers[8] = { 0u, 1u, 8u, 64u, 256u, 1024u, 0u, 0u };
+static const uint16_t Timer2Prescalers[8] = { 0u, 1u, 8u, 32u, 64u, 128u, 256u, 1024u };
+
+static TimerType<uint16_t> Timer1Sim = {
+    &TCCR1A, &TCCR1B, &TCNT1, &OCR1A, &OCR1B, &ICR1, Timer1Modes, 0x0Fu, Timer1Prescalers, 0xFFFFu,
+    AvrSim::VECTOR_TIMER1_COMPA, AvrSim::VECTOR_TIMER1_COMPB, AvrSim::VECTOR_TIMER1_OVF, AvrSim::VECTOR_TIMER1_CAPT,
+    AVRSIM_PIN_OC1A, AVRSIM_PIN_OC1B, false, LOW, LOW, AVRSIM_PIN_T1, LOW, AVRSIM_PIN_ICP1, LOW
+};
+
+static TimerType<uint8_t> Timer2Sim = {
+    &TCCR2A, &TCCR2B, &TCNT2, &OCR2A, &OCR2B, NULL, Timer2Modes, 0x07u, Timer2Prescalers, 0xFFu,
+    AvrSim::VECTOR_TIMER2_COMPA, AvrSim::VECTOR_TIMER2_COMPB, AvrSim::VECTOR_TIMER2_OVF, AvrSim::NUMBER_OF_VECTORS,
+    AVRSIM_PIN_OC2A, AVRSIM_PIN_OC2B, false, LOW, LOW, AVRSIM_PIN_NONE, LOW, AVRSIM_PIN_NONE, LOW
+};
+
+
+/******************************************************************************************************************************************************
+ * LOCAL FUNCTIONS
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  getMode()
+******************************************************************************************************************************************************/
+/*! \brief          get waveform generation mode of timer
+ *  \details
+ *
+ *  \param[in]      Timer                       simulated timer
+ *  \return         waveform generation mode
+ *****************************************************************************************************************************************************/
+template <typename T>
+static const ModeType& getMode(const TimerType<T>& Timer)
+{
+    uint8_t Waveform = (Timer.Tccra->Value & B11) | ((Timer.Tccrb->Value >> WGM12) << 2u);
+
+    return Timer.Modes[Waveform & Timer.WaveformMask];
+} /* getMode */
+
+
+/******************************************************************************************************************************************************
+  getTop()
+******************************************************************************************************************************************************/
+/*! \brief          get TOP of timer
+ *  \details
+ *
+ *  \param[in]      Timer                       simulated timer
+ *  \param[in]      Mode                        waveform generation mode
+ *  \return         TOP
+ *****************************************************************************************************************************************************/
+template <typename T>
+static T getTop(const TimerType<T>& Timer, const ModeType& Mode)
+{
+    switch(Mode.Top) {
+        case TOP_8BIT: return 0xFFu;
+        case TOP_9BIT: return (T) 0x1FFu;
+        case TOP_10BIT: return (T) 0x3FFu;
+        case TOP_OCRA: return Timer.Ocra->Value;
+        case TOP_ICR: return (T) Timer.Icr->Value;
+        default: return Timer.Max;
+    }
+} /* getTop */
+
+
+/******************************************************************************************************************************************************
+  updateOutput()
+******************************************************************************************************************************************************/
+/*! \brief          change output compare pin on compare match
+ *  \details        only the non-inverting, inverting and toggle actions on compare match are simulated
+ *
+ *  \param[in]      Output                      level of output compare pin
+ *  \param[in]      CompareOutputMode           COMnx1:0 bits
+ *  \param[in]      Mode                        waveform generation mode
+ *  \param[in]      CountingDown                counter is counting down
+ *  \return         -
+ *****************************************************************************************************************************************************/
+static void updateOutput(uint8_t& Output, uint8_t CompareOutputMode, const ModeType& Mode, bool CountingDown)
+{
+    if(1u == CompareOutputMode) {
+        Output = (HIGH == Output) ? LOW : HIGH;
+    } else if(2u == CompareOutputMode) {
+        Output = (CountingDown && (COUNTING_PHASE_CORRECT == Mode.Counting)) ? HIGH : LOW;
+    } else if(3u == CompareOutputMode) {
+        Output = (CountingDown && (COUNTING_PHASE_CORRECT == Mode.Counting)) ? LOW : HIGH;
+    }
+} /* updateOutput */
+
+
+/******************************************************************************************************************************************************
+  stepTimer()
+******************************************************************************************************************************************************/
+/*! \brief          simulate one cycle of a timer
+ *  \details        the counter is clocked if the prescaler expires or on an edge of the external clock pin, flags are
+ *                  raised at MAX, TOP, BOTTOM, on compare match and on an edge of the input capture pin
+ *  \param[in]      Timer                       simulated timer
+ *  \param[in]      Cycles                      cycle counter
+ *  \return         -
+ *****************************************************************************************************************************************************/
+template <typename T>
+static void stepTimer(TimerType<T>& Timer, uint64_t Cycles)
+{
+    uint8_t ClockSelect = Timer.Tccrb->Value & AVRSIM_REG_CS_GM;
+    uint16_t Prescaler = Timer.Prescalers[ClockSelect];
+    const ModeType& Mode = getMode(Timer);
+    T Top;
+    T Count;
+    bool Bottom = false;
+    bool ReachedTop = false;
+    bool MatchDown;
+    uint8_t Level;
+    bool Edge;
+
+    if(COUNTING_RESERVED == Mode.Counting) return;
+    if(AVRSIM_PIN_NONE != Timer.PinCapture) {
+        /* input capture on the edge selected by ICES1 if ICR1 is not TOP, the noise canceler is not simulated */
+        Level = AvrSim::readPin(Timer.PinCapture);
+        Edge = (Level != Timer.CaptureLevel) && ((HIGH == Level) == (0u != (Timer.Tccrb->Value & (1u << ICES1))));
+        Timer.CaptureLevel = Level;
+        if(Edge && (TOP_ICR != Mode.Top)) {
+            Timer.Icr->Value = Timer.Tcnt->Value;
+            AvrSim::raiseFlag(Timer.VectorCapture);
+        }
+    }
+    if((AVRSIM_PIN_NONE != Timer.PinClock) && (ClockSelect >= AVRSIM_REG_CS_EXTERNAL_FALLING)) {
+        /* external clock, the synchronisation delay of the hardware is not simulated */
+        Level = AvrSim::readPin(Timer.PinClock);
+        Edge = (Level != Timer.ClockLevel) && ((HIGH == Level) == (AVRSIM_REG_CS_EXTERNAL_RISING == ClockSelect));
+        Timer.ClockLevel = Level;
+        if(!Edge) return;
+    } else {
+        if(AVRSIM_PIN_NONE != Timer.PinClock) Timer.ClockLevel = AvrSim::readPin(Timer.PinClock);
+        if((0u == Prescaler) || (0u != (Cycles % Prescaler))) return;
+    }
+    Top = getTop(Timer, Mode);
+    Count = Timer.Tcnt->Value;
+    if(COUNTING_FAST_PWM == Mode.Counting) {
+        /* fast pwm changes the output in the timer clock after the compare match, so the non-inverting output is high
+           for compare value + 1 ticks and a compare value of TOP keeps it high, the output set at BOTTOM follows */
+        if(Count == Timer.Ocra->Value) updateOutput(Timer.OutputA, (Timer.Tccra->Value >> AVRSIM_REG_COM_A_GP) & AVRSIM_REG_COM_GM, Mode, false);
+        if(Count == Timer.Ocrb->Value) updateOutput(Timer.OutputB, (Timer.Tccra->Value >> AVRSIM_REG_COM_B_GP) & AVRSIM_REG_COM_GM, Mode, false);
+    }
+    if(COUNTING_PHASE_CORRECT == Mode.Counting) {
+        if(!Timer.CountingDown) {
+            if(Count < Top) {
+                Count++;
+            } else {
+                Timer.CountingDown = true;
+                if(Count > 0u) Count--;
+            }
+        } else {
+            if(Count > 0u) {
+                Count--;
+            } else {
+                Timer.CountingDown = false;
+                Count++;
+            }
+        }
+        ReachedTop = (Count == Top);
+        Bottom = (0u == Count);
+        if(Bottom) AvrSim::raiseFlag(Timer.VectorOverflow);
+    } else {
+        Timer.CountingDown = false;
+        if((Count == Top) && (COUNTING_NORMAL != Mode.Counting)) {
+            /* CTC with TOP at MAX wraps like normal mode */
+            if((OVERFLOW_MAX == Mode.Overflow) && (Top == Timer.Max)) AvrSim::raiseFlag(Timer.VectorOverflow);
+            Count = 0u;
+        } else if(Count == Timer.Max) {
+            AvrSim::raiseFlag(Timer.VectorOverflow);
+            Count = 0u;
+        } else {
+            Count++;
+        }
+        ReachedTop = (Count == Top);
+        Bottom = (0u == Count);
+        /* fast pwm sets TOV in the timer clock cycle which reaches TOP, one timer clock before BOTTOM */
+        if(ReachedTop && (OVERFLOW_TOP == Mode.Overflow)) AvrSim::raiseFlag(Timer.VectorOverflow);
+        if(Bottom && (COUNTING_FAST_PWM == Mode.Counting)) {
+            /* non-inverting output is set at BOTTOM, inverting output is cleared */
+            if(2u == ((Timer.Tccra->Value >> AVRSIM_REG_COM_A_GP) & AVRSIM_REG_COM_GM)) Timer.OutputA = HIGH;
+            if(3u == ((Timer.Tccra->Value >> AVRSIM_REG_COM_A_GP) & AVRSIM_REG_COM_GM)) Timer.OutputA = LOW;
+            if(2u == ((Timer.Tccra->Value >> AVRSIM_REG_COM_B_GP) & AVRSIM_REG_COM_GM)) Timer.OutputB = HIGH;
+            if(3u == ((Timer.Tccra->Value >> AVRSIM_REG_COM_B_GP) & AVRSIM_REG_COM_GM)) Timer.OutputB = LOW;
+        }
+    }
+    Timer.Tcnt->Value = Count;
+    /* ICF1 is set at TOP if ICR1 is TOP */
+    if(ReachedTop && (TOP_ICR == Mode.Top)) AvrSim::raiseFlag(Timer.VectorCapture);
+    /* update double buffered compare registers */
+    if((ReachedTop && (UPDATE_TOP == Mode.Update)) || (Bottom && (UPDATE_BOTTOM == Mode.Update))) {
+        Timer.Ocra->Value = Timer.Ocra->Buffer;
+        Timer.Ocrb->Value = Timer.Ocrb->Buffer;
+    }
+    /* compare match, a match at TOP counts as down counting and at BOTTOM as up counting, so compare values equal to
+       TOP or BOTTOM keep the output at one level like the hardware does */
+    MatchDown = ReachedTop || (!Bottom && Timer.CountingDown);
+    if(Count == Timer.Ocra->Value) {
+        AvrSim::raiseFlag(Timer.VectorCompareA);
+        if(COUNTING_FAST_PWM != Mode.Counting) {
+            updateOutput(Timer.OutputA, (Timer.Tccra->Value >> AVRSIM_REG_COM_A_GP) & AVRSIM_REG_COM_GM, Mode, MatchDown);
+        }
+    }
+    if(Count == Timer.Ocrb->Value) {
+        AvrSim::raiseFlag(Timer.VectorCompareB);
+        if(COUNTING_FAST_PWM != Mode.Counting) {
+            updateOutput(Timer.OutputB, (Timer.Tccra->Value >> AVRSIM_REG_COM_B_GP) & AVRSIM_REG_COM_GM, Mode, MatchDown);
+        }
+    }
+} /* stepTimer */
+
+
+/******************************************************************************************************************************************************
+  readOutput()
+******************************************************************************************************************************************************/
+/*! \brief          read output compare pin of a timer
+ *  \details
+ *
+ *  \param[in]      Timer                       simulated timer
+ *  \param[in]      Pin                         arduino pin
+ *  \param[out]     Level                       level of output compare pin
+ *  \return         true if pin is an output compare pin which is connected to the timer
+ *****************************************************************************************************************************************************/
+template <typename T>
+static bool readOutput(const TimerType<T>& Timer, uint8_t Pin, uint8_t& Level)
+{
+    if((Pin == Timer.PinA) && (0u != ((Timer.Tccra->Value >> AVRSIM_REG_COM_A_GP) & AVRSIM_REG_COM_GM))) {
+        Level = Timer.OutputA;
+        return true;
+    }
+    if((Pin == Timer.PinB) && (0u != ((Timer.Tccra->Value >> AVRSIM_REG_COM_B_GP) & AVRSIM_REG_COM_GM))) {
+        Level = Timer.OutputB;
+        return true;
+    }
+    return false;
+} /* readOutput */
+
+
+/******************************************************************************************************************************************************
+ * P U B L I C   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  readPin()
+******************************************************************************************************************************************************/
+/*! \brief          read level of arduino pin
+ *  \details        output compare pins connected to a timer return the timer output
+ *
+ *  \param[in]      Pin                         arduino pin
+ *  \return         HIGH or LOW
+ *****************************************************************************************************************************************************/
+uint8_t AvrSim::readPin(uint8_t Pin)
+{
+    uint8_t Level;
+
+    if(readOutput(Timer1Sim, Pin, Level)) return Level;
+    if(readOutput(Timer2Sim, Pin, Level)) return Level;
+    return (Pin < AVRSIM_NUMBER_OF_PINS) ? Pins[Pin] : LOW;
+} /* readPin */
+
+
+/******************************************************************************************************************************************************
+  isCompareBuffered()
+******************************************************************************************************************************************************/
+/*! \brief          check if compare registers of a timer are double buffered
+ *  \details
+ *
+ *  \param[in]      Timer                       1 or 2
+ *  \return         true in pwm modes
+ *****************************************************************************************************************************************************/
+bool AvrSim::isCompareBuffered(uint8_t Timer)
+{
+    if(1u == Timer) return UPDATE_IMMEDIATE != getMode(Timer1Sim).Update;
+    if(2u == Timer) return UPDATE_IMMEDIATE != getMode(Timer2Sim).Update;
+    return false;
+} /* isCompareBuffered */
+
+
+/******************************************************************************************************************************************************
+  run()
+******************************************************************************************************************************************************/
+/*! \brief          advance the clock
+ *  \details        pending interrupts are executed after every cycle
+ *
+ *  \param[in]      sCycles                     number of cycles
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void AvrSim::run(uint32_t sCycles)
+{
+    while(sCycles-- > 0u) {
+        step();
+        dispatch();
+    }
+} /* run */
+
+
+/******************************************************************************************************************************************************
+  access()
+******************************************************************************************************************************************************/
+/*! \brief          account register access
+ *  \details
+ *
+ *  \param[in]      sCycles                     cycles of the access
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void AvrSim::access(uint8_t sCycles)
+{
+    run(sCycles);
+} /* access */
+
+
+/******************************************************************************************************************************************************
+  sleep()
+******************************************************************************************************************************************************/
+/*! \brief          advance the clock until an interrupt was executed
+ *  \details
+ *
+ *  \param[in]      MaxCycles                   maximum sleep time
+ *  \return         true if woken up by an interrupt
+ *****************************************************************************************************************************************************/
+bool AvrSim::sleep(uint32_t MaxCycles)
+{
+    uint32_t Count = InterruptCount;
+
+    while((MaxCycles-- > 0u) && (Count == InterruptCount)) {
+        step();
+        dispatch();
+    }
+    return Count != InterruptCount;
+} /* sleep */
+
+
+/******************************************************************************************************************************************************
+  writePin()
+******************************************************************************************************************************************************/
+/*! \brief          set level of arduino pin
+ *  \details
+ *
+ *  \param[in]      Pin                         arduino pin
+ *  \param[in]      Level                       HIGH or LOW
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void AvrSim::writePin(uint8_t Pin, uint8_t Level)
+{
+    if(Pin < AVRSIM_NUMBER_OF_PINS) Pins[Pin] = Level;
+} /* writePin */
+
+
+/******************************************************************************************************************************************************
+  setSignal()
+******************************************************************************************************************************************************/
+/*! \brief          drive a square wave on an arduino pin
+ *  \details        the pin toggles in the cycle where a phase accumulator overflows, so any frequency up to F_CPU / 2 is
+ *                  met on average
+ *  \param[in]      Pin                         arduino pin
+ *  \param[in]      Frequency                   frequency in Hz, 0 stops the generator
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void AvrSim::setSignal(uint8_t Pin, uint32_t Frequency)
+{
+    SignalPin = Pin;
+    SignalFrequency = Frequency;
+    SignalPhase = 0u;
+} /* setSignal */
+
+
+/******************************************************************************************************************************************************
+  setBusy()
+******************************************************************************************************************************************************/
+/*! \brief          set update busy flag of Timer2
+ *  \details        the flag is only set in asynchronous mode, the written value itself is used at once
+ *
+ *  \param[in]      Mask                        update busy flag in ASSR
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void AvrSim::setBusy(uint8_t Mask)
+{
+    if(0u != (ASSR.Value & (1u << AS2))) ASSR.Value |= Mask;
+} /* setBusy */
+
+
+/******************************************************************************************************************************************************
+  raiseFlag()
+******************************************************************************************************************************************************/
+/*! \brief          set interrupt flag
+ *  \details        the cycle of the first raise is kept to measure the interrupt latency
+ *
+ *  \param[in]      Vector                      vector of the flag
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void AvrSim::raiseFlag(VectorType Vector)
+{
+    if(Vector < NUMBER_OF_VECTORS) {
+        if(0u == (Vectors[Vector].FlagRegister->Value & (1u << Vectors[Vector].Flag))) RaiseCycle[Vector] = Cycles;
+        Vectors[Vector].FlagRegister->Value |= (1u << Vectors[Vector].Flag);
+    }
+} /* raiseFlag */
+
+
+/******************************************************************************************************************************************************
+  dispatch()
+******************************************************************************************************************************************************/
+/*! \brief          execute pending interrupts
+ *  \details        interrupts are executed by priority while the global interrupt flag is set, the flag is cleared by
+ *                  hardware on entry
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void AvrSim::dispatch()
+{
+    uint8_t Vector = 0u;
+    uint64_t Start;
+    uint32_t InterruptCycles;
+
+    while((SREG.Value & (1u << SREG_I)) && (Vector < NUMBER_OF_VECTORS)) {
+        const VectorDescriptionType& Description = Vectors[Vector];
+        if((Description.Handler != NULL) && (Description.FlagRegister->Value & (1u << Description.Flag)) &&
+           (Description.MaskRegister->Value & (1u << Description.Enable))) {
+            Description.FlagRegister->Value &= ~(1u << Description.Flag);
+            SREG.Value &= ~(1u << SREG_I);
+            InterruptCount++;
+            Start = Cycles;
+            if((Cycles - RaiseCycle[Vector]) > Statistic[Vector].MaxLatency) Statistic[Vector].MaxLatency = Cycles - RaiseCycle[Vector];
+            run(AVRSIM_INTERRUPT_ENTRY_CYCLES);
+            Description.Handler();
+            run(AVRSIM_INTERRUPT_EXIT_CYCLES);
+            SREG.Value |= (1u << SREG_I);
+            InterruptCycles = Cycles - Start;
+            Statistic[Vector].Count++;
+            Statistic[Vector].SumCycles += InterruptCycles;
+            if(InterruptCycles > Statistic[Vector].MaxCycles) Statistic[Vector].MaxCycles = InterruptCycles;
+            /* start again with highest priority */
+            Vector = 0u;
+        } else {
+            Vector++;
+        }
+    }
+} /* dispatch */
+
+
+/******************************************************************************************************************************************************
+  clearStatistics()
+******************************************************************************************************************************************************/
+/*! \brief          clear interrupt measurements
+ *  \details
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void AvrSim::clearStatistics()
+{
+    for(uint8_t Vector = 0u; Vector < NUMBER_OF_VECTORS; Vector++) {
+        Statistic[Vector].Count = 0u;
+        Statistic[Vector].MaxLatency = 0u;
+        Statistic[Vector].MaxCycles = 0u;
+        Statistic[Vector].SumCycles = 0u;
+    }
+} /* clearStatistics */
+
+
+/******************************************************************************************************************************************************
+  printStatistics()
+******************************************************************************************************************************************************/
+/*! \brief          print interrupt measurements of all executed vectors
+ *  \details
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void AvrSim::printStatistics()
+{
+    printf("cycles %llu\n", (unsigned long long) Cycles);
+    printf("%-14s %10s %12s %10s %10s\n", "vector", "count", "max latency", "max cycles", "avg cycles");
+    for(uint8_t Vector = 0u; Vector < NUMBER_OF_VECTORS; Vector++) {
+        if(Statistic[Vector].Count > 0u) {
+            printf("%-14s %10lu %12lu %10lu %10lu\n", Vectors[Vector].Name, (unsigned long) Statistic[Vector].Count,
+                   (unsigned long) Statistic[Vector].MaxLatency, (unsigned long) Statistic[Vector].MaxCycles,
+                   (unsigned long) (Statistic[Vector].SumCycles / Statistic[Vector].Count));
+        }
+    }
+} /* printStatistics */
+
+
+/******************************************************************************************************************************************************
+  check()
+******************************************************************************************************************************************************/
+/*! \brief          check a condition of a test sketch
+ *  \details        a failed check is printed and counted, the simulator exits with an error code if one check failed
+ *
+ *  \param[in]      Condition                   condition which has to be true
+ *  \param[in]      Description                 text of the condition
+ *  \return         Condition
+ *****************************************************************************************************************************************************/
+bool AvrSim::check(bool Condition, const char* Description)
+{
+    if(!Condition) {
+        Failures++;
+        printf("FAILED at cycle %llu: %s\n", (unsigned long long) Cycles, Description);
+    }
+    return Condition;
+} /* check */
+
+
+/******************************************************************************************************************************************************
+ * P R I V A T E   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  step()
+******************************************************************************************************************************************************/
+/*! \brief          simulate one cycle
+ *  \details
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void AvrSim::step()
+{
+    Cycles++;
+    if((0u != SignalFrequency) && (SignalPin < AVRSIM_NUMBER_OF_PINS)) {
+        SignalPhase += SignalFrequency << 1;
+        if(SignalPhase >= (uint32_t) F_CPU) {
+            SignalPhase -= F_CPU;
+            Pins[SignalPin] = (HIGH == Pins[SignalPin]) ? LOW : HIGH;
+        }
+    }
+    stepTimer(Timer1Sim, Cycles);
+    if(0u != (ASSR.Value & (1u << AS2))) {
+        /* Timer2 is clocked by the watch crystal, the update busy flags are cleared at its next clock */
+        AsyncPhase += AVRSIM_ASYNC_FREQUENCY;
+        if(AsyncPhase >= (uint32_t) F_CPU) {
+            AsyncPhase -= F_CPU;
+            AsyncCycles++;
+            ASSR.Value &= (uint8_t) ~((1u << TCN2UB) | (1u << OCR2AUB) | (1u << OCR2BUB) | (1u << TCR2AUB) | (1u << TCR2BUB));
+            stepTimer(Timer2Sim, AsyncCycles);
+        }
+    } else {
+        stepTimer(Timer2Sim, Cycles);
+    }
+} /* step */
+
+
+/******************************************************************************************************************************************************
+ * A R D U I N O   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+void pinMode(uint8_t Pin, uint8_t Mode)
+{
+    (void) Pin;
+    (void) Mode;
+}
+
+void digitalWrite(uint8_t Pin, uint8_t Level)
+{
+    AvrSim::writePin(Pin, Level);
+}
+
+int digitalRead(uint8_t Pin)
+{
+    return AvrSim::readPin(Pin);
+}
+
+unsigned long millis(void)
+{
+    return (unsigned long) (AvrSim::getCycles() / (F_CPU / 1000uL));
+}
+
+unsigned long micros(void)
+{
+    return (unsigned long) (AvrSim::getCycles() / (F_CPU / 1000000uL));
+}
+
+void delay(unsigned long Milliseconds)
+{
+    /* delay() of the arduino core calls yield() while waiting */
+    while(Milliseconds-- > 0u) {
+        yield();
+        AvrSim::run(F_CPU / 1000uL);
+    }
+}
+
+void delayMicroseconds(unsigned int Microseconds)
+{
+    AvrSim::run(Microseconds * (F_CPU / 1000000uL));
+}
+
+void yield(void) __attribute__((weak));
+void yield(void)
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
@@ -0,0 +1,54 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       AvrSimMain.cpp
+ *      \brief      Arduino main loop of the host simulator
+ *
+ *      \details    Runs setup() and loop() of a sketch for the simulated time given in milliseconds as first argument
+ *                  and prints the interrupt measurements. The exit code is 1 if a check of the sketch failed.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include "Arduino.h"
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+/* cycles between two calls of loop(), loop() itself advances the clock by its register accesses */
+#define AVRSIM_LOOP_CYCLES                          16u
+#define AVRSIM_DEFAULT_MILLISECONDS                 1000uL
+
+
+/******************************************************************************************************************************************************
+ * P U B L I C   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+int main(int argc, char* argv[])
+{
+    unsigned long Milliseconds = (argc > 1) ? strtoul(argv[1], NULL, 10) : AVRSIM_DEFAULT_MILLISECONDS;
+
+    /* init() of the arduino core enables interrupts */
+    sei();
+    setup();
+    while(millis() < Milliseconds) {
+        loop();
+        AvrSim::run(AVRSIM_LOOP_CYCLES);
+    }
+    AvrSim::printStatistics();
+    return (0u == AvrSim::getFailures()) ? 0 : 1;
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
@@ -0,0 +1,166 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       HwTimerTest.cpp
+ *      \brief      Test of the four HwTimer instantiations
+ *
+ *      \details    Every instantiation runs with its interrupt vector bound to handleInterrupt(): the distance of the
+ *                  callbacks has to be the period, the pwm instantiations have to output half duty cycle on channel B.
+ *                  setPeriod<Microseconds>() has to select the same prescaler and TOP as setPeriod(), and
+ *                  handleInterrupt() has to return without a callback.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <HwTimer.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+/* interrupt entry, register accesses of handleInterrupt() and the pin sampling of the test */
+#define TEST_JITTER_CYCLES                          16u
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA TYPES AND STRUCTURES
+ *****************************************************************************************************************************************************/
+/* callbacks of one instantiation */
+template <class Timer>
+struct Probe
+{
+    static unsigned long Calls;
+    static uint64_t LastCall;
+    static uint64_t MinDistance;
+    static uint64_t MaxDistance;
+
+    static void callback()
+    {
+        uint64_t Now = AvrSim::getCycles();
+
+        if(Calls > 0u) {
+            if(Now - LastCall < MinDistance) MinDistance = Now - LastCall;
+            if(Now - LastCall > MaxDistance) MaxDistance = Now - LastCall;
+        }
+        LastCall = Now;
+        Calls++;
+    }
+};
+
+template <class Timer> unsigned long Probe<Timer>::Calls = 0u;
+template <class Timer> uint64_t Probe<Timer>::LastCall = 0u;
+template <class Timer> uint64_t Probe<Timer>::MinDistance = ~0uLL;
+template <class Timer> uint64_t Probe<Timer>::MaxDistance = 0u;
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+/* prescaler and TOP of the running timer after setPeriod(Microseconds) and after setPeriod<Microseconds>() */
+template <class Timer, class Traits, uint32_t Microseconds>
+static void testCompileTimePeriod()
+{
+    byte ClockSelect;
+    typename Timer::CounterType Top;
+
+    AVRSIM_CHECK(E_OK == Timer::setPeriod(Microseconds));
+    ClockSelect = Traits::tccrb() & HWTIMER_REG_CS_GM;
+    Top = Timer::getTop();
+    AVRSIM_CHECK(E_OK == Timer::template setPeriod<Microseconds>());
+    AVRSIM_CHECK(ClockSelect == (Traits::tccrb() & HWTIMER_REG_CS_GM));
+    AVRSIM_CHECK(Top == Timer::getTop());
+}
+
+template <class Timer, class Traits, bool Pwm>
+static void testTimer(const char* Name, unsigned long Microseconds, unsigned long Milliseconds)
+{
+    const uint64_t Period = Microseconds * (F_CPU / 1000000uL);
+    const typename Timer::CounterType HalfDuty = (typename Timer::CounterType) (1uL << (Traits::NUMBER_OF_BITS - 1u));
+    unsigned long High = 0u;
+    unsigned long Calls;
+
+    AVRSIM_CHECK(E_OK == Timer::init(Microseconds, Probe<Timer>::callback));
+    if(Pwm) AVRSIM_CHECK(E_OK == Timer::enablePwm(Timer::CHANNEL_B, HalfDuty));
+    else AVRSIM_CHECK(E_NOT_OK == Timer::enablePwm(Timer::CHANNEL_B, HalfDuty));
+    AVRSIM_CHECK(E_OK == Timer::start());
+    delay(Milliseconds);
+    /* duty cycle of one period */
+    for(uint64_t Cycle = 0u; Cycle < Period; Cycle++) {
+        AvrSim::run(1u);
+        if(HIGH == AvrSim::readPin(Traits::CHANNEL_B_ARDUINO_PIN)) High++;
+    }
+    testCompileTimePeriod<Timer, Traits, 100u>();
+    testCompileTimePeriod<Timer, Traits, 1000u>();
+    testCompileTimePeriod<Timer, Traits, 4000u>();
+    testCompileTimePeriod<Timer, Traits, 16000u>();
+    Timer::stop();
+    Timer::detachInterrupt();
+    /* interrupt which was pending at detachInterrupt() */
+    Calls = Probe<Timer>::Calls;
+    Timer::handleInterrupt();
+    printf("%s: %lu calls, distance %llu..%llu cycles, high %lu of %llu cycles\n", Name, Calls,
+           (unsigned long long) Probe<Timer>::MinDistance, (unsigned long long) Probe<Timer>::MaxDistance, High, (unsigned long long) Period);
+    AVRSIM_CHECK(Calls == Probe<Timer>::Calls);
+    AVRSIM_CHECK(Calls + 1u >= Milliseconds * 1000uL / Microseconds);
+    AVRSIM_CHECK(Probe<Timer>::MinDistance + TEST_JITTER_CYCLES >= Period);
+    AVRSIM_CHECK(Probe<Timer>::MaxDistance <= Period + TEST_JITTER_CYCLES);
+    if(Pwm) AVRSIM_CHECK((High + Period / 100u >= Period / 2u) && (High <= Period / 2u + Period / 100u));
+    else AVRSIM_CHECK(0u == High);
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    testTimer<HwTimer1Ctc, HwTimer1Traits, false>("HwTimer1Ctc", 1000u, 20u);
+    testTimer<HwTimer1Pwm, HwTimer1Traits, true>("HwTimer1Pwm", 1000u, 20u);
+    testTimer<HwTimer2Ctc, HwTimer2Traits, false>("HwTimer2Ctc", 1000u, 20u);
+    testTimer<HwTimer2Pwm, HwTimer2Traits, true>("HwTimer2Pwm", 1000u, 20u);
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ * I S R   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+ISR(TIMER1_CAPT_vect)
+{
+    HwTimer1Ctc::handleInterrupt();
+}
+
+ISR(TIMER1_OVF_vect)
+{
+    HwTimer1Pwm::handleInterrupt();
+}
+
+ISR(TIMER2_COMPA_vect)
+{
+    HwTimer2Ctc::handleInterrupt();
+}
+
+ISR(TIMER2_OVF_vect)
+{
+    HwTimer2Pwm::handleInterrupt();
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
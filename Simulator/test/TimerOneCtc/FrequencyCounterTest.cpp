@@ -0,0 +1,128 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       FrequencyCounterTest.cpp
+ *      \brief      Test of the FrequencyCounter from 1 kHz to 6 MHz and across overflow epochs of Timer1
+ *
+ *      \details    A square wave on T1 is counted in windows of 100 milliseconds, every window has to hold the edges of
+ *                  its length within one count. Above 655 kHz the 16 bit counter of Timer1 overflows in every window, so
+ *                  the count is only right with the epochs of the overflow interrupt.
+ *                  The gate interrupt is also called while the overflow of Timer1 is still pending: the counter is set
+ *                  to 0xFFFF without signal and wrapped by one edge with interrupts disabled, the window of one
+ *                  millisecond has to hold the jump of the counter and this edge.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerOne.h>
+#include <FrequencyCounter.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+/* T1, Chip Pin 11, Pin name PD5 */
+#define TEST_SIGNAL_PIN                             5u
+#define TEST_GATE_MILLISECONDS                      100u
+/* a window ends after one gate, the first one after a change is not checked */
+#define TEST_TIMEOUT_CYCLES                         (3uL * TEST_GATE_MILLISECONDS * (F_CPU / 1000uL))
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+static bool waitWindow()
+{
+    uint64_t Timeout = AvrSim::getCycles() + TEST_TIMEOUT_CYCLES;
+
+    while(!FreqCounter.available() && (AvrSim::getCycles() < Timeout)) AvrSim::run(1u);
+    return FreqCounter.available();
+}
+
+static void testFrequency(uint32_t Frequency)
+{
+    const uint32_t Expected = Frequency / (1000uL / TEST_GATE_MILLISECONDS);
+    uint32_t Count;
+    uint32_t Measured;
+
+    AvrSim::setSignal(TEST_SIGNAL_PIN, Frequency);
+    /* window of the frequency change */
+    AVRSIM_CHECK(waitWindow());
+    (void) FreqCounter.read();
+    AVRSIM_CHECK(waitWindow());
+    Count = FreqCounter.read();
+    AVRSIM_CHECK(!FreqCounter.available());
+    AVRSIM_CHECK(waitWindow());
+    Measured = FreqCounter.getFrequency();
+    printf("signal %7lu Hz: %6lu edges (expected %6lu), %7lu Hz measured\n", (unsigned long) Frequency, (unsigned long) Count,
+           (unsigned long) Expected, (unsigned long) Measured);
+    AVRSIM_CHECK((Count + 1u >= Expected) && (Count <= Expected + 1u));
+    AVRSIM_CHECK((Measured + 1000uL / TEST_GATE_MILLISECONDS >= Frequency) && (Measured <= Frequency + 1000uL / TEST_GATE_MILLISECONDS));
+}
+
+/* gate interrupt while the overflow interrupt of Timer1 is pending */
+static void testPendingOverflow()
+{
+    uint32_t Before;
+    uint32_t Jump;
+    uint32_t Count;
+
+    AvrSim::setSignal(TEST_SIGNAL_PIN, 0u);
+    /* every gate interrupt ends a window */
+    AVRSIM_CHECK(E_OK == FreqCounter.start(1u));
+    AVRSIM_CHECK(waitWindow());
+    (void) FreqCounter.read();
+    noInterrupts();
+    Before = Timer1.getTicks();
+    TCNT1 = 0xFFFFu;
+    Jump = Timer1.getTicks() - Before;
+    /* one rising edge on T1 */
+    AvrSim::writePin(TEST_SIGNAL_PIN, LOW);
+    AvrSim::run(1u);
+    AvrSim::writePin(TEST_SIGNAL_PIN, HIGH);
+    AvrSim::run(1u);
+    AVRSIM_CHECK((0u == TCNT1.Value) && (0u != (TIFR1.Value & (1u << TOV1))));
+    FreqCounter.gateInterrupt();
+    interrupts();
+    Count = FreqCounter.read();
+    printf("pending overflow: %lu edges (expected %lu)\n", (unsigned long) Count, (unsigned long) (Jump + 1u));
+    AVRSIM_CHECK(Jump + 1u == Count);
+    /* the epoch of the overflow interrupt is not counted twice */
+    AVRSIM_CHECK(waitWindow());
+    AVRSIM_CHECK(0u == FreqCounter.read());
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    const uint32_t Frequencies[] = { 1000uL, 12345uL, 100000uL, 655360uL, 1000000uL, 3333333uL, 6000000uL };
+
+    AVRSIM_CHECK(E_OK == FreqCounter.init());
+    AVRSIM_CHECK(E_OK == FreqCounter.start(TEST_GATE_MILLISECONDS));
+    for(byte Index = 0u; Index < sizeof(Frequencies) / sizeof(Frequencies[0]); Index++) testFrequency(Frequencies[Index]);
+    testPendingOverflow();
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
@@ -0,0 +1,96 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       NowTicksTest.cpp
+ *      \brief      Test of the lock-free nowTicks() of TimerOne
+ *
+ *      \details    Timer1 runs without prescaler in tickless mode, so one tick is one cycle. nowTicks() is read in a
+ *                  loop while a Timer2 interrupt reads Timer1 by getTicks(), which overwrites the TEMP register of the
+ *                  16 bit access. Every timestamp has to follow the previous one and lie within the cycles of the read.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerOne.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define TEST_READS                                  200000uL
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA
+ *****************************************************************************************************************************************************/
+static volatile unsigned long Timer2Reads;
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    unsigned long long Last = 0u;
+    unsigned long long Now;
+    uint64_t Start, Before, After;
+    unsigned long Errors = 0u;
+
+    AVRSIM_CHECK(E_OK == Timer1.init(1000));
+    AVRSIM_CHECK(E_OK == Timer1.setMode(TIMERONE_MODE_TICKLESS));
+    /* Timer2 in CTC mode without prescaler, compare B interrupt every 37 cycles */
+    TCCR2A = (1u << WGM21);
+    OCR2A = 36u;
+    OCR2B = 0u;
+    TIMSK2 = (1u << OCIE2B);
+    TCCR2B = (1u << CS20);
+    AVRSIM_CHECK(E_OK == Timer1.start());
+    Start = AvrSim::getCycles();
+
+    for(unsigned long Read = 0u; Read < TEST_READS; Read++) {
+        Before = AvrSim::getCycles() - Start;
+        Now = Timer1.nowTicks();
+        After = AvrSim::getCycles() - Start;
+        if((Now < Last) || (Now + 8u < Before) || (Now > After + 8u)) {
+            if(Errors++ < 10u) printf("read %lu: %llu after %llu, read between %llu and %llu\n", Read, Now, Last,
+                                      (unsigned long long) Before, (unsigned long long) After);
+        }
+        Last = Now;
+    }
+    TCCR2B = 0u;
+    printf("%lu reads over %llu ticks, %lu Timer2 reads, %lu errors\n", TEST_READS, Last, Timer2Reads, Errors);
+    AVRSIM_CHECK(0u == Errors);
+    /* the epoch has to be counted */
+    AVRSIM_CHECK(Last > 4uL * TIMERONE_RESOLUTION);
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ * I S R   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+ISR(TIMER2_COMPB_vect)
+{
+    Timer1.getTicks();
+    Timer2Reads++;
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
@@ -0,0 +1,94 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       PeriodTemplateTest.cpp
+ *      \brief      Test of setPeriod<Microseconds>() against setPeriod(unsigned long)
+ *
+ *      \details    For periods on both sides of every prescaler step, the compile time calculation has to write the
+ *                  same ICR1 and clock select bits as the runtime calculation. The longest period which compiles is
+ *                  the longest one setPeriod() accepts with E_OK. With TEST_COMPILE_ERROR the first period out of
+ *                  bounds is requested, the Makefile checks that it fails to compile with TimerOnePeriodOutOfBounds.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerOne.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+/* longest period of the 16 bit counter with prescaler 1024 */
+#define TEST_MAX_PERIOD                             ((TIMERONE_RESOLUTION * TIMERONE_MAX_PRESCALER) / (F_CPU / 1000000uL) - 1u)
+/* period which is set in between, so the registers are written again */
+#define TEST_OTHER_PERIOD                           3u
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+template <unsigned long Microseconds>
+static void testPeriod()
+{
+    unsigned int Top;
+    byte ClockSelect;
+
+    AVRSIM_CHECK(E_OK == Timer1.setPeriod(Microseconds));
+    Top = ICR1.Value;
+    ClockSelect = TCCR1B.Value & TIMERONE_REG_CS_GM;
+    AVRSIM_CHECK(E_OK == Timer1.setPeriod(TEST_OTHER_PERIOD));
+    AVRSIM_CHECK(E_OK == Timer1.setPeriod<Microseconds>());
+    printf("period %7lu us: top %5u, clock select %u\n", Microseconds, (unsigned int) ICR1.Value, (unsigned int) (TCCR1B.Value & TIMERONE_REG_CS_GM));
+    AVRSIM_CHECK(Top == ICR1.Value);
+    AVRSIM_CHECK(ClockSelect == (TCCR1B.Value & TIMERONE_REG_CS_GM));
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    AVRSIM_CHECK(E_OK == Timer1.init(1000));
+    AVRSIM_CHECK(E_OK == Timer1.start());
+    testPeriod<1uL>();
+    testPeriod<1000uL>();
+    testPeriod<4095uL>();
+    /* prescaler 8 */
+    testPeriod<4096uL>();
+    testPeriod<32767uL>();
+    /* prescaler 64 */
+    testPeriod<32768uL>();
+    testPeriod<262143uL>();
+    /* prescaler 256 */
+    testPeriod<262144uL>();
+    testPeriod<1048575uL>();
+    /* prescaler 1024 */
+    testPeriod<1048576uL>();
+    testPeriod<TEST_MAX_PERIOD>();
+    AVRSIM_CHECK(E_NOT_OK == Timer1.setPeriod(TEST_MAX_PERIOD + 1u));
+#ifdef TEST_COMPILE_ERROR
+    Timer1.setPeriod<TEST_MAX_PERIOD + 1u>();
+#endif
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
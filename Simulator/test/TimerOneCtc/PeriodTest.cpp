@@ -0,0 +1,91 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       PeriodTest.cpp
+ *      \brief      Test of the TimerOne compare interrupt period
+ *
+ *      \details    The callback has to be called once per period, the distance of two calls may only vary by the
+ *                  interrupt latency.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerOne.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA
+ *****************************************************************************************************************************************************/
+static unsigned long Calls;
+static uint64_t LastCall;
+static uint64_t MinDistance;
+static uint64_t MaxDistance;
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+static void callback()
+{
+    uint64_t Now = AvrSim::getCycles();
+
+    if(Calls > 0u) {
+        if(Now - LastCall < MinDistance) MinDistance = Now - LastCall;
+        if(Now - LastCall > MaxDistance) MaxDistance = Now - LastCall;
+    }
+    LastCall = Now;
+    Calls++;
+}
+
+static void testPeriod(unsigned long Microseconds, unsigned long Milliseconds)
+{
+    uint64_t Period = Microseconds * (F_CPU / 1000000uL);
+
+    Calls = 0u;
+    MinDistance = ~0uLL;
+    MaxDistance = 0u;
+    AVRSIM_CHECK(E_OK == Timer1.setPeriod(Microseconds));
+    AVRSIM_CHECK(E_OK == Timer1.start());
+    delay(Milliseconds);
+    Timer1.stop();
+    printf("period %lu us: %lu calls, distance %llu..%llu cycles\n", Microseconds, Calls, (unsigned long long) MinDistance,
+           (unsigned long long) MaxDistance);
+    AVRSIM_CHECK(Calls + 1u >= Milliseconds * 1000uL / Microseconds);
+    AVRSIM_CHECK(Calls <= Milliseconds * 1000uL / Microseconds);
+    AVRSIM_CHECK(MinDistance + 16u >= Period);
+    AVRSIM_CHECK(MaxDistance <= Period + 16u);
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    AVRSIM_CHECK(E_OK == Timer1.init(1000, callback));
+    testPeriod(1000u, 100u);
+    testPeriod(250u, 20u);
+    /* prescaler 8 */
+    testPeriod(20000u, 200u);
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
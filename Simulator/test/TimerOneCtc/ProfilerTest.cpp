@@ -0,0 +1,114 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       ProfilerTest.cpp
+ *      \brief      Test of the run time statistic of the TimerOne compare callback
+ *
+ *      \details    One call of the callback is kept busy for a known number of cycles: within the period it is only the
+ *                  longest duration, a call which starts late and ends after the next compare match is an overrun, a
+ *                  call longer than the period is an overrun and a missed period. The calls before and after are short.
+ *                  The Makefile builds this test with TIMERONE_CALLBACK_PROFILER.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerOne.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+/* prescaler 1, so a timer tick is a cycle */
+#define TEST_PERIOD_MICROSECONDS                    1000u
+#define TEST_PERIOD_CYCLES                          (TEST_PERIOD_MICROSECONDS * (F_CPU / 1000000uL))
+/* reads of TCNT1 around the callback */
+#define TEST_MAX_OVERHEAD                           16u
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA
+ *****************************************************************************************************************************************************/
+/* cycles of the next call */
+static volatile unsigned long Busy = 0u;
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+static void compare()
+{
+    unsigned long Cycles = Busy;
+
+    Busy = 0u;
+    AvrSim::run(Cycles);
+}
+
+/* one call of Cycles, which starts Delay cycles after the compare match */
+static void testCall(unsigned long Delay, unsigned long Cycles, unsigned int Overruns, unsigned int MissedPeriods)
+{
+    TimerOneProfileType Profile;
+
+    noInterrupts();
+    Timer1.clearProfile();
+    TIFR1 = (1u << OCF1A);
+    while(0u == (TIFR1.Value & (1u << OCF1A))) AvrSim::run(1u);
+    AvrSim::run(Delay);
+    Busy = Cycles;
+    interrupts();
+    /* the late interrupt and two short ones */
+    AvrSim::run(3u * TEST_PERIOD_CYCLES);
+    Timer1.getProfile(&Profile);
+    printf("call of %5lu cycles after %4lu cycles: max duration %5lu ticks, %u overruns, %u missed periods\n", Cycles, Delay,
+           Profile.MaxDuration, Profile.Overruns, Profile.MissedPeriods);
+    AVRSIM_CHECK((Profile.MaxDuration >= Cycles) && (Profile.MaxDuration <= Cycles + TEST_MAX_OVERHEAD));
+    AVRSIM_CHECK(Overruns == Profile.Overruns);
+    AVRSIM_CHECK(MissedPeriods == Profile.MissedPeriods);
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    TimerOneProfileType Profile;
+
+    AVRSIM_CHECK(E_OK == Timer1.init(TEST_PERIOD_MICROSECONDS, compare));
+    AVRSIM_CHECK(E_OK == Timer1.start());
+    delay(10u);
+    Timer1.getProfile(&Profile);
+    AVRSIM_CHECK((Profile.MaxDuration <= TEST_MAX_OVERHEAD) && (0u == Profile.Overruns) && (0u == Profile.MissedPeriods));
+
+    testCall(0u, TEST_PERIOD_CYCLES / 16u, 0u, 0u);
+    testCall(0u, TEST_PERIOD_CYCLES / 2u, 0u, 0u);
+    /* ends after the next compare match, but the counter has not reached the start again */
+    testCall(TEST_PERIOD_CYCLES / 2u, 3u * TEST_PERIOD_CYCLES / 4u, 1u, 0u);
+    /* longer than the period */
+    testCall(0u, 5u * TEST_PERIOD_CYCLES / 4u, 1u, 1u);
+    testCall(TEST_PERIOD_CYCLES / 4u, 3u * TEST_PERIOD_CYCLES / 2u, 1u, 1u);
+
+    Timer1.clearProfile();
+    Timer1.getProfile(&Profile);
+    AVRSIM_CHECK((0u == Profile.MaxDuration) && (0u == Profile.Overruns) && (0u == Profile.MissedPeriods));
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
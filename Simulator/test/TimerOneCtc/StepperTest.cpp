@@ -0,0 +1,98 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       StepperTest.cpp
+ *      \brief      Test of the Stepper triangle speed profile with different acceleration and deceleration
+ *
+ *      \details    A move which is too short to reach its speed has to reach its peak speed after the share of the
+ *                  steps which is given by the ramps, v^2 = 2 * a * n, and has to end near standstill.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <Stepper.h>
+#include <math.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define TEST_STEPS                                  1000u
+#define TEST_SPEED                                  5000u
+/* cycles between two reads of the step count */
+#define TEST_POLL_CYCLES                            64u
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA
+ *****************************************************************************************************************************************************/
+static uint64_t StepCycles[TEST_STEPS];
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+static void testTriangle(uint32_t Acceleration, uint32_t Deceleration)
+{
+    uint32_t FirstStep = StepperMotor.getStepCount();
+    uint32_t Steps = 0u;
+    unsigned int PeakStep = 1u;
+    double PeakSpeed;
+    double FinalSpeed;
+    /* the ramps share the intervals in the inverse ratio of their rates */
+    double ExpectedPeakStep = (TEST_STEPS - 1u) * (double) Deceleration / (Acceleration + Deceleration);
+    double ExpectedPeakSpeed = sqrt(2.0 * Acceleration * ExpectedPeakStep);
+
+    AVRSIM_CHECK(E_OK == StepperMotor.setAcceleration(Acceleration, Deceleration));
+    AVRSIM_CHECK(E_OK == StepperMotor.queueMove(TEST_STEPS, TEST_SPEED));
+    while(Stepper::STATE_RUNNING == StepperMotor.getState()) {
+        AvrSim::run(TEST_POLL_CYCLES);
+        while((Steps < TEST_STEPS) && (StepperMotor.getStepCount() - FirstStep > Steps)) StepCycles[Steps++] = AvrSim::getCycles();
+    }
+    AVRSIM_CHECK(TEST_STEPS == Steps);
+    for(unsigned int Step = 2u; Step < Steps; Step++) {
+        if(StepCycles[Step] - StepCycles[Step - 1u] < StepCycles[PeakStep] - StepCycles[PeakStep - 1u]) PeakStep = Step;
+    }
+    PeakSpeed = (double) F_CPU / (StepCycles[PeakStep] - StepCycles[PeakStep - 1u]);
+    FinalSpeed = (double) F_CPU / (StepCycles[Steps - 1u] - StepCycles[Steps - 2u]);
+    printf("acceleration %5lu deceleration %5lu: peak at step %3u (expected %5.1f), %6.1f steps/s (expected %6.1f), final %6.1f steps/s\n",
+           (unsigned long) Acceleration, (unsigned long) Deceleration, PeakStep, ExpectedPeakStep, PeakSpeed, ExpectedPeakSpeed, FinalSpeed);
+    AVRSIM_CHECK(fabs(PeakStep - ExpectedPeakStep) <= TEST_STEPS / 100u);
+    AVRSIM_CHECK(fabs(PeakSpeed - ExpectedPeakSpeed) <= 0.03 * ExpectedPeakSpeed);
+    /* the last interval starts one step before standstill */
+    AVRSIM_CHECK(FinalSpeed <= 2.0 * sqrt(2.0 * Deceleration));
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    AVRSIM_CHECK(E_OK == StepperMotor.init(Stepper::PORT_D, 2u, Stepper::PORT_D, 3u));
+    testTriangle(1000u, 1000u);
+    testTriangle(4000u, 1000u);
+    testTriangle(1000u, 4000u);
+    AVRSIM_CHECK(3 * (int32_t) TEST_STEPS == StepperMotor.getPosition());
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
@@ -0,0 +1,189 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       ComplementaryPwmTest.cpp
+ *      \brief      Test of the complementary pwm pair OC1A (pin 9) and inverted OC1B (pin 10) with dead time
+ *
+ *      \details    Both pins are read every cycle. They must never be high at the same time, and from the falling edge
+ *                  of one pin to the rising edge of the other one there has to be the dead time in ticks, which is not
+ *                  shorter than the requested one. The pins must also keep this during a period change by
+ *                  setPeriodSync(), which converts the dead time to the ticks of the new prescaler.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerOne.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+/* TOP 800 with prescaler 1 */
+#define TEST_PERIOD_MICROSECONDS                    100u
+/* TOP 10000 with prescaler 8 */
+#define TEST_LONG_PERIOD_MICROSECONDS               10000u
+#define TEST_PERIODS                                4u
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA
+ *****************************************************************************************************************************************************/
+static const uint16_t Prescalers[8] = { 0u, 1u, 8u, 64u, 256u, 1024u, 0u, 0u };
+
+static unsigned int DeadTime;
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+static uint32_t getTick()
+{
+    return Prescalers[TCCR1B.Value & TIMERONE_REG_CS_GM];
+}
+
+/* runs Cycles and checks the pins every cycle, returns the number of dead time gaps, Gap is the dead time they must have */
+static unsigned int checkPins(uint64_t Cycles, uint32_t Gap)
+{
+    uint64_t End = AvrSim::getCycles() + Cycles;
+    uint8_t LastA = AvrSim::readPin(TIMERONE_PWM_PIN_9);
+    uint8_t LastB = AvrSim::readPin(TIMERONE_PWM_PIN_10);
+    uint8_t A;
+    uint8_t B;
+    uint64_t FallA = 0u;
+    uint64_t FallB = 0u;
+    unsigned int Overlaps = 0u;
+    unsigned int Gaps = 0u;
+    unsigned int WrongGaps = 0u;
+
+    while(AvrSim::getCycles() < End) {
+        AvrSim::run(1u);
+        A = AvrSim::readPin(TIMERONE_PWM_PIN_9);
+        B = AvrSim::readPin(TIMERONE_PWM_PIN_10);
+        if((HIGH == A) && (HIGH == B)) Overlaps++;
+        if((HIGH == LastA) && (LOW == A)) FallA = AvrSim::getCycles();
+        if((HIGH == LastB) && (LOW == B)) FallB = AvrSim::getCycles();
+        /* the requested dead time in nanoseconds is compared in cycles times 1000 */
+        if((LOW == LastB) && (HIGH == B) && (0u != FallA)) {
+            Gaps++;
+            if(((AvrSim::getCycles() - FallA) * 1000u < (uint64_t) DeadTime * (F_CPU / 1000000uL)) ||
+               ((0u != Gap) && (AvrSim::getCycles() - FallA != Gap))) WrongGaps++;
+        }
+        if((LOW == LastA) && (HIGH == A) && (0u != FallB)) {
+            Gaps++;
+            if(((AvrSim::getCycles() - FallB) * 1000u < (uint64_t) DeadTime * (F_CPU / 1000000uL)) ||
+               ((0u != Gap) && (AvrSim::getCycles() - FallB != Gap))) WrongGaps++;
+        }
+        LastA = A;
+        LastB = B;
+    }
+    AVRSIM_CHECK(0u == Overlaps);
+    AVRSIM_CHECK(0u == WrongGaps);
+    return Gaps;
+}
+
+/* a period is 2 * TOP ticks, OC1A is high below OCR1A, inverted OC1B above OCR1B */
+static void testDuty(unsigned int DutyCycle, unsigned int Gaps)
+{
+    uint32_t Tick = getTick();
+    uint32_t Period = 2u * ICR1.Value * Tick;
+    uint32_t Dead = Timer1.getDeadTimeTicks() * Tick;
+    unsigned int MeasuredGaps;
+
+    AVRSIM_CHECK(E_OK == Timer1.setComplementaryDuty(DutyCycle));
+    /* compare buffers are taken over at BOTTOM */
+    AvrSim::run(2u * Period);
+    printf("duty %5u, dead time %4u ns: OCR1A %5u, OCR1B %5u, TOP %5u, dead time %2u ticks of %u cycles", DutyCycle, DeadTime,
+           (unsigned int) OCR1A.Value, (unsigned int) OCR1B.Value, (unsigned int) ICR1.Value, Timer1.getDeadTimeTicks(), (unsigned int) Tick);
+    AVRSIM_CHECK(OCR1B.Value == OCR1A.Value + Timer1.getDeadTimeTicks());
+    AVRSIM_CHECK(OCR1B.Value <= ICR1.Value);
+    MeasuredGaps = checkPins(TEST_PERIODS * Period, Dead);
+    printf(", %u gaps\n", MeasuredGaps);
+    AVRSIM_CHECK(TEST_PERIODS * Gaps == MeasuredGaps);
+}
+
+static void testDeadTime(unsigned int Nanoseconds)
+{
+    uint32_t Tick;
+
+    DeadTime = Nanoseconds;
+    Timer1.stop();
+    AVRSIM_CHECK(E_OK == Timer1.enableComplementaryPwm(0u, Nanoseconds));
+    AVRSIM_CHECK(E_OK == Timer1.start());
+    Tick = getTick();
+    /* rounded up to ticks */
+    AVRSIM_CHECK(Timer1.getDeadTimeTicks() * Tick * 1000u >= Nanoseconds * (F_CPU / 1000000uL));
+    AVRSIM_CHECK((Timer1.getDeadTimeTicks() - 1u) * Tick * 1000u < Nanoseconds * (F_CPU / 1000000uL));
+
+    /* OC1A is never high, OC1B has no edge to compare with */
+    testDuty(0u, 0u);
+    testDuty(TIMERONE_RESOLUTION / 4u, 2u);
+    testDuty(TIMERONE_RESOLUTION / 2u, 2u);
+    testDuty(3u * TIMERONE_RESOLUTION / 4u, 2u);
+    /* limited to TOP minus the dead time, OC1B is continuously low */
+    testDuty(TIMERONE_RESOLUTION, 0u);
+}
+
+/* the pair is checked through the BOTTOM where the new period is committed */
+static void testPeriodSync(unsigned long Microseconds)
+{
+    uint32_t Period = 2u * ICR1.Value * getTick();
+
+    printf("period %5lu us:", Microseconds);
+    AVRSIM_CHECK(E_OK == Timer1.setComplementaryDuty(TIMERONE_RESOLUTION / 2u));
+    AvrSim::run(2u * Period);
+    AVRSIM_CHECK(E_OK == Timer1.setPeriodSync(Microseconds));
+    /* the gap around the change has the dead time of the old or the new prescaler */
+    checkPins(2u * Period, 0u);
+    while(Timer1.isPeriodPending()) AvrSim::run(1u);
+    printf(" OCR1A %5u, OCR1B %5u, TOP %5u, dead time %2u ticks of %u cycles\n", (unsigned int) OCR1A.Buffer, (unsigned int) OCR1B.Buffer,
+           (unsigned int) ICR1.Value, Timer1.getDeadTimeTicks(), (unsigned int) getTick());
+    AVRSIM_CHECK(OCR1B.Buffer == OCR1A.Buffer + Timer1.getDeadTimeTicks());
+    checkPins(TEST_PERIODS * 2u * ICR1.Value * getTick(), Timer1.getDeadTimeTicks() * getTick());
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    AVRSIM_CHECK(E_OK == Timer1.init(TEST_PERIOD_MICROSECONDS));
+    AVRSIM_CHECK(E_NOT_OK == Timer1.setComplementaryDuty(0u));
+    /* not shorter than TOP */
+    AVRSIM_CHECK(E_NOT_OK == Timer1.enableComplementaryPwm(0u, 1000u * TEST_PERIOD_MICROSECONDS));
+    AVRSIM_CHECK(E_OK == Timer1.start());
+    /* only while stopped */
+    AVRSIM_CHECK(E_NOT_OK == Timer1.enableComplementaryPwm(0u, 500u));
+
+    testDeadTime(4000u);
+    testDeadTime(500u);
+    /* rounded up from 11.2 cycles */
+    testDeadTime(700u);
+
+    /* prescaler 8 rounds 700 ns up to 2 ticks, and back to prescaler 1 */
+    testPeriodSync(TEST_LONG_PERIOD_MICROSECONDS);
+    testPeriodSync(TEST_PERIOD_MICROSECONDS);
+    Timer1.disableComplementaryPwm();
+    AVRSIM_CHECK(0u == (TCCR1A.Value & ((1u << COM1A1) | (1u << COM1B1) | (1u << COM1B0))));
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
@@ -0,0 +1,178 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       PeriodSweepTest.cpp
+ *      \brief      Test of setPeriodSync() in fast pwm mode 14 over periods of all prescalers
+ *
+ *      \details    Every pwm period on pin 9 and pin 10 has to have length and high times of either the old or the new
+ *                  period, up to one timer tick of each prescaler and the overflow interrupt. A period with the
+ *                  new compare values and the old TOP, or the other way round, fails. The overflow interrupt is at TOP
+ *                  in fast pwm mode, so it is late for BOTTOM with the short timer ticks of prescaler 1 and 8.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerOne.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define TEST_DUTY_A                                 (TIMERONE_RESOLUTION / 4u)
+#define TEST_DUTY_B                                 (3u * TIMERONE_RESOLUTION / 4u)
+/* periods with the new values which are checked after the change */
+#define TEST_PERIODS                                3u
+/* longest overflow interrupt, the pins are read between interrupts, so an edge during it is seen after it */
+#define TEST_INTERRUPT_CYCLES                       100u
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA TYPES AND STRUCTURES
+ *****************************************************************************************************************************************************/
+/* length and high times of a pwm period in cycles */
+struct PwmType {
+    uint32_t Length;
+    uint32_t HighA;
+    uint32_t HighB;
+    uint32_t Tick;
+};
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA
+ *****************************************************************************************************************************************************/
+static const uint16_t Prescalers[8] = { 0u, 1u, 8u, 64u, 256u, 1024u, 0u, 0u };
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+/* keeps the overflow interrupt enabled, so it is not raised by a flag which was set before setPeriodSync() */
+static void overflow()
+{
+
+}
+
+/* expected period of the registers, the compare buffers are used from the next BOTTOM on, the output is high from BOTTOM to
+   the timer clock after the compare match */
+static void readPwm(PwmType& Pwm)
+{
+    Pwm.Tick = Prescalers[TCCR1B.Value & TIMERONE_REG_CS_GM];
+    Pwm.Length = (ICR1.Value + 1uL) * Pwm.Tick;
+    Pwm.HighA = (OCR1A.Buffer + 1uL) * Pwm.Tick;
+    Pwm.HighB = (OCR1B.Buffer + 1uL) * Pwm.Tick;
+}
+
+static bool isNear(uint32_t Measured, uint32_t Expected, uint32_t Tolerance)
+{
+    return (Measured + Tolerance >= Expected) && (Measured <= Expected + Tolerance);
+}
+
+static bool isPwm(const PwmType& Measured, const PwmType& Expected, uint32_t LengthTolerance, uint32_t HighTolerance)
+{
+    return isNear(Measured.Length, Expected.Length, LengthTolerance) && isNear(Measured.HighA, Expected.HighA, HighTolerance) &&
+           isNear(Measured.HighB, Expected.HighB, HighTolerance);
+}
+
+static void testPeriod(unsigned long Microseconds)
+{
+    const AvrSim::StatisticType& Overflow = AvrSim::getStatistic(AvrSim::VECTOR_TIMER1_OVF);
+    PwmType Old;
+    PwmType New;
+    PwmType Measured;
+    uint64_t Rise = 0u;
+    uint64_t FallA = 0u;
+    uint64_t FallB = 0u;
+    uint64_t Timeout;
+    uint8_t LevelA = AvrSim::readPin(TIMERONE_PWM_PIN_9);
+    uint8_t LevelB = AvrSim::readPin(TIMERONE_PWM_PIN_10);
+    uint8_t Level;
+    uint32_t Tolerance;
+    unsigned int Periods = 0u;
+    unsigned int Mismatches = 0u;
+    bool Committed = false;
+
+    AvrSim::clearStatistics();
+    readPwm(Old);
+    New = Old;
+    AVRSIM_CHECK(E_OK == Timer1.setPeriodSync(Microseconds));
+    Timeout = AvrSim::getCycles() + 2u * Old.Length + (TEST_PERIODS + 2u) * Microseconds * (F_CPU / 1000000uL);
+    while((Periods < TEST_PERIODS) && (AvrSim::getCycles() < Timeout)) {
+        AvrSim::run(1u);
+        if(!Committed && !Timer1.isPeriodPending()) {
+            Committed = true;
+            readPwm(New);
+        }
+        Level = AvrSim::readPin(TIMERONE_PWM_PIN_10);
+        if((LOW == Level) && (HIGH == LevelB)) FallB = AvrSim::getCycles();
+        LevelB = Level;
+        Level = AvrSim::readPin(TIMERONE_PWM_PIN_9);
+        if((LOW == Level) && (HIGH == LevelA)) FallA = AvrSim::getCycles();
+        if((HIGH == Level) && (LOW == LevelA)) {
+            /* BOTTOM, a whole period was seen since the last one */
+            if((0u != Rise) && (FallA > Rise) && (FallB > Rise)) {
+                Measured.Length = AvrSim::getCycles() - Rise;
+                Measured.HighA = FallA - Rise;
+                Measured.HighB = FallB - Rise;
+                /* the prescaler runs on when it is changed, so the tick at the change has a length between both
+                   prescalers. It is the TOP tick of the last old period or the BOTTOM tick of the first new one. */
+                Tolerance = Old.Tick + New.Tick + TEST_INTERRUPT_CYCLES;
+                if(Committed && isPwm(Measured, New, Tolerance, Tolerance)) {
+                    Periods++;
+                } else if(!isPwm(Measured, Old, Tolerance, Old.Tick + TEST_INTERRUPT_CYCLES)) {
+                    printf("period %lu us: mismatch, length %lu high %lu/%lu cycles\n", Microseconds, (unsigned long) Measured.Length,
+                           (unsigned long) Measured.HighA, (unsigned long) Measured.HighB);
+                    Mismatches++;
+                }
+            }
+            Rise = AvrSim::getCycles();
+        }
+        LevelA = Level;
+    }
+    printf("period %6lu us: prescaler %4lu -> %4lu, length %8lu -> %8lu cycles, %u new periods\n", Microseconds, (unsigned long) Old.Tick,
+           (unsigned long) New.Tick, (unsigned long) Old.Length, (unsigned long) New.Length, Periods);
+    AVRSIM_CHECK(Committed);
+    AVRSIM_CHECK(TEST_PERIODS == Periods);
+    AVRSIM_CHECK(0u == Mismatches);
+    /* the interrupt waits for BOTTOM up to one timer tick */
+    AVRSIM_CHECK(Overflow.MaxCycles <= Old.Tick + TEST_INTERRUPT_CYCLES);
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    /* every step changes the period by more than a third, up and down across the prescalers */
+    const unsigned long Periods[] = { 100u, 37u, 1000u, 250u, 4000u, 2500u, 20000u, 3000u, 60000u, 12000u, 100u, 150000u, 50u };
+
+    AVRSIM_CHECK(E_OK == Timer1.init(1000, overflow, TIMERONE_MODE_FAST_PWM));
+    AVRSIM_CHECK(E_OK == Timer1.enablePwm(TIMERONE_PWM_PIN_9, TEST_DUTY_A));
+    AVRSIM_CHECK(E_OK == Timer1.enablePwm(TIMERONE_PWM_PIN_10, TEST_DUTY_B));
+    AVRSIM_CHECK(E_OK == Timer1.start());
+    /* compare buffers are taken over at the first BOTTOM */
+    delay(2u);
+    for(byte Index = 0u; Index < sizeof(Periods) / sizeof(Periods[0]); Index++) testPeriod(Periods[Index]);
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
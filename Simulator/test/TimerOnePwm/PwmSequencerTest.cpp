@@ -0,0 +1,189 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       PwmSequencerTest.cpp
+ *      \brief      Test of the play back of compare value tables by the PwmSequencer
+ *
+ *      \details    After every overflow interrupt the compare buffers have to hold the next sample of OCR1A and OCR1B,
+ *                  which becomes active at the following BOTTOM. A looped table starts again at its end, a one shot
+ *                  table stops with its last sample. A queued table is swapped in at the end of the active one. A
+ *                  period change by setPeriod() or setPeriodSync() stops the play back without writing a sample.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerOne.h>
+#include <PwmSequencer.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+/* TOP 800 with prescaler 1 */
+#define TEST_PERIOD_MICROSECONDS                    100u
+#define TEST_OTHER_PERIOD_MICROSECONDS              200u
+#define TEST_PERIOD_CYCLES                          (TEST_PERIOD_MICROSECONDS * (F_CPU / 1000000uL))
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA
+ *****************************************************************************************************************************************************/
+/* OCR1A and OCR1B alternately */
+static const unsigned int Ramp[] = { 100u, 700u, 200u, 600u, 300u, 500u };
+static const unsigned int Steps[] PROGMEM = { 400u, 410u, 420u, 430u };
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+/* runs until the next overflow interrupt has written the compare buffers */
+static void waitOverflow()
+{
+    const AvrSim::StatisticType& Overflow = AvrSim::getStatistic(AvrSim::VECTOR_TIMER1_OVF);
+    unsigned long Count = Overflow.Count;
+    uint64_t Timeout = AvrSim::getCycles() + 2u * TEST_PERIOD_CYCLES;
+
+    while((Count == Overflow.Count) && (AvrSim::getCycles() < Timeout)) AvrSim::run(1u);
+    AVRSIM_CHECK(Count != Overflow.Count);
+}
+
+/* next Periods samples of Table, starting at sample First and wrapping at its end */
+static void checkSamples(const unsigned int* Table, unsigned int Length, unsigned int First, unsigned int Periods)
+{
+    unsigned int Sample = First;
+
+    for(unsigned int Period = 0u; Period < Periods; Period++) {
+        waitOverflow();
+        printf(" %u/%u", (unsigned int) OCR1A.Buffer, (unsigned int) OCR1B.Buffer);
+        AVRSIM_CHECK(Table[2u * Sample] == OCR1A.Buffer);
+        AVRSIM_CHECK(Table[2u * Sample + 1u] == OCR1B.Buffer);
+        Sample = (Sample + 1u) % (Length / 2u);
+    }
+    printf("\n");
+}
+
+/* the sequencer is idle after the next overflow interrupt and keeps the compare buffers */
+static void checkIdle(unsigned int CompareA, unsigned int CompareB)
+{
+    waitOverflow();
+    AVRSIM_CHECK(PwmSequencer::STATE_IDLE == Sequencer.getState());
+    waitOverflow();
+    AVRSIM_CHECK((CompareA == OCR1A.Buffer) && (CompareB == OCR1B.Buffer));
+}
+
+static void testLoop()
+{
+    printf("loop     ");
+    AVRSIM_CHECK(E_OK == Sequencer.play(Ramp, 6u));
+    AVRSIM_CHECK(PwmSequencer::STATE_RUNNING == Sequencer.getState());
+    checkSamples(Ramp, 6u, 0u, 7u);
+    /* the sample written at the BOTTOM before is active */
+    waitOverflow();
+    AVRSIM_CHECK((Ramp[0] == OCR1A.Value) && (Ramp[1] == OCR1B.Value));
+    AVRSIM_CHECK((Ramp[2] == OCR1A.Buffer) && (Ramp[3] == OCR1B.Buffer));
+    Sequencer.stop();
+    checkIdle(Ramp[2], Ramp[3]);
+}
+
+static void testOneShot()
+{
+    printf("one shot ");
+    AVRSIM_CHECK(E_OK == Sequencer.play(Steps, 4u, PwmSequencer::MODE_ONE_SHOT, PwmSequencer::MEMORY_PROGMEM));
+    checkSamples(Steps, 4u, 0u, 2u);
+    checkIdle(Steps[2], Steps[3]);
+    /* odd length does not fit the channel pair, zero length and NULL are rejected */
+    AVRSIM_CHECK(E_NOT_OK == Sequencer.play(Ramp, 5u));
+    AVRSIM_CHECK(E_NOT_OK == Sequencer.play(Ramp, 0u));
+    AVRSIM_CHECK(E_NOT_OK == Sequencer.play(NULL, 6u));
+    AVRSIM_CHECK(PwmSequencer::STATE_IDLE == Sequencer.getState());
+}
+
+static void testSwap()
+{
+    printf("swap     ");
+    /* an idle sequencer plays a queued table at once */
+    AVRSIM_CHECK(E_OK == Sequencer.queue(Ramp, 6u));
+    AVRSIM_CHECK(PwmSequencer::STATE_RUNNING == Sequencer.getState());
+    AVRSIM_CHECK(Sequencer.isBufferFree());
+    checkSamples(Ramp, 6u, 0u, 1u);
+    AVRSIM_CHECK(E_OK == Sequencer.queue(Steps, 4u, PwmSequencer::MODE_ONE_SHOT, PwmSequencer::MEMORY_PROGMEM));
+    AVRSIM_CHECK(!Sequencer.isBufferFree());
+    AVRSIM_CHECK(E_NOT_OK == Sequencer.queue(Ramp, 6u));
+    /* rest of the looped table, then the queued one */
+    printf("         ");
+    checkSamples(Ramp, 6u, 1u, 2u);
+    AVRSIM_CHECK(Sequencer.isBufferFree());
+    printf("         ");
+    checkSamples(Steps, 4u, 0u, 2u);
+    checkIdle(Steps[2], Steps[3]);
+}
+
+static void testPeriodChange()
+{
+    /* setPeriod() writes ICR1 at once, the next overflow interrupt stops without writing */
+    printf("period   ");
+    AVRSIM_CHECK(E_OK == Sequencer.play(Ramp, 6u));
+    checkSamples(Ramp, 6u, 0u, 1u);
+    AVRSIM_CHECK(E_OK == Timer1.setPeriod(TEST_OTHER_PERIOD_MICROSECONDS));
+    checkIdle(Ramp[0], Ramp[1]);
+    AVRSIM_CHECK(E_OK == Timer1.setPeriod(TEST_PERIOD_MICROSECONDS));
+
+    /* setPeriodSync() loads the compare buffers with the duty cycles of the TimerOne, the sequencer must not overwrite them */
+    printf("sync     ");
+    AVRSIM_CHECK(E_OK == Sequencer.play(Ramp, 6u));
+    checkSamples(Ramp, 6u, 0u, 1u);
+    AVRSIM_CHECK(E_OK == Timer1.setPeriodSync(TEST_OTHER_PERIOD_MICROSECONDS));
+    AVRSIM_CHECK(E_NOT_OK == Sequencer.play(Ramp, 6u));
+    waitOverflow();
+    AVRSIM_CHECK(PwmSequencer::STATE_IDLE == Sequencer.getState());
+    AVRSIM_CHECK((0u == OCR1A.Buffer) && (0u == OCR1B.Buffer));
+    while(Timer1.isPeriodPending()) AvrSim::run(1u);
+
+    /* a table of the new TOP is played again */
+    printf("new top  ");
+    AVRSIM_CHECK(E_OK == Sequencer.play(Ramp, 6u));
+    checkSamples(Ramp, 6u, 0u, 3u);
+    Sequencer.stop();
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    AVRSIM_CHECK(E_OK == Timer1.init(TEST_PERIOD_MICROSECONDS));
+    AVRSIM_CHECK(E_OK == Timer1.enablePwm(TIMERONE_PWM_PIN_9, 0u));
+    AVRSIM_CHECK(E_OK == Timer1.enablePwm(TIMERONE_PWM_PIN_10, 0u));
+    AVRSIM_CHECK(E_OK == Timer1.start());
+    AVRSIM_CHECK(E_NOT_OK == Sequencer.play(Ramp, 6u));
+    AVRSIM_CHECK(E_OK == Sequencer.init(PwmSequencer::CHANNEL_AB));
+    AVRSIM_CHECK(E_NOT_OK == Sequencer.init(PwmSequencer::CHANNEL_AB));
+    AVRSIM_CHECK(PwmSequencer::STATE_IDLE == Sequencer.getState());
+
+    testLoop();
+    testOneShot();
+    testSwap();
+    testPeriodChange();
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
@@ -0,0 +1,181 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       SyncPeriodTest.cpp
+ *      \brief      Test of the commit flag, the callback and the period boundaries of setPeriodSync() in phase and frequency
+ *                  correct mode 8
+ *
+ *      \details    While the timer is stopped, setPeriodSync() has to set the period at once without callback. While it
+ *                  runs, isPeriodPending() has to be set until the overflow interrupt has committed TOP and prescaler,
+ *                  the callback has to be called once and see the new registers. The longest period of the dual slope
+ *                  counter is accepted, one microsecond more is set as maximum with E_NOT_OK, longer requests are
+ *                  refused and leave the staged period unchanged. The longest period lasts seconds, so the timer is
+ *                  restarted after its commit.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerOne.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define TEST_DUTY                                   (TIMERONE_RESOLUTION / 4u)
+/* first period which does not fit into the dual slope counter with prescaler 1024 */
+#define TEST_MAX_PERIOD                             ((TIMERONE_RESOLUTION / (F_CPU / 1000000uL)) * TIMERONE_MAX_PRESCALER * 2u)
+/* longest period which is run */
+#define TEST_LONG_PERIOD                            100000uL
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA
+ *****************************************************************************************************************************************************/
+static const uint16_t Prescalers[8] = { 0u, 1u, 8u, 64u, 256u, 1024u, 0u, 0u };
+
+static unsigned int Calls = 0u;
+static bool CallbackPending = true;
+static unsigned int CallbackTop = 0u;
+static uint16_t CallbackPrescaler = 0u;
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+static uint16_t getPrescaler()
+{
+    return Prescalers[TCCR1B.Value & TIMERONE_REG_CS_GM];
+}
+
+static void committed()
+{
+    Calls++;
+    CallbackPending = Timer1.isPeriodPending();
+    CallbackTop = ICR1.Value;
+    CallbackPrescaler = getPrescaler();
+}
+
+/* dual slope period of TOP and prescaler, calcPeriod() rounds down by less than one tick on each slope */
+static bool isPeriod(unsigned long Microseconds, unsigned int Top, uint16_t Prescaler)
+{
+    uint64_t Cycles = 2uLL * Top * Prescaler;
+    uint64_t Requested = (uint64_t) Microseconds * (F_CPU / 1000000uL);
+
+    return (0u != Prescaler) && (Cycles <= Requested) && (Cycles + 2uL * Prescaler > Requested);
+}
+
+/* runs until the staged period is committed, this takes the rest of the old period and one more old period */
+static bool waitCommit()
+{
+    uint64_t Timeout = AvrSim::getCycles() + 2u * TEST_LONG_PERIOD * (F_CPU / 1000000uL);
+
+    while(Timer1.isPeriodPending() && (AvrSim::getCycles() < Timeout)) AvrSim::run(1u);
+    return !Timer1.isPeriodPending();
+}
+
+static void testSync(unsigned long OldMicroseconds, unsigned long Microseconds)
+{
+    unsigned int OldTop = ICR1.Value;
+    uint16_t OldPrescaler = getPrescaler();
+
+    Calls = 0u;
+    CallbackPending = true;
+    AVRSIM_CHECK(E_OK == Timer1.setPeriodSync(Microseconds, committed));
+    /* nothing is written before the next BOTTOM */
+    AVRSIM_CHECK(Timer1.isPeriodPending());
+    AVRSIM_CHECK(OldTop == ICR1.Value);
+    AVRSIM_CHECK(OldPrescaler == getPrescaler());
+    AVRSIM_CHECK(0u == Calls);
+    AVRSIM_CHECK(waitCommit());
+    printf("period %7lu -> %7lu us: top %5u -> %5u, prescaler %4u -> %4u, %u callback\n", OldMicroseconds, Microseconds, OldTop, CallbackTop,
+           OldPrescaler, CallbackPrescaler, Calls);
+    AVRSIM_CHECK(1u == Calls);
+    AVRSIM_CHECK(!CallbackPending);
+    AVRSIM_CHECK(isPeriod(Microseconds, CallbackTop, CallbackPrescaler));
+    /* without overflow callback the overflow interrupt is disabled after the commit */
+    AVRSIM_CHECK(0u == (TIMSK1.Value & (1u << TOIE1)));
+    /* the callback is called for one commit only */
+    if(Microseconds <= TEST_LONG_PERIOD) AvrSim::run(2u * Microseconds * (F_CPU / 1000000uL));
+    AVRSIM_CHECK(1u == Calls);
+}
+
+/* setPeriodSync() of the stopped timer sets the period at once, the timer is started again */
+static void restart(unsigned long Microseconds)
+{
+    Timer1.stop();
+    Calls = 0u;
+    AVRSIM_CHECK(E_OK == Timer1.setPeriodSync(Microseconds, committed));
+    AVRSIM_CHECK(!Timer1.isPeriodPending());
+    AVRSIM_CHECK(E_OK == Timer1.start());
+    AVRSIM_CHECK(isPeriod(Microseconds, ICR1.Value, getPrescaler()));
+    AVRSIM_CHECK(0u == Calls);
+    /* compare buffers are taken over at the first BOTTOM */
+    AvrSim::run(2u * Microseconds * (F_CPU / 1000000uL));
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    AVRSIM_CHECK(E_OK == Timer1.init(1000u));
+    AVRSIM_CHECK(E_OK == Timer1.enablePwm(TIMERONE_PWM_PIN_9, TEST_DUTY));
+    AVRSIM_CHECK(E_OK == Timer1.start());
+    restart(500u);
+
+    testSync(500u, 2000u);
+    testSync(2000u, 10u);
+    testSync(10u, TEST_LONG_PERIOD);
+    testSync(TEST_LONG_PERIOD, 1000u);
+    testSync(1000u, TEST_MAX_PERIOD - 1u);
+    restart(1000u);
+
+    /* out of bounds by rounding, the longest period is staged */
+    Calls = 0u;
+    AVRSIM_CHECK(E_NOT_OK == Timer1.setPeriodSync(TEST_MAX_PERIOD, committed));
+    AVRSIM_CHECK(Timer1.isPeriodPending());
+    AVRSIM_CHECK(waitCommit());
+    AVRSIM_CHECK(1u == Calls);
+    AVRSIM_CHECK((TIMERONE_RESOLUTION - 1u == CallbackTop) && (TIMERONE_MAX_PRESCALER == CallbackPrescaler));
+    restart(1000u);
+
+    /* out of bounds, nothing is staged, a staged period is kept */
+    AVRSIM_CHECK(E_NOT_OK == Timer1.setPeriodSync(TEST_MAX_PERIOD + 1u, committed));
+    AVRSIM_CHECK(!Timer1.isPeriodPending());
+    AVRSIM_CHECK(E_OK == Timer1.setPeriodSync(4000u, committed));
+    AVRSIM_CHECK(E_NOT_OK == Timer1.setPeriodSync(TEST_MAX_PERIOD + 1u, committed));
+    AVRSIM_CHECK(Timer1.isPeriodPending());
+    AVRSIM_CHECK(waitCommit());
+    AVRSIM_CHECK(1u == Calls);
+    AVRSIM_CHECK(isPeriod(4000u, CallbackTop, CallbackPrescaler));
+
+    /* commit without callback */
+    Calls = 0u;
+    AVRSIM_CHECK(E_OK == Timer1.setPeriodSync(1000u));
+    AVRSIM_CHECK(Timer1.isPeriodPending());
+    AVRSIM_CHECK(waitCommit());
+    AVRSIM_CHECK(isPeriod(1000u, ICR1.Value, getPrescaler()));
+    AVRSIM_CHECK(0u == Calls);
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
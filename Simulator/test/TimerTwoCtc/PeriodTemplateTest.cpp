@@ -0,0 +1,100 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       PeriodTemplateTest.cpp
+ *      \brief      Test of setPeriod<Microseconds>() against setPeriod(unsigned long)
+ *
+ *      \details    For periods on both sides of every prescaler step, the compile time calculation has to write the
+ *                  same OCR2A and clock select bits as the runtime calculation. The longest period which compiles is
+ *                  the longest one of the hardware counter. With TEST_COMPILE_ERROR the first period out of
+ *                  bounds is requested, the Makefile checks that it fails to compile with
+ *                  PeriodOutOfBounds of HwTimer2Ctc. Longer periods are run by setPeriod() with TIMERTWO_POSTSCALER,
+ *                  which the compile time calculation does not use.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerTwo.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+/* longest period of the 8 bit counter with prescaler 1024 */
+#define TEST_MAX_PERIOD                             ((TIMERTWO_RESOLUTION * TIMERTWO_MAX_PRESCALER) / (F_CPU / 1000000uL) - 1u)
+/* period which is set in between, so the registers are written again */
+#define TEST_OTHER_PERIOD                           3uL
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+template <unsigned long Microseconds>
+static void testPeriod()
+{
+    byte Top;
+    byte ClockSelect;
+
+    AVRSIM_CHECK(E_OK == Timer2.setPeriod(Microseconds));
+    Top = OCR2A.Value;
+    ClockSelect = TCCR2B.Value & TIMERTWO_REG_CS_GM;
+    AVRSIM_CHECK(E_OK == Timer2.setPeriod(TEST_OTHER_PERIOD));
+    AVRSIM_CHECK(E_OK == Timer2.setPeriod<Microseconds>());
+    printf("period %5lu us: top %3u, clock select %u\n", (unsigned long) Microseconds, (unsigned int) OCR2A.Value, (unsigned int) (TCCR2B.Value & TIMERTWO_REG_CS_GM));
+    AVRSIM_CHECK(Top == OCR2A.Value);
+    AVRSIM_CHECK(ClockSelect == (TCCR2B.Value & TIMERTWO_REG_CS_GM));
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    AVRSIM_CHECK(E_OK == Timer2.init(1000));
+    AVRSIM_CHECK(E_OK == Timer2.start());
+    testPeriod<1uL>();
+    testPeriod<15uL>();
+    /* prescaler 8 */
+    testPeriod<16uL>();
+    testPeriod<127uL>();
+    /* prescaler 32 */
+    testPeriod<128uL>();
+    testPeriod<511uL>();
+    /* prescaler 64 */
+    testPeriod<512uL>();
+    testPeriod<1023uL>();
+    /* prescaler 128 */
+    testPeriod<1024uL>();
+    testPeriod<2047uL>();
+    /* prescaler 256 */
+    testPeriod<2048uL>();
+    testPeriod<4095uL>();
+    /* prescaler 1024 */
+    testPeriod<4096uL>();
+    testPeriod<TEST_MAX_PERIOD>();
+#ifdef TEST_COMPILE_ERROR
+    Timer2.setPeriod<TEST_MAX_PERIOD + 1u>();
+#endif
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
@@ -0,0 +1,141 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       PostscalerTest.cpp
+ *      \brief      Test of the TimerTwo post-scaler for periods longer than the hardware period
+ *
+ *      \details    The compare interrupt runs with the longest hardware period, the callback is called after a whole number
+ *                  of hardware periods. Every call has to be off the exact period by the error getPostscalerError() reported
+ *                  after the call before, and the error must never exceed half a hardware period, so it does not
+ *                  accumulate. The first call may be up to two timer ticks early, it is the reference of the later calls.
+ *                  The Makefile builds this test with TIMERTWO_POSTSCALER.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerTwo.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define TEST_CALLS                                  8u
+/* interrupt latency and the truncation of getPostscalerError() to microseconds */
+#define TEST_MAX_DEVIATION                          32
+/* the first hardware period is up to two timer ticks shorter, the prescaler is not reset and the compare match of
+   the first period is one tick before the counter is cleared */
+#define TEST_MAX_START_DEVIATION                    (2u * TIMERTWO_MAX_PRESCALER + TEST_MAX_DEVIATION)
+#define TEST_HARDWARE_PERIOD                        TIMERTWO_POSTSCALER_PERIOD_CYCLES
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA
+ *****************************************************************************************************************************************************/
+static unsigned int Calls;
+static uint64_t CallCycles[TEST_CALLS + 1u];
+/* error of the next call in cpu cycles, reported after each call */
+static long Errors[TEST_CALLS + 1u];
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+static void callback()
+{
+    long Error;
+
+    if(Calls < TEST_CALLS) {
+        Calls++;
+        CallCycles[Calls] = AvrSim::getCycles();
+        Timer2.getPostscalerError(&Error);
+        Errors[Calls] = Error * (long) (F_CPU / 1000000uL);
+    }
+}
+
+static void testPeriod(unsigned long Microseconds)
+{
+    const AvrSim::StatisticType& Interrupt = AvrSim::getStatistic(AvrSim::VECTOR_TIMER2_COMPA);
+    uint64_t Period = (uint64_t) Microseconds * (F_CPU / 1000000uL);
+    long Error;
+    long Deviation;
+    uint64_t Distance;
+
+    Calls = 0u;
+    AVRSIM_CHECK(E_OK == Timer2.setPeriod(Microseconds));
+    Timer2.getPostscalerError(&Error);
+    Errors[0] = Error * (long) (F_CPU / 1000000uL);
+    noInterrupts();
+    AVRSIM_CHECK(E_OK == Timer2.start());
+    CallCycles[0] = AvrSim::getCycles();
+    AvrSim::clearStatistics();
+    interrupts();
+    /* longest hardware period */
+    AVRSIM_CHECK((255u == OCR2A.Value) && (TIMERTWO_REG_CS_GM == (TCCR2B.Value & TIMERTWO_REG_CS_GM)));
+    delay((TEST_CALLS * Microseconds) / 1000u + 20u);
+    Timer2.stop();
+
+    printf("period %6lu us, %u calls, %3lu interrupts, early by", Microseconds, Calls, (unsigned long) Interrupt.Count);
+    AVRSIM_CHECK(TEST_CALLS == Calls);
+    /* the first call includes the remainder */
+    Deviation = (long) Period - (long) (CallCycles[1] - CallCycles[0]);
+    printf(" %ld", Deviation);
+    AVRSIM_CHECK((Deviation >= Errors[0] - TEST_MAX_DEVIATION) && (Deviation <= Errors[0] + TEST_MAX_START_DEVIATION));
+    for(unsigned int Call = 2u; Call <= Calls; Call++) {
+        /* positive if the call is early */
+        Deviation = (long) ((Call - 1u) * Period) - (long) (CallCycles[Call] - CallCycles[1]) + Errors[0];
+        Distance = CallCycles[Call] - CallCycles[Call - 1u];
+        printf(" %ld", Deviation);
+        AVRSIM_CHECK((Deviation >= Errors[Call - 1u] - TEST_MAX_DEVIATION) && (Deviation <= Errors[Call - 1u] + TEST_MAX_DEVIATION));
+        /* whole number of hardware periods */
+        AVRSIM_CHECK((Distance + TEST_MAX_DEVIATION) % TEST_HARDWARE_PERIOD <= 2u * TEST_MAX_DEVIATION);
+    }
+    for(unsigned int Call = 0u; Call <= Calls; Call++) {
+        AVRSIM_CHECK((Errors[Call] >= -(long) (TEST_HARDWARE_PERIOD / 2u)) && (Errors[Call] < (long) (TEST_HARDWARE_PERIOD / 2u)));
+    }
+    printf(" cycles\n");
+    /* one compare interrupt per hardware period, the interrupts after the last call are not counted */
+    AVRSIM_CHECK(Interrupt.Count >= (CallCycles[Calls] - CallCycles[0] + TEST_MAX_START_DEVIATION) / TEST_HARDWARE_PERIOD);
+    AVRSIM_CHECK(Interrupt.Count <= (AvrSim::getCycles() - CallCycles[0] + TEST_MAX_START_DEVIATION) / TEST_HARDWARE_PERIOD);
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    long Error;
+
+    AVRSIM_CHECK(E_OK == Timer2.init(1000, callback));
+    /* hardware period, no error */
+    AVRSIM_CHECK(E_OK == Timer2.setPeriod(16000u));
+    Timer2.getPostscalerError(&Error);
+    AVRSIM_CHECK(0 == Error);
+    /* remainder below half a hardware period, the first call is early */
+    testPeriod(55000u);
+    /* remainder above half a hardware period, the first call is late */
+    testPeriod(60000u);
+    /* many hardware periods */
+    testPeriod(200000u);
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
@@ -0,0 +1,202 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       RtcTest.cpp
+ *      \brief      Test of the real time clock of TimerTwo
+ *
+ *      \details    Timer2 is clocked by the simulated 32.768 kHz crystal. initRtc() has to return with all update busy
+ *                  flags in ASSR cleared, a register write has to set its flag until the next crystal edge.
+ *                  sleepUntil() has to wake up at the deadline, not before and at most one tick later, for deadlines
+ *                  within the current second, across seconds and in the past. setDateTime(), getDateTime() and setTime()
+ *                  are checked against known epochs, the time has to advance once per second with the callback.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerTwo.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define TEST_CYCLES_PER_TICK                        (F_CPU / TIMERTWO_RTC_TICK_FREQUENCY)
+#define TEST_CYCLES_PER_CRYSTAL_CYCLE               (F_CPU / TIMERTWO_RTC_CRYSTAL_FREQUENCY + 1u)
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA TYPES AND STRUCTURES
+ *****************************************************************************************************************************************************/
+/* calendar date and time with its seconds since 1970 */
+struct EpochType {
+    TimerTwoDateTimeType DateTime;
+    unsigned long Seconds;
+};
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA
+ *****************************************************************************************************************************************************/
+static const EpochType Epochs[] = {
+    { { 1970u,  1u,  1u,  0u,  0u,  0u, 4u },          0uL },
+    { { 2000u,  2u, 29u, 12u, 34u, 56u, 2u },  951827696uL },
+    { { 2024u, 12u, 31u, 23u, 59u, 59u, 2u }, 1735689599uL },
+    { { 2038u,  1u, 19u,  3u, 14u,  7u, 2u }, 2147483647uL },
+    { { 2100u,  3u,  1u,  0u,  0u,  0u, 1u }, 4107542400uL },
+    { { 2105u, 12u, 31u, 23u, 59u, 59u, 4u }, 4291747199uL }
+};
+
+static volatile unsigned long Seconds = 0u;
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+static void second()
+{
+    Seconds++;
+}
+
+static bool isDateTime(const TimerTwoDateTimeType& DateTime, const TimerTwoDateTimeType& Expected)
+{
+    return (DateTime.Year == Expected.Year) && (DateTime.Month == Expected.Month) && (DateTime.Day == Expected.Day) &&
+           (DateTime.Hour == Expected.Hour) && (DateTime.Minute == Expected.Minute) && (DateTime.Second == Expected.Second) &&
+           (DateTime.Weekday == Expected.Weekday);
+}
+
+/* every register of the asynchronous clock domain is busy until the next crystal edge */
+static void testBusyFlags()
+{
+    const byte Flags[] = { 1u << TCN2UB, 1u << OCR2AUB, 1u << OCR2BUB, 1u << TCR2AUB, 1u << TCR2BUB };
+    uint64_t Start;
+
+    AVRSIM_CHECK(0u == (ASSR.Value & TIMERTWO_RTC_BUSY_MASK));
+    AVRSIM_CHECK(TIMERTWO_REG_CS_PRESCALE_128 == (TCCR2B.Value & TIMERTWO_REG_CS_GM));
+    for(byte Index = 0u; Index < sizeof(Flags) / sizeof(Flags[0]); Index++) {
+        /* the registers are written with their own values */
+        switch(Index) {
+            case 0u: TCNT2 = TCNT2.Value; break;
+            case 1u: OCR2A = OCR2A.Value; break;
+            case 2u: OCR2B = OCR2B.Value; break;
+            case 3u: TCCR2A = TCCR2A.Value; break;
+            default: TCCR2B = TCCR2B.Value; break;
+        }
+        AVRSIM_CHECK(Flags[Index] == (ASSR.Value & TIMERTWO_RTC_BUSY_MASK));
+        Start = AvrSim::getCycles();
+        while((ASSR.Value & Flags[Index]) && (AvrSim::getCycles() - Start <= TEST_CYCLES_PER_CRYSTAL_CYCLE)) AvrSim::run(1u);
+        AVRSIM_CHECK(0u == (ASSR.Value & TIMERTWO_RTC_BUSY_MASK));
+    }
+}
+
+static void testSleep(long Ticks)
+{
+    unsigned long Start = Timer2.getRtcTicks();
+    unsigned long Deadline = Start + Ticks;
+    uint64_t Cycles = AvrSim::getCycles();
+    unsigned long Woken;
+
+    AVRSIM_CHECK(E_OK == Timer2.sleepUntil(Deadline));
+    Woken = Timer2.getRtcTicks();
+    Cycles = AvrSim::getCycles() - Cycles;
+    printf("sleep %5ld ticks: woken at %+ld ticks after %8llu cycles\n", Ticks, (long) (Woken - Deadline), (unsigned long long) Cycles);
+    if(Ticks <= 0) {
+        AVRSIM_CHECK(Cycles < TEST_CYCLES_PER_TICK);
+    } else {
+        AVRSIM_CHECK((long) (Woken - Deadline) >= 0);
+        AVRSIM_CHECK((long) (Woken - Deadline) <= 1);
+        AVRSIM_CHECK(Cycles + TEST_CYCLES_PER_TICK >= (uint64_t) Ticks * TEST_CYCLES_PER_TICK);
+        AVRSIM_CHECK(Cycles <= (uint64_t) (Ticks + 1) * TEST_CYCLES_PER_TICK);
+    }
+    /* the compare interrupt only wakes up the last second of a sleep */
+    AVRSIM_CHECK(0u == (TIMSK2.Value & (1u << OCIE2A)));
+}
+
+static void testEpochs()
+{
+    TimerTwoDateTimeType DateTime;
+    TimerTwoDateTimeType Invalid;
+    unsigned long Time;
+
+    for(byte Index = 0u; Index < sizeof(Epochs) / sizeof(Epochs[0]); Index++) {
+        AVRSIM_CHECK(E_OK == Timer2.setDateTime(&Epochs[Index].DateTime));
+        Time = Timer2.getTime();
+        Timer2.setTime(Epochs[Index].Seconds);
+        Timer2.getDateTime(&DateTime);
+        printf("%04u-%02u-%02u %02u:%02u:%02u weekday %u: %10lu s\n", DateTime.Year, DateTime.Month, DateTime.Day, DateTime.Hour,
+               DateTime.Minute, DateTime.Second, DateTime.Weekday, Time);
+        AVRSIM_CHECK(Epochs[Index].Seconds == Time);
+        AVRSIM_CHECK(isDateTime(DateTime, Epochs[Index].DateTime));
+    }
+    /* out of range, the time is kept */
+    Time = Timer2.getTime();
+    for(byte Index = 0u; Index < 6u; Index++) {
+        Invalid = Epochs[1].DateTime;
+        switch(Index) {
+            case 0u: Invalid.Year = 1969u; break;
+            case 1u: Invalid.Year = 2106u; break;
+            case 2u: Invalid.Month = 13u; break;
+            case 3u: Invalid.Day = 0u; break;
+            case 4u: Invalid.Hour = 24u; break;
+            default: Invalid.Second = 60u; break;
+        }
+        AVRSIM_CHECK(E_NOT_OK == Timer2.setDateTime(&Invalid));
+        AVRSIM_CHECK(Time == Timer2.getTime());
+    }
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    unsigned long Time;
+    unsigned long Calls;
+
+    AVRSIM_CHECK(E_OK == Timer2.initRtc(second));
+    AVRSIM_CHECK(Timer2.isRtcRunning());
+    /* Timer2 is used by the real time clock */
+    AVRSIM_CHECK(E_NOT_OK == Timer2.initRtc(second));
+    AVRSIM_CHECK(E_NOT_OK == Timer2.init(1000u));
+    testBusyFlags();
+
+    testSleep(1);
+    testSleep(2);
+    testSleep(10);
+    testSleep(200);
+    testSleep(TIMERTWO_RTC_TICK_FREQUENCY);
+    testSleep(300);
+    testSleep(0);
+    testSleep(-10);
+
+    testEpochs();
+
+    /* the time advances with every overflow, together with the callback */
+    Timer2.setTime(Epochs[3].Seconds);
+    Time = Timer2.getTime();
+    Calls = Seconds;
+    AVRSIM_CHECK(E_OK == Timer2.sleepUntil(Timer2.getRtcTicks() + 2u * TIMERTWO_RTC_TICK_FREQUENCY));
+    printf("2 seconds: time %+ld s, %lu callbacks\n", (long) (Timer2.getTime() - Time), Seconds - Calls);
+    AVRSIM_CHECK(Time + 2u == Timer2.getTime());
+    AVRSIM_CHECK(Calls + 2u == Seconds);
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
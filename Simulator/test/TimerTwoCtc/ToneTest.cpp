@@ -0,0 +1,211 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       ToneTest.cpp
+ *      \brief      Test of the TimerTwo tone on OC2A (pin 11) and its duration counted by Timer1
+ *
+ *      \details    The period of the square wave is measured between rising edges of the pin, it has to be two compare
+ *                  periods and near the requested frequency. A tone without duration must not touch Timer1. A tone with
+ *                  duration takes Timer1 over in normal mode with prescaler 1024 and stops it with the tone. After the
+ *                  tone the pin stays low and the timer runs with its period again. The Makefile builds the TimerTwoCtc
+ *                  tests with TIMERTWO_TONE and TIMERTWO_TONE_DURATION.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerTwo.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define TEST_PERIOD_MICROSECONDS                    1000u
+#define TEST_PERIODS                                3u
+/* Timer1 control registers of someone else, mode 1 without clock */
+#define TEST_OTHER_TCCR1A                           (1u << WGM10)
+#define TEST_OTHER_TCCR1B                           0u
+/* the prescaler of Timer1 is not reset, the first tick comes up to a prescaler period early */
+#define TEST_MAX_EARLY_CYCLES                       1024u
+/* latency of the overflow interrupt and the step of the stop detection */
+#define TEST_MAX_LATE_CYCLES                        64u
+#define TEST_STEP_CYCLES                            16u
+#define TEST_TIMER1_CS_GM                           ((1u << CS12) | (1u << CS11) | (1u << CS10))
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA
+ *****************************************************************************************************************************************************/
+static const uint16_t Prescalers[8] = { 0u, 1u, 8u, 32u, 64u, 128u, 256u, 1024u };
+
+static volatile unsigned int Calls = 0u;
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+static void compare()
+{
+    Calls++;
+}
+
+static void setOtherTimer1()
+{
+    TCCR1A = TEST_OTHER_TCCR1A;
+    TCCR1B = TEST_OTHER_TCCR1B;
+}
+
+static bool isOtherTimer1()
+{
+    return (TEST_OTHER_TCCR1A == TCCR1A.Value) && (TEST_OTHER_TCCR1B == TCCR1B.Value) && (0u == (TIMSK1.Value & (1u << TOIE1)));
+}
+
+/* cycles from the next rising edge of the pin to the one after Periods periods */
+static uint64_t measurePeriods(unsigned int Periods, uint64_t MaxCycles)
+{
+    uint64_t Timeout = AvrSim::getCycles() + MaxCycles;
+    uint64_t First = 0u;
+    uint8_t Last = AvrSim::readPin(TIMERTWO_TONE_PIN);
+    uint8_t Level;
+    unsigned int Edges = 0u;
+
+    while((Edges <= Periods) && (AvrSim::getCycles() < Timeout)) {
+        AvrSim::run(1u);
+        Level = AvrSim::readPin(TIMERTWO_TONE_PIN);
+        if((LOW == Last) && (HIGH == Level)) {
+            if(0u == Edges) First = AvrSim::getCycles();
+            Edges++;
+        }
+        Last = Level;
+    }
+    AVRSIM_CHECK(Edges > Periods);
+    return AvrSim::getCycles() - First;
+}
+
+static void testFrequency(unsigned int Frequency)
+{
+    uint32_t Tick;
+    uint32_t Period;
+    uint64_t Measured;
+
+    setOtherTimer1();
+    AVRSIM_CHECK(E_OK == Timer2.tone(Frequency));
+    AVRSIM_CHECK(Timer2.isTonePlaying());
+    Tick = Prescalers[TCCR2B.Value & TIMERTWO_REG_CS_GM];
+    Period = 2u * (OCR2A.Value + 1u) * Tick;
+    Measured = measurePeriods(TEST_PERIODS, (TEST_PERIODS + 2u) * Period);
+    printf("tone %7u Hz: prescaler %4u, OCR2A %3u, period %6lu cycles, %10.3f Hz\n", Frequency, (unsigned int) Tick, (unsigned int) OCR2A.Value,
+           (unsigned long) (Measured / TEST_PERIODS), (double) F_CPU * TEST_PERIODS / (double) Measured);
+    AVRSIM_CHECK(TEST_PERIODS * Period == Measured);
+    /* each half period is rounded to a timer tick */
+    AVRSIM_CHECK((Period * Frequency + 2u * Tick * Frequency >= F_CPU) && (Period * Frequency <= F_CPU + 2u * Tick * Frequency));
+    /* Timer1 is not needed without duration */
+    AVRSIM_CHECK(isOtherTimer1());
+}
+
+/* the tone stops itself after Milliseconds */
+static void testDuration(unsigned long Milliseconds)
+{
+    const AvrSim::StatisticType& Overflow = AvrSim::getStatistic(AvrSim::VECTOR_TIMER1_OVF);
+    unsigned long Ticks = (Milliseconds * (TIMERTWO_TONE_TICK_FREQUENCY / 125u)) / 8u;
+    uint64_t Expected = (uint64_t) Ticks * (F_CPU / TIMERTWO_TONE_TICK_FREQUENCY);
+    uint64_t Start;
+    uint64_t Duration;
+    uint64_t Timeout;
+
+    setOtherTimer1();
+    noInterrupts();
+    AVRSIM_CHECK(E_OK == Timer2.tone(1000u, Milliseconds));
+    Start = AvrSim::getCycles();
+    AvrSim::clearStatistics();
+    interrupts();
+    /* Timer1 in normal mode with prescaler 1024 and overflow interrupt */
+    AVRSIM_CHECK((0u == TCCR1A.Value) && (((1u << CS12) | (1u << CS10)) == TCCR1B.Value) && (0u != (TIMSK1.Value & (1u << TOIE1))));
+    /* the timer can not be started while the tone plays */
+    AVRSIM_CHECK(E_NOT_OK == Timer2.start());
+    Timeout = Start + Expected + TEST_MAX_EARLY_CYCLES;
+    while(Timer2.isTonePlaying() && (AvrSim::getCycles() < Timeout)) AvrSim::run(TEST_STEP_CYCLES);
+    Duration = AvrSim::getCycles() - Start;
+    printf("duration %4lu ms: %6lu Timer1 ticks, %2lu overflows, stopped after %9lu of %9lu cycles\n", Milliseconds, Ticks,
+           (unsigned long) Overflow.Count, (unsigned long) Duration, (unsigned long) Expected);
+    AVRSIM_CHECK(!Timer2.isTonePlaying());
+    AVRSIM_CHECK((Duration + TEST_MAX_EARLY_CYCLES >= Expected) && (Duration <= Expected + TEST_MAX_LATE_CYCLES));
+    /* one overflow for each started 2^16 ticks */
+    AVRSIM_CHECK((Ticks + 0xFFFFu) / 0x10000u == Overflow.Count);
+    /* Timer1 is stopped with the tone, the pin is low and does not toggle any more */
+    AVRSIM_CHECK((0u == (TCCR1B.Value & TEST_TIMER1_CS_GM)) && (0u == (TIMSK1.Value & (1u << TOIE1))));
+    AVRSIM_CHECK(0u == (TCCR2A.Value & ((1u << COM2A1) | (1u << COM2A0))));
+    for(unsigned int Cycle = 0u; Cycle < 2u * F_CPU / 1000u; Cycle++) {
+        AvrSim::run(1u);
+        AVRSIM_CHECK(LOW == AvrSim::readPin(TIMERTWO_TONE_PIN));
+    }
+    AVRSIM_CHECK(Overflow.Count == (Ticks + 0xFFFFu) / 0x10000u);
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    const AvrSim::StatisticType& Overflow = AvrSim::getStatistic(AvrSim::VECTOR_TIMER1_OVF);
+    byte Top;
+
+    AVRSIM_CHECK(E_OK == Timer2.init(TEST_PERIOD_MICROSECONDS, compare));
+    Top = OCR2A.Value;
+    /* below F_CPU / 2^19 and above F_CPU / 2 */
+    AVRSIM_CHECK(E_NOT_OK == Timer2.tone(30u));
+    AVRSIM_CHECK(E_NOT_OK == Timer2.tone(F_CPU / 2u + 1u));
+    AVRSIM_CHECK(!Timer2.isTonePlaying());
+
+    /* a playing tone is changed at once */
+    testFrequency(31u);
+    testFrequency(440u);
+    testFrequency(1000u);
+    testFrequency(3000u);
+    testFrequency(38000u);
+    testFrequency(F_CPU / 2u);
+    Timer2.noTone();
+    AVRSIM_CHECK(!Timer2.isTonePlaying() && (LOW == AvrSim::readPin(TIMERTWO_TONE_PIN)) && (Top == OCR2A.Value));
+
+    /* within the first overflow and more than 2^16 ticks */
+    testDuration(50u);
+    testDuration(1000u);
+    testDuration(4500u);
+    AVRSIM_CHECK(Top == OCR2A.Value);
+
+    /* noTone() stops Timer1 of a tone with duration */
+    AVRSIM_CHECK(E_OK == Timer2.tone(440u, 1000u));
+    delay(10u);
+    Timer2.noTone();
+    AvrSim::clearStatistics();
+    AVRSIM_CHECK((0u == (TCCR1B.Value & TEST_TIMER1_CS_GM)) && (0u == (TIMSK1.Value & (1u << TOIE1))));
+    delay(1000u);
+    AVRSIM_CHECK(0u == Overflow.Count);
+
+    /* the timer runs with its period after the tone */
+    AVRSIM_CHECK(E_OK == Timer2.start());
+    delay(10u * TEST_PERIOD_MICROSECONDS / 1000u);
+    AVRSIM_CHECK((Calls >= 9u) && (Calls <= 10u));
+    AVRSIM_CHECK(E_NOT_OK == Timer2.tone(440u));
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
@@ -0,0 +1,207 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       EventQueueTest.cpp
+ *      \brief      Test of the deferred overflow callback of TimerTwo by the TimerEventQueue
+ *
+ *      \details    The overflow interrupt only posts the callback. Without process() the events of one callback are
+ *                  coalesced, so the callback is executed at most twice for any number of interrupts. An interrupt
+ *                  which finds the queue full of other events counts an overrun. With yield() every event is processed
+ *                  while delay() waits. The Makefile builds this test with TIMERTWO_DEFERRED_CALLBACK and
+ *                  TIMEREVENTQUEUE_YIELD.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerTwo.h>
+#include <stdio.h>
+#include <string.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define TEST_PERIOD_MICROSECONDS                    1000u
+#define TEST_PERIOD_CYCLES                          (TEST_PERIOD_MICROSECONDS * (F_CPU / 1000000uL))
+#define TEST_PERIODS                                10u
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA
+ *****************************************************************************************************************************************************/
+static unsigned int Overflows = 0u;
+static unsigned int Events = 0u;
+/* order of the executed events, 'O' for the overflow callback */
+static char Trace[2u * TIMEREVENTQUEUE_SIZE + 1u];
+static byte TraceLength = 0u;
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+static void trace(char Event)
+{
+    if(TraceLength < sizeof(Trace) - 1u) Trace[TraceLength++] = Event;
+    Trace[TraceLength] = '\0';
+}
+
+static void overflow()
+{
+    Overflows++;
+    trace('O');
+}
+
+static void eventA()
+{
+    Events++;
+    trace('A');
+}
+
+static void eventB()
+{
+    Events++;
+    trace('B');
+}
+
+static void clear()
+{
+    EventQueue.process();
+    EventQueue.clearStatistic();
+    Overflows = 0u;
+    Events = 0u;
+    TraceLength = 0u;
+    Trace[0] = '\0';
+}
+
+static void print(const char* Name)
+{
+    TimerEventQueue::StatisticType Statistic = EventQueue.getStatistic();
+
+    printf("%-10s %2u overflows, %2u events, %2u coalesced, %u overruns, max fill %u, executed %s\n", Name, Overflows, Events,
+           Statistic.Coalesced, Statistic.Overruns, Statistic.MaxFill, Trace);
+}
+
+/* events posted like by an interrupt: the event at the tail is not merged, the newest one is */
+static void testCoalesce()
+{
+    TimerEventQueue::StatisticType Statistic;
+
+    clear();
+    noInterrupts();
+    EventQueue.post(eventA);
+    EventQueue.post(eventA);
+    EventQueue.post(eventA);
+    EventQueue.post(eventB);
+    EventQueue.post(eventB);
+    EventQueue.post(eventA);
+    interrupts();
+    Statistic = EventQueue.getStatistic();
+    AVRSIM_CHECK(4u == EventQueue.getFill());
+    AVRSIM_CHECK((2u == Statistic.Coalesced) && (0u == Statistic.Overruns) && (4u == Statistic.MaxFill));
+    EventQueue.process();
+    print("coalesce");
+    AVRSIM_CHECK(0 == strcmp("AABA", Trace));
+    AVRSIM_CHECK(0u == EventQueue.getFill());
+}
+
+/* the overflow interrupt posts without process(), its events are coalesced */
+static void testInterrupts()
+{
+    const AvrSim::StatisticType& Interrupt = AvrSim::getStatistic(AvrSim::VECTOR_TIMER2_OVF);
+    TimerEventQueue::StatisticType Statistic;
+
+    noInterrupts();
+    clear();
+    AvrSim::clearStatistics();
+    interrupts();
+    AvrSim::run(TEST_PERIODS * TEST_PERIOD_CYCLES);
+    Statistic = EventQueue.getStatistic();
+    AVRSIM_CHECK(0u == Overflows);
+    AVRSIM_CHECK(Interrupt.Count >= TEST_PERIODS - 1u);
+    AVRSIM_CHECK(2u == EventQueue.getFill());
+    AVRSIM_CHECK((Interrupt.Count - 2u == Statistic.Coalesced) && (0u == Statistic.Overruns) && (2u == Statistic.MaxFill));
+    EventQueue.process();
+    print("interrupt");
+    AVRSIM_CHECK(2u == Overflows);
+}
+
+/* the queue is full of other events when the overflow interrupt posts */
+static void testOverrun()
+{
+    TimerEventQueue::StatisticType Statistic;
+
+    clear();
+    noInterrupts();
+    for(byte Event = 0u; Event < TIMEREVENTQUEUE_SIZE; Event++) EventQueue.post((Event & 1u) ? eventB : eventA);
+    AVRSIM_CHECK(TIMEREVENTQUEUE_SIZE == EventQueue.getFill());
+    /* one overflow interrupt */
+    TIFR2 = (1u << TOV2);
+    while(0u == (TIFR2.Value & (1u << TOV2))) AvrSim::run(1u);
+    interrupts();
+    AvrSim::run(1u);
+    Statistic = EventQueue.getStatistic();
+    AVRSIM_CHECK((0u == Statistic.Coalesced) && (1u == Statistic.Overruns) && (TIMEREVENTQUEUE_SIZE == Statistic.MaxFill));
+    /* a direct post of the newest callback is still merged into the full queue */
+    noInterrupts();
+    EventQueue.post(eventB);
+    interrupts();
+    Statistic = EventQueue.getStatistic();
+    AVRSIM_CHECK((1u == Statistic.Coalesced) && (1u == Statistic.Overruns));
+    EventQueue.process();
+    print("overrun");
+    AVRSIM_CHECK((0u == Overflows) && (TIMEREVENTQUEUE_SIZE == Events));
+    AVRSIM_CHECK(0 == strcmp("ABABABAB", Trace));
+}
+
+/* delay() calls yield(), which processes every event before the next interrupt */
+static void testYield()
+{
+    const AvrSim::StatisticType& Interrupt = AvrSim::getStatistic(AvrSim::VECTOR_TIMER2_OVF);
+    TimerEventQueue::StatisticType Statistic;
+
+    noInterrupts();
+    clear();
+    AvrSim::clearStatistics();
+    interrupts();
+    delay(TEST_PERIODS * TEST_PERIOD_MICROSECONDS / 1000u);
+    yield();
+    Statistic = EventQueue.getStatistic();
+    print("yield");
+    AVRSIM_CHECK(Interrupt.Count == Overflows);
+    AVRSIM_CHECK(Overflows >= TEST_PERIODS - 1u);
+    AVRSIM_CHECK((0u == Statistic.Coalesced) && (0u == Statistic.Overruns) && (1u == Statistic.MaxFill));
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    testCoalesce();
+    AVRSIM_CHECK(E_OK == Timer2.init(TEST_PERIOD_MICROSECONDS, overflow));
+    AVRSIM_CHECK(E_OK == Timer2.start());
+    testInterrupts();
+    testOverrun();
+    testYield();
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
@@ -0,0 +1,18 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       FastFixedTopPwmTest.cpp
+ *      \brief      FixedTopPwmTest in fast pwm mode 3
+ *
+ *      \details
+ *
+ *****************************************************************************************************************************************************/
+#define TEST_MODE                                   TimerTwo::MODE_FAST_PWM_FIXED_TOP
+#include "FixedTopPwmTest.cpp"
@@ -0,0 +1,117 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       FixedTopPwmTest.cpp
+ *      \brief      Test of the duty cycles of OC2A (pin 11) and OC2B (pin 3) in phase correct pwm mode 1 with TOP 0xFF
+ *
+ *      \details    Both pins are read every cycle over whole pwm periods. Each pin has to be high for the ticks of its
+ *                  own duty cycle, independent of the other pin: in mode 1 for 2 * duty of 510 ticks, in mode 3 for
+ *                  duty + 1 of 256 ticks, with duty 0 continuously low in mode 1 and duty 255 continuously high.
+ *                  FastFixedTopPwmTest is the same test in fast pwm mode 3.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerTwo.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#ifndef TEST_MODE
+# define TEST_MODE                                  TimerTwo::MODE_PHASE_CORRECT_FIXED_TOP
+#endif
+/* prescaler 8 in both modes */
+#define TEST_PERIOD_MICROSECONDS                    100u
+#define TEST_PERIODS                                4u
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA
+ *****************************************************************************************************************************************************/
+static const uint16_t Prescalers[8] = { 0u, 1u, 8u, 32u, 64u, 128u, 256u, 1024u };
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+/* ticks of a pwm period */
+static uint32_t getPeriodTicks()
+{
+    return (TimerTwo::MODE_PHASE_CORRECT_FIXED_TOP == TEST_MODE) ? (2u * TIMERTWO_FIXED_TOP) : (TIMERTWO_FIXED_TOP + 1u);
+}
+
+/* ticks the non-inverting output is high in a pwm period */
+static uint32_t getHighTicks(byte DutyCycle)
+{
+    if(TimerTwo::MODE_PHASE_CORRECT_FIXED_TOP == TEST_MODE) return 2u * DutyCycle;
+    else return (TIMERTWO_FIXED_TOP == DutyCycle) ? (TIMERTWO_FIXED_TOP + 1u) : (DutyCycle + 1u);
+}
+
+static void testDuty(byte DutyCycleA, byte DutyCycleB)
+{
+    uint32_t Tick = Prescalers[TCCR2B.Value & TIMERTWO_REG_CS_GM];
+    uint32_t Period = getPeriodTicks() * Tick;
+    uint32_t HighA = 0u;
+    uint32_t HighB = 0u;
+
+    AVRSIM_CHECK(E_OK == Timer2.setPwmDuty(TimerTwo::PWM_PIN_11, DutyCycleA));
+    AVRSIM_CHECK(E_OK == Timer2.setPwmDuty(TimerTwo::PWM_PIN_3, DutyCycleB));
+    AVRSIM_CHECK((DutyCycleA == OCR2A.Buffer) && (DutyCycleB == OCR2B.Buffer));
+    /* compare buffers are taken over at TOP or BOTTOM */
+    AvrSim::run(2u * Period);
+    for(uint32_t Cycle = 0u; Cycle < TEST_PERIODS * Period; Cycle++) {
+        AvrSim::run(1u);
+        if(HIGH == AvrSim::readPin(TimerTwo::PWM_PIN_11)) HighA++;
+        if(HIGH == AvrSim::readPin(TimerTwo::PWM_PIN_3)) HighB++;
+    }
+    printf("duty %3u / %3u: high %4lu / %4lu of %4lu ticks\n", DutyCycleA, DutyCycleB, (unsigned long) (HighA / (TEST_PERIODS * Tick)),
+           (unsigned long) (HighB / (TEST_PERIODS * Tick)), (unsigned long) getPeriodTicks());
+    AVRSIM_CHECK(TEST_PERIODS * getHighTicks(DutyCycleA) * Tick == HighA);
+    AVRSIM_CHECK(TEST_PERIODS * getHighTicks(DutyCycleB) * Tick == HighB);
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    AVRSIM_CHECK(E_OK == Timer2.init(TEST_PERIOD_MICROSECONDS, nullptr, TEST_MODE));
+    AVRSIM_CHECK(Timer2.hasCapability(TimerTwo::CAPABILITY_PWM_PIN_3) && Timer2.hasCapability(TimerTwo::CAPABILITY_PWM_PIN_11));
+    AVRSIM_CHECK(!Timer2.hasCapability(TimerTwo::CAPABILITY_EXACT_PERIOD));
+    AVRSIM_CHECK(E_OK == Timer2.enablePwm(TimerTwo::PWM_PIN_11, 0u));
+    AVRSIM_CHECK(E_OK == Timer2.enablePwm(TimerTwo::PWM_PIN_3, 0u));
+    AVRSIM_CHECK(E_OK == Timer2.start());
+    /* TOP is not changed by the period, the period is rounded up to the prescaler */
+    AVRSIM_CHECK(8u == Prescalers[TCCR2B.Value & TIMERTWO_REG_CS_GM]);
+
+    testDuty(64u, 192u);
+    testDuty(192u, 64u);
+    testDuty(128u, 128u);
+    testDuty(1u, 254u);
+    testDuty(0u, 255u);
+    testDuty(255u, 0u);
+    testDuty(10u, 10u);
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
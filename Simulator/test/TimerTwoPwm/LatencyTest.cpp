@@ -0,0 +1,143 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       LatencyTest.cpp
+ *      \brief      Test of the latency histogram of the TimerTwo overflow interrupt
+ *
+ *      \details    Without delay every overflow interrupt is entered within a few ticks after BOTTOM. Then the interrupts
+ *                  are disabled for a known number of cycles after BOTTOM, the latency of this interrupt has to be the
+ *                  delay plus at least the undisturbed latency and has to be counted in the bin of its power of two.
+ *                  The dump has to hold count, minimum, maximum, mean and bins as 16 bit little endian values.
+ *                  The Makefile builds this test with TIMERTWO_LATENCY_HISTOGRAM.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerTwo.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+/* prescaler 1 and TOP 160, so a timer tick is a cycle and the counter counts up for 160 cycles after BOTTOM */
+#define TEST_PERIOD_MICROSECONDS                    20u
+#define TEST_MILLISECONDS                           1u
+/* interrupt entry and the read of TCNT2, after a delay also the end of the critical section */
+#define TEST_MAX_LATENCY                            16u
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+static void overflow()
+{
+
+}
+
+static void print(const char* Name, const LatencyHistogram& Latency)
+{
+    printf("%-14s count %3u  min %4u  max %4u  mean %4u  bins", Name, Latency.getCount(), Latency.getMinimum(), Latency.getMaximum(),
+           Latency.getMean());
+    for(byte Bin = 0u; Bin < LATENCYHISTOGRAM_NUMBER_OF_BINS; Bin++) printf(" %u", Latency.getBin(Bin));
+    printf("\n");
+}
+
+/* bin of a latency, bin n counts latencies from 2^(n-1) to 2^n - 1 */
+static byte getBin(uint16_t Latency)
+{
+    byte Bin = 0u;
+
+    while((Latency != 0u) && (Bin < LATENCYHISTOGRAM_NUMBER_OF_BINS - 1u)) {
+        Latency >>= 1u;
+        Bin++;
+    }
+    return Bin;
+}
+
+/* overflow interrupt held off by a critical section of Cycles after BOTTOM */
+static void testDelay(unsigned int Cycles, uint16_t Undisturbed)
+{
+    LatencyHistogram Latency;
+
+    noInterrupts();
+    Timer2.clearLatency();
+    TIFR2 = (1u << TOV2);
+    while(0u == (TIFR2.Value & (1u << TOV2))) AvrSim::run(1u);
+    AvrSim::run(Cycles);
+    interrupts();
+    Timer2.getLatency(Latency);
+    print("delay", Latency);
+    AVRSIM_CHECK(1u == Latency.getCount());
+    AVRSIM_CHECK(Latency.getMinimum() == Latency.getMaximum());
+    AVRSIM_CHECK((Latency.getMaximum() >= Cycles + Undisturbed) && (Latency.getMaximum() <= Cycles + TEST_MAX_LATENCY));
+    AVRSIM_CHECK(1u == Latency.getBin(getBin(Latency.getMaximum())));
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    const AvrSim::StatisticType& Interrupt = AvrSim::getStatistic(AvrSim::VECTOR_TIMER2_OVF);
+    LatencyHistogram Latency;
+    byte Dump[LATENCYHISTOGRAM_DUMP_SIZE];
+    uint16_t Undisturbed;
+    uint16_t Sum = 0u;
+
+    AVRSIM_CHECK(E_OK == Timer2.init(TEST_PERIOD_MICROSECONDS, overflow));
+    AVRSIM_CHECK(E_OK == Timer2.start());
+    /* first interrupt after start */
+    delay(1u);
+    noInterrupts();
+    Timer2.clearLatency();
+    AvrSim::clearStatistics();
+    interrupts();
+    delay(TEST_MILLISECONDS);
+    Timer2.getLatency(Latency);
+    print("undisturbed", Latency);
+    Undisturbed = Latency.getMinimum();
+    AVRSIM_CHECK(Interrupt.Count == Latency.getCount());
+    AVRSIM_CHECK(Latency.getMaximum() <= TEST_MAX_LATENCY);
+    for(byte Bin = 0u; Bin < LATENCYHISTOGRAM_NUMBER_OF_BINS; Bin++) Sum += Latency.getBin(Bin);
+    AVRSIM_CHECK(Latency.getCount() == Sum);
+
+    AVRSIM_CHECK(0u == Latency.dump(Dump, sizeof(Dump) - 1u));
+    AVRSIM_CHECK(LATENCYHISTOGRAM_DUMP_SIZE == Latency.dump(Dump, sizeof(Dump)));
+    printf("dump");
+    for(byte Index = 0u; Index < sizeof(Dump); Index++) printf(" %02X", Dump[Index]);
+    printf("\n");
+    AVRSIM_CHECK(Latency.getCount() == (Dump[0] | (Dump[1] << 8u)));
+    AVRSIM_CHECK(Latency.getMinimum() == (Dump[2] | (Dump[3] << 8u)));
+    AVRSIM_CHECK(Latency.getMaximum() == (Dump[4] | (Dump[5] << 8u)));
+    AVRSIM_CHECK(Latency.getMean() == (Dump[6] | (Dump[7] << 8u)));
+    for(byte Bin = 0u; Bin < LATENCYHISTOGRAM_NUMBER_OF_BINS; Bin++) {
+        AVRSIM_CHECK(Latency.getBin(Bin) == (Dump[8u + 2u * Bin] | (Dump[9u + 2u * Bin] << 8u)));
+    }
+
+    testDelay(20u, Undisturbed);
+    testDelay(40u, Undisturbed);
+    testDelay(100u, Undisturbed);
+    testDelay(140u, Undisturbed);
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
@@ -0,0 +1,101 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       PeriodTemplateTest.cpp
+ *      \brief      Test of setPeriod<Microseconds>() against setPeriod(uint32_t)
+ *
+ *      \details    For periods on both sides of every prescaler step, the compile time calculation has to write the
+ *                  same OCR2A and clock select bits as the runtime calculation in phase correct mode 5. The longest period which compiles is
+ *                  the longest one setPeriod() accepts with E_OK. With TEST_COMPILE_ERROR the first period out of
+ *                  bounds is requested, the Makefile checks that it fails to compile with
+ *                  PeriodOutOfBounds.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerTwo.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+/* longest period of the dual slope 8 bit counter with prescaler 1024 */
+#define TEST_MAX_PERIOD                             ((TIMERTWO_RESOLUTION * TIMERTWO_MAX_PRESCALER) / (F_CPU / 2000000uL) - 1u)
+/* period which is set in between, so the registers are written again */
+#define TEST_OTHER_PERIOD                           3u
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+template <uint32_t Microseconds>
+static void testPeriod()
+{
+    byte Top;
+    byte ClockSelect;
+
+    AVRSIM_CHECK(E_OK == Timer2.setPeriod(Microseconds));
+    /* OCR2A is double buffered, the buffer holds the value written */
+    Top = OCR2A.Buffer;
+    ClockSelect = TCCR2B.Value & TIMERTWO_REG_CS_GM;
+    AVRSIM_CHECK(E_OK == Timer2.setPeriod(TEST_OTHER_PERIOD));
+    AVRSIM_CHECK(E_OK == Timer2.setPeriod<Microseconds>());
+    printf("period %5lu us: top %3u, clock select %u\n", (unsigned long) Microseconds, (unsigned int) OCR2A.Buffer, (unsigned int) (TCCR2B.Value & TIMERTWO_REG_CS_GM));
+    AVRSIM_CHECK(Top == OCR2A.Buffer);
+    AVRSIM_CHECK(ClockSelect == (TCCR2B.Value & TIMERTWO_REG_CS_GM));
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    AVRSIM_CHECK(E_OK == Timer2.init(1000u));
+    AVRSIM_CHECK(E_OK == Timer2.start());
+    testPeriod<1uL>();
+    testPeriod<31uL>();
+    /* prescaler 8 */
+    testPeriod<32uL>();
+    testPeriod<255uL>();
+    /* prescaler 32 */
+    testPeriod<256uL>();
+    testPeriod<1023uL>();
+    /* prescaler 64 */
+    testPeriod<1024uL>();
+    testPeriod<2047uL>();
+    /* prescaler 128 */
+    testPeriod<2048uL>();
+    testPeriod<4095uL>();
+    /* prescaler 256 */
+    testPeriod<4096uL>();
+    testPeriod<8191uL>();
+    /* prescaler 1024 */
+    testPeriod<8192uL>();
+    testPeriod<TEST_MAX_PERIOD>();
+    AVRSIM_CHECK(E_NOT_OK == Timer2.setPeriod(TEST_MAX_PERIOD + 1u));
+#ifdef TEST_COMPILE_ERROR
+    Timer2.setPeriod<TEST_MAX_PERIOD + 1u>();
+#endif
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
@@ -0,0 +1,115 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       ProfilerTest.cpp
+ *      \brief      Test of the run time statistic of the TimerTwo overflow callback
+ *
+ *      \details    One call of the callback is kept busy for a known number of cycles: within the period it is only the
+ *                  longest duration, a call which starts late and ends after the next BOTTOM is an overrun, a
+ *                  call longer than the period is an overrun and a missed period. The calls before and after are short.
+ *                  The Makefile builds this test with TIMERTWO_CALLBACK_PROFILER.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerTwo.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+/* prescaler 1 and TOP 160, so a timer tick is a cycle */
+#define TEST_PERIOD_MICROSECONDS                    20u
+#define TEST_PERIOD_CYCLES                          (TEST_PERIOD_MICROSECONDS * (F_CPU / 1000000uL))
+/* reads of TCNT2 and TIFR2 around the callback */
+#define TEST_MAX_OVERHEAD                           16u
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA
+ *****************************************************************************************************************************************************/
+/* cycles of the next call */
+static volatile unsigned long Busy = 0u;
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+static void overflow()
+{
+    unsigned long Cycles = Busy;
+
+    Busy = 0u;
+    AvrSim::run(Cycles);
+}
+
+/* one call of Cycles, which starts Delay cycles after BOTTOM, the counter has to count up at the start */
+static void testCall(unsigned long Delay, unsigned long Cycles, unsigned int Overruns, unsigned int MissedPeriods)
+{
+    TimerTwo::ProfileType Profile;
+
+    noInterrupts();
+    Timer2.clearProfile();
+    TIFR2 = (1u << TOV2);
+    while(0u == (TIFR2.Value & (1u << TOV2))) AvrSim::run(1u);
+    AvrSim::run(Delay);
+    Busy = Cycles;
+    interrupts();
+    /* the late interrupt and two short ones */
+    AvrSim::run(3u * TEST_PERIOD_CYCLES);
+    Timer2.getProfile(Profile);
+    printf("call of %3lu cycles after %3lu cycles: max duration %3u ticks, %u overruns, %u missed periods\n", Cycles, Delay,
+           Profile.MaxDuration, Profile.Overruns, Profile.MissedPeriods);
+    AVRSIM_CHECK((Profile.MaxDuration >= Cycles) && (Profile.MaxDuration <= Cycles + TEST_MAX_OVERHEAD));
+    AVRSIM_CHECK(Overruns == Profile.Overruns);
+    AVRSIM_CHECK(MissedPeriods == Profile.MissedPeriods);
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    TimerTwo::ProfileType Profile;
+
+    AVRSIM_CHECK(E_OK == Timer2.init(TEST_PERIOD_MICROSECONDS, overflow));
+    AVRSIM_CHECK(E_OK == Timer2.start());
+    delay(1u);
+    Timer2.getProfile(Profile);
+    AVRSIM_CHECK((Profile.MaxDuration <= TEST_MAX_OVERHEAD) && (0u == Profile.Overruns) && (0u == Profile.MissedPeriods));
+
+    testCall(0u, TEST_PERIOD_CYCLES / 4u, 0u, 0u);
+    /* ends after TOP, counting down */
+    testCall(0u, 5u * TEST_PERIOD_CYCLES / 8u, 0u, 0u);
+    /* ends after the next BOTTOM, but the counter has not reached the start again */
+    testCall(TEST_PERIOD_CYCLES / 4u, 7u * TEST_PERIOD_CYCLES / 8u, 1u, 0u);
+    /* longer than the period */
+    testCall(0u, 5u * TEST_PERIOD_CYCLES / 4u, 1u, 1u);
+    testCall(TEST_PERIOD_CYCLES / 8u, 9u * TEST_PERIOD_CYCLES / 8u, 1u, 1u);
+
+    Timer2.clearProfile();
+    Timer2.getProfile(Profile);
+    AVRSIM_CHECK((0u == Profile.MaxDuration) && (0u == Profile.Overruns) && (0u == Profile.MissedPeriods));
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
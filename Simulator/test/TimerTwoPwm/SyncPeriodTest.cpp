@@ -0,0 +1,171 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       SyncPeriodTest.cpp
+ *      \brief      Test of the commit flag, the callback and the period boundaries of setPeriodSync() in phase correct mode 5
+ *
+ *      \details    While the timer is stopped, setPeriodSync() has to set the period at once without callback. While it
+ *                  runs, isPeriodPending() has to be set until the overflow interrupt has committed TOP and prescaler,
+ *                  the callback has to be called once and see the new registers. The longest period of the dual slope
+ *                  counter is accepted, one microsecond more is set as maximum with E_NOT_OK, longer requests are
+ *                  refused and leave the running period unchanged.
+ *
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include <Arduino.h>
+#include <TimerTwo.h>
+#include <stdio.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define TEST_DUTY                                   64u
+/* first period which does not fit into the dual slope counter with prescaler 1024 */
+#define TEST_MAX_PERIOD                             ((TIMERTWO_RESOLUTION / (F_CPU / 1000000uL)) * TIMERTWO_MAX_PRESCALER * 2u)
+
+
+/******************************************************************************************************************************************************
+ * LOCAL DATA
+ *****************************************************************************************************************************************************/
+static const uint16_t Prescalers[8] = { 0u, 1u, 8u, 32u, 64u, 128u, 256u, 1024u };
+
+static unsigned int Calls = 0u;
+static bool CallbackPending = true;
+static byte CallbackTop = 0u;
+static uint16_t CallbackPrescaler = 0u;
+
+
+/******************************************************************************************************************************************************
+ * L O C A L   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+static uint16_t getPrescaler()
+{
+    return Prescalers[TCCR2B.Value & TIMERTWO_REG_CS_GM];
+}
+
+static void committed()
+{
+    Calls++;
+    CallbackPending = Timer2.isPeriodPending();
+    CallbackTop = OCR2A.Value;
+    CallbackPrescaler = getPrescaler();
+}
+
+/* dual slope period of TOP and prescaler, calcPeriod() rounds down by less than one tick on each slope */
+static bool isPeriod(unsigned long Microseconds, byte Top, uint16_t Prescaler)
+{
+    uint32_t Cycles = 2uL * Top * Prescaler;
+    uint32_t Requested = Microseconds * (F_CPU / 1000000uL);
+
+    return (0u != Prescaler) && (Cycles <= Requested) && (Cycles + 2uL * Prescaler > Requested);
+}
+
+/* runs until the staged period is committed, this takes the rest of the old period and one period with the new TOP and the
+   old prescaler */
+static bool waitCommit()
+{
+    uint64_t Timeout = AvrSim::getCycles() + 2u * TEST_MAX_PERIOD * (F_CPU / 1000000uL);
+
+    while(Timer2.isPeriodPending() && (AvrSim::getCycles() < Timeout)) AvrSim::run(1u);
+    return !Timer2.isPeriodPending();
+}
+
+static void testSync(unsigned long OldMicroseconds, unsigned long Microseconds)
+{
+    byte OldTop = OCR2A.Value;
+    uint16_t OldPrescaler = getPrescaler();
+
+    Calls = 0u;
+    CallbackPending = true;
+    AVRSIM_CHECK(E_OK == Timer2.setPeriodSync(Microseconds, committed));
+    /* nothing is written before the next BOTTOM */
+    AVRSIM_CHECK(Timer2.isPeriodPending());
+    AVRSIM_CHECK(OldTop == OCR2A.Value);
+    AVRSIM_CHECK(OldPrescaler == getPrescaler());
+    AVRSIM_CHECK(0u == Calls);
+    AVRSIM_CHECK(waitCommit());
+    printf("period %5lu -> %5lu us: top %3u -> %3u, prescaler %4u -> %4u, %u callback\n", OldMicroseconds, Microseconds, OldTop, CallbackTop,
+           OldPrescaler, CallbackPrescaler, Calls);
+    AVRSIM_CHECK(1u == Calls);
+    AVRSIM_CHECK(!CallbackPending);
+    AVRSIM_CHECK(isPeriod(Microseconds, CallbackTop, CallbackPrescaler));
+    /* without overflow callback the overflow interrupt is disabled after the commit */
+    AVRSIM_CHECK(0u == (TIMSK2.Value & (1u << TOIE2)));
+    /* the callback is called for one commit only */
+    AvrSim::run(2u * Microseconds * (F_CPU / 1000000uL));
+    AVRSIM_CHECK(1u == Calls);
+}
+
+
+/******************************************************************************************************************************************************
+ * S K E T C H
+ *****************************************************************************************************************************************************/
+void setup()
+{
+    byte Top;
+    uint16_t Prescaler;
+
+    AVRSIM_CHECK(E_OK == Timer2.init(1000u));
+    AVRSIM_CHECK(E_OK == Timer2.enablePwm(TimerTwo::PWM_PIN_3, TEST_DUTY));
+
+    /* stopped timer, the period is set at once */
+    AVRSIM_CHECK(E_OK == Timer2.setPeriodSync(500u, committed));
+    AVRSIM_CHECK(!Timer2.isPeriodPending());
+    AVRSIM_CHECK(0u == (TIMSK2.Value & (1u << TOIE2)));
+    AVRSIM_CHECK(E_OK == Timer2.start());
+    /* compare buffers are taken over at the first TOP */
+    delay(2u);
+    AVRSIM_CHECK(isPeriod(500u, OCR2A.Value, getPrescaler()));
+    AVRSIM_CHECK(0u == Calls);
+
+    testSync(500u, 2000u);
+    testSync(2000u, 100u);
+    testSync(100u, TEST_MAX_PERIOD - 1u);
+    testSync(TEST_MAX_PERIOD - 1u, 1000u);
+
+    /* out of bounds by rounding, the longest period is staged */
+    Calls = 0u;
+    AVRSIM_CHECK(E_NOT_OK == Timer2.setPeriodSync(TEST_MAX_PERIOD, committed));
+    AVRSIM_CHECK(Timer2.isPeriodPending());
+    AVRSIM_CHECK(waitCommit());
+    AVRSIM_CHECK(1u == Calls);
+    AVRSIM_CHECK((TIMERTWO_RESOLUTION - 1u == CallbackTop) && (TIMERTWO_MAX_PRESCALER == CallbackPrescaler));
+
+    /* out of bounds, nothing is staged and the period is kept */
+    Top = OCR2A.Value;
+    Prescaler = getPrescaler();
+    Calls = 0u;
+    AVRSIM_CHECK(E_NOT_OK == Timer2.setPeriodSync(TEST_MAX_PERIOD + 1u, committed));
+    AVRSIM_CHECK(!Timer2.isPeriodPending());
+    AvrSim::run(2u * TEST_MAX_PERIOD * (F_CPU / 1000000uL));
+    AVRSIM_CHECK(0u == Calls);
+    AVRSIM_CHECK((Top == OCR2A.Value) && (Prescaler == getPrescaler()));
+
+    /* commit without callback */
+    AVRSIM_CHECK(E_OK == Timer2.setPeriodSync(1000u));
+    AVRSIM_CHECK(Timer2.isPeriodPending());
+    AVRSIM_CHECK(waitCommit());
+    AVRSIM_CHECK(isPeriod(1000u, OCR2A.Value, getPrescaler()));
+    AVRSIM_CHECK(0u == Calls);
+}
+
+void loop()
+{
+
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
@@ -0,0 +1,123 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       FrequencyCounter.h
+ *      \brief      Main header file of FrequencyCounter library
+ *
+ *      \details    Frequency counter for a signal on the T1 pin (Arduino pin 5). Timer1 counts the edges of the signal
+ *                  as external clock, extended by its overflow epoch, so no interrupt occurs per edge. Timer2 generates
+ *                  the gate window with a 1 ms compare interrupt, the edge count is read at the start and at the end of
+ *                  each window.
+ *
+ *****************************************************************************************************************************************************/
+#ifndef _FREQUENCYCOUNTER_H_
+#define _FREQUENCYCOUNTER_H_
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include "Arduino.h"
+#include <StandardTypes.h>
+#include <TimerOne.h>
+
+#if (TIMERONE_FREQUENCY_COUNTER == STD_ON)
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+/* Timer2 runs with prescaler 64 in CTC mode, one compare match every millisecond */
+#define FREQUENCYCOUNTER_GATE_TOP                   (F_CPU / 64uL / 1000uL - 1u)
+
+/* gate window in milliseconds */
+#define FREQUENCYCOUNTER_MIN_GATE                   1u
+#define FREQUENCYCOUNTER_MAX_GATE                   10000u
+
+/******************************************************************************************************************************************************
+ *  LOCAL FUNCTION MACROS
+ *****************************************************************************************************************************************************/
+
+
+/******************************************************************************************************************************************************
+ *  GLOBAL DATA TYPES AND STRUCTURES
+ *****************************************************************************************************************************************************/
+
+
+/******************************************************************************************************************************************************
+ *  CLASS  FrequencyCounter
+ *****************************************************************************************************************************************************/
+class FrequencyCounter
+{
+/******************************************************************************************************************************************************
+ *  P U B L I C   D A T A   T Y P E S   A N D   S T R U C T U R E S
+******************************************************************************************************************************************************/
+  public:
+    /* Type which describes the internal state of the FrequencyCounter */
+    enum StateType {
+        STATE_INIT,
+        STATE_READY,
+        STATE_MEASURING
+    };
+
+    /* Type which describes the counted edge of the signal */
+    enum EdgeType {
+        EDGE_FALLING,
+        EDGE_RISING
+    };
+
+/******************************************************************************************************************************************************
+ *  P R I V A T E   D A T A   A N D   F U N C T I N O N S
+******************************************************************************************************************************************************/
+  private:
+    FrequencyCounter();
+    ~FrequencyCounter();
+    FrequencyCounter(const FrequencyCounter&);
+
+    StateType State;
+    /* gate window in milliseconds */
+    uint16_t Gate;
+    uint16_t Remaining;
+    /* the first compare match only takes the start count */
+    boolean Synchronizing;
+    /* edge count at the start of the running window */
+    uint32_t GateStart;
+    /* edge count of the last finished window */
+    volatile uint32_t Count;
+    volatile boolean Ready;
+
+/******************************************************************************************************************************************************
+ *  P U B L I C   F U N C T I O N S
+******************************************************************************************************************************************************/
+  public:
+    static FrequencyCounter& getInstance();
+
+    // get methods
+    StateType getState() const { return State; }
+    uint16_t getGate() const { return Gate; }
+    boolean available() const { return Ready; }
+    uint32_t read();
+    uint32_t getFrequency();
+
+    // set methods
+    stdReturnType init(EdgeType = EDGE_RISING);
+    stdReturnType start(uint16_t);
+    void stop();
+    void gateInterrupt();
+};
+
+/* FrequencyCounter will be pre-instantiated in FrequencyCounter source file */
+extern FrequencyCounter& FreqCounter;
+
+#endif
+
+#endif
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
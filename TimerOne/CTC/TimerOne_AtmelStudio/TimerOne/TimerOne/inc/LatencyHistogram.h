@@ -0,0 +1,86 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       LatencyHistogram.h
+ *      \brief      Main header file of LatencyHistogram library
+ *
+ *      \details    Minimum, maximum, mean and a log2 histogram of interrupt latencies in timer ticks. Samples are added
+ *                  by the interrupt, a copy taken with interrupts disabled is read by the application.
+ *
+ *****************************************************************************************************************************************************/
+#ifndef _LATENCYHISTOGRAM_H_
+#define _LATENCYHISTOGRAM_H_
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include "Arduino.h"
+#include <StandardTypes.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+/* bin 0 counts latency 0, bin n counts latencies from 2^(n-1) to 2^n - 1, the last bin counts all larger latencies */
+#define LATENCYHISTOGRAM_NUMBER_OF_BINS             8u
+
+/* size of dump(): count, minimum, maximum, mean and bins, 16 bit little endian each */
+#define LATENCYHISTOGRAM_DUMP_SIZE                  (2u * (4u + LATENCYHISTOGRAM_NUMBER_OF_BINS))
+
+/******************************************************************************************************************************************************
+ *  LOCAL FUNCTION MACROS
+ *****************************************************************************************************************************************************/
+
+
+/******************************************************************************************************************************************************
+ *  GLOBAL DATA TYPES AND STRUCTURES
+ *****************************************************************************************************************************************************/
+
+
+/******************************************************************************************************************************************************
+ *  CLASS  LatencyHistogram
+ *****************************************************************************************************************************************************/
+class LatencyHistogram
+{
+/******************************************************************************************************************************************************
+ *  P R I V A T E   D A T A   A N D   F U N C T I N O N S
+******************************************************************************************************************************************************/
+  private:
+    /* count saturates at 0xFFFF, so the sum fits into 32 bit */
+    uint16_t Count;
+    uint16_t Minimum;
+    uint16_t Maximum;
+    uint32_t Sum;
+    uint16_t Bins[LATENCYHISTOGRAM_NUMBER_OF_BINS];
+
+/******************************************************************************************************************************************************
+ *  P U B L I C   F U N C T I O N S
+******************************************************************************************************************************************************/
+  public:
+    LatencyHistogram() { clear(); }
+
+    // get methods
+    uint16_t getCount() const { return Count; }
+    uint16_t getMinimum() const { return Minimum; }
+    uint16_t getMaximum() const { return Maximum; }
+    uint16_t getMean() const { return (Count > 0u) ? (uint16_t) (Sum / Count) : 0u; }
+    uint16_t getBin(byte Bin) const { return (Bin < LATENCYHISTOGRAM_NUMBER_OF_BINS) ? Bins[Bin] : 0u; }
+    byte dump(byte*, byte) const;
+
+    // set methods
+    void clear();
+    void add(uint16_t);
+};
+
+#endif
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
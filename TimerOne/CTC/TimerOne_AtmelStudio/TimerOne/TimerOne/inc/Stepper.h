@@ -0,0 +1,166 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       Stepper.h
+ *      \brief      Main header file of Stepper library
+ *
+ *      \details    Step pulse generator for one stepper motor driver on Timer1. Moves are queued and run with a
+ *                  trapezoidal speed profile, the next step interval is calculated in the compare interrupt by a division
+ *                  free recurrence, so the speed changes at every step without jitter.
+ *
+ *****************************************************************************************************************************************************/
+#ifndef _STEPPER_H_
+#define _STEPPER_H_
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include "Arduino.h"
+#include <StandardTypes.h>
+#include <TimerOne.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+/* Timer1 runs with prescaler 8, one tick is 0.5 us at 16 MHz */
+#define STEPPER_TICK_FREQUENCY                      (F_CPU / 8uL)
+/* period of Timer1 init, selects prescaler 8 */
+#define STEPPER_INIT_PERIOD                         32000uL
+
+/* shortest step interval in ticks, the step calculation has to end before the counter reaches it (20000 steps/s) */
+#define STEPPER_MIN_PERIOD                          100u
+#define STEPPER_MAX_SPEED                           (STEPPER_TICK_FREQUENCY / STEPPER_MIN_PERIOD)
+/* longest step interval is 0xFFFF ticks */
+#define STEPPER_MIN_SPEED                           (STEPPER_TICK_FREQUENCY / 0xFFFFuL + 1u)
+/* upper limit of acceleration and deceleration in steps/s^2, so the ramp factor fits into 32 bit */
+#define STEPPER_MAX_ACCELERATION                    200000uL
+
+/* ramp factor per step/s^2: 2^56 / STEPPER_TICK_FREQUENCY^2 */
+#define STEPPER_RAMP_SCALE                          ((uint32_t) ((1uLL << 56) / ((uint64_t) STEPPER_TICK_FREQUENCY * STEPPER_TICK_FREQUENCY)))
+
+/* size of the move queue, has to be a power of two */
+#define STEPPER_QUEUE_SIZE                          8u
+#define STEPPER_QUEUE_MASK                          (STEPPER_QUEUE_SIZE - 1u)
+
+/******************************************************************************************************************************************************
+ *  LOCAL FUNCTION MACROS
+ *****************************************************************************************************************************************************/
+
+
+/******************************************************************************************************************************************************
+ *  GLOBAL DATA TYPES AND STRUCTURES
+ *****************************************************************************************************************************************************/
+
+
+/******************************************************************************************************************************************************
+ *  CLASS  Stepper
+ *****************************************************************************************************************************************************/
+class Stepper
+{
+/******************************************************************************************************************************************************
+ *  P U B L I C   D A T A   T Y P E S   A N D   S T R U C T U R E S
+******************************************************************************************************************************************************/
+  public:
+    /* Type which describes the internal state of the Stepper */
+    enum StateType {
+        STATE_INIT,
+        STATE_READY,
+        STATE_RUNNING
+    };
+
+    /* Type which includes the ports of the step and direction pins */
+    enum PortType {
+        PORT_B,
+        PORT_C,
+        PORT_D,
+        NUMBER_OF_PORTS
+    };
+
+/******************************************************************************************************************************************************
+ *  P R I V A T E   D A T A   A N D   F U N C T I N O N S
+******************************************************************************************************************************************************/
+  private:
+    /* move with its speed profile, calculated when the move is queued */
+    struct MoveType {
+        uint32_t Steps;
+        /* steps which end an acceleration interval */
+        uint32_t AccelerationSteps;
+        /* first step which starts a deceleration interval */
+        uint32_t DecelerationStart;
+        /* step intervals in ticks, 16.16 fixed point */
+        uint32_t StartPeriod;
+        uint32_t CruisePeriod;
+        boolean Reverse;
+    };
+
+    Stepper();
+    ~Stepper();
+    Stepper(const Stepper&);
+
+    StateType State;
+    PortType StepPort;
+    byte StepMask;
+    PortType DirectionPort;
+    byte DirectionMask;
+    uint32_t Acceleration;
+    uint32_t Deceleration;
+    /* ramp factors a / F^2 * 2^56 */
+    uint32_t AccelerationFactor;
+    uint32_t DecelerationFactor;
+    /* single producer (queueMove), single consumer (stepInterrupt) ring buffer */
+    MoveType Queue[STEPPER_QUEUE_SIZE];
+    volatile byte QueueHead;
+    volatile byte QueueTail;
+    /* move which is run by the interrupt */
+    MoveType Move;
+    uint32_t Step;
+    uint32_t Period;
+    uint16_t PeriodFraction;
+    volatile int32_t Position;
+    volatile uint32_t StepCount;
+
+    static uint32_t multiplyHigh(uint32_t, uint32_t);
+    static uint32_t rampPeriod(uint32_t, uint32_t, boolean);
+    static uint16_t squareRoot(uint32_t);
+    void loadMove();
+    void writePeriod();
+    void writeDirection(boolean);
+    void writeStep();
+
+/******************************************************************************************************************************************************
+ *  P U B L I C   F U N C T I O N S
+******************************************************************************************************************************************************/
+  public:
+    static Stepper& getInstance();
+
+    // get methods
+    StateType getState() const { return State; }
+    int32_t getPosition() const;
+    uint32_t getStepCount() const;
+    byte getQueueCount() const { return (QueueHead - QueueTail) & STEPPER_QUEUE_MASK; }
+
+    // set methods
+    stdReturnType init(PortType, byte, PortType, byte);
+    stdReturnType setAcceleration(uint32_t, uint32_t);
+    stdReturnType queueMove(int32_t, uint16_t);
+    void stop();
+    void stepInterrupt();
+    static void stepCallback();
+};
+
+/* Stepper will be pre-instantiated in Stepper source file */
+extern Stepper& StepperMotor;
+
+#endif
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
@@ -24,6 +24,7 @@
 #include "Arduino.h"
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <util/atomic.h>
 #include <StandardTypes.h>
 
 
@@ -39,6 +40,73 @@
 
 #define TIMERONE_MAX_PRESCALER						1024
 
+/* free running counter extended by the overflow interrupt, the compare interrupt only occurs at a deadline */
+#ifndef TIMERONE_TICKLESS
+#define TIMERONE_TICKLESS							STD_OFF
+#endif
+
+/* count interrupts and wakeups, to measure the savings of the tickless mode */
+#ifndef TIMERONE_INTERRUPT_COUNTER
+#define TIMERONE_INTERRUPT_COUNTER					STD_OFF
+#endif
+
+/* timestamp edges on ICP1 in tickless mode, buffer size has to be a power of two */
+#ifndef TIMERONE_INPUT_CAPTURE
+#define TIMERONE_INPUT_CAPTURE						STD_OFF
+#endif
+#define TIMERONE_CAPTURE_BUFFER_SIZE				16
+#define TIMERONE_CAPTURE_BUFFER_MASK				(TIMERONE_CAPTURE_BUFFER_SIZE - 1)
+#if (TIMERONE_INPUT_CAPTURE == STD_ON) && (TIMERONE_TICKLESS == STD_OFF)
+# error "TIMERONE_INPUT_CAPTURE needs TIMERONE_TICKLESS, ICR1 is TOP in periodic mode"
+#endif
+
+/* measure latency of the compare interrupt in timer ticks, relative to the compare match */
+#ifndef TIMERONE_LATENCY_HISTOGRAM
+#define TIMERONE_LATENCY_HISTOGRAM					STD_OFF
+#endif
+#if (TIMERONE_LATENCY_HISTOGRAM == STD_ON)
+# include <LatencyHistogram.h>
+#endif
+
+/* measure run time of the compare callback in timer ticks and count overruns */
+#ifndef TIMERONE_CALLBACK_PROFILER
+#define TIMERONE_CALLBACK_PROFILER					STD_OFF
+#endif
+
+/* drive hobby servos by the compare B interrupt, one frame is one period in periodic mode */
+#ifndef TIMERONE_SERVO
+#define TIMERONE_SERVO								STD_OFF
+#endif
+#define TIMERONE_SERVO_MAX_CHANNELS					12
+/* pulse width limits in microseconds */
+#define TIMERONE_SERVO_MIN_PULSE					500
+#define TIMERONE_SERVO_MAX_PULSE					2500
+/* edge index of the frame start */
+#define TIMERONE_SERVO_FRAME_START					0xFF
+
+/* square wave on OC1A (Arduino pin 9) in compare output toggle mode */
+#ifndef TIMERONE_TONE
+#define TIMERONE_TONE								STD_OFF
+#endif
+#define TIMERONE_TONE_PIN							9
+/* duration of a tone counted by Timer2 overflows, needs the Timer2 overflow interrupt */
+#ifndef TIMERONE_TONE_DURATION
+#define TIMERONE_TONE_DURATION						STD_OFF
+#endif
+/* Timer2 runs with prescaler 1024 while a tone with duration is played */
+#define TIMERONE_TONE_TICK_FREQUENCY				(F_CPU / 1024UL)
+#if (TIMERONE_TONE_DURATION == STD_ON) && (TIMERONE_TONE == STD_OFF)
+# error "TIMERONE_TONE_DURATION needs TIMERONE_TONE"
+#endif
+
+/* frequency counter on T1 (Arduino pin 5) with Timer2 as gate, see FrequencyCounter.h */
+#ifndef TIMERONE_FREQUENCY_COUNTER
+#define TIMERONE_FREQUENCY_COUNTER					STD_OFF
+#endif
+#if (TIMERONE_FREQUENCY_COUNTER == STD_ON) && (TIMERONE_TICKLESS == STD_OFF)
+# error "TIMERONE_FREQUENCY_COUNTER needs TIMERONE_TICKLESS, Timer1 counts the edges as free running counter"
+#endif
+
 /******************************************************************************************************************************************************
  *  LOCAL FUNCTION MACROS
  *****************************************************************************************************************************************************/
@@ -66,9 +134,92 @@ typedef enum {
 	TIMERONE_REG_CS_PRESCALE_8,
 	TIMERONE_REG_CS_PRESCALE_64,
 	TIMERONE_REG_CS_PRESCALE_256,
-	TIMERONE_REG_CS_PRESCALE_1024
+	TIMERONE_REG_CS_PRESCALE_1024,
+	/* external clock on T1 pin (Arduino pin 5) */
+	TIMERONE_REG_CS_EXTERNAL_FALLING,
+	TIMERONE_REG_CS_EXTERNAL_RISING
 } TimerOneClockSelectType;
 
+/* Type which describes how the compare interrupt is generated */
+typedef enum {
+	TIMERONE_MODE_PERIODIC,
+	TIMERONE_MODE_TICKLESS
+} TimerOneModeType;
+
+/* Type which describes the edges captured on ICP1 */
+typedef enum {
+	TIMERONE_CAPTURE_EDGE_FALLING,
+	TIMERONE_CAPTURE_EDGE_RISING,
+	TIMERONE_CAPTURE_EDGE_BOTH
+} TimerOneCaptureEdgeType;
+
+/* Type which describes one captured edge */
+typedef struct {
+	/* counter value of the edge, extended by the overflow epoch like getTicks() */
+	unsigned long Ticks;
+	boolean RisingEdge;
+} TimerOneCaptureType;
+
+/* Type which describes the run time of the compare callback */
+typedef struct {
+	/* longest run time in timer ticks, exact up to two periods */
+	unsigned long MaxDuration;
+	/* callback was still running at the next compare match, so the next interrupt was late */
+	unsigned int Overruns;
+	/* callback was running for at least a whole period */
+	unsigned int MissedPeriods;
+} TimerOneProfileType;
+
+/* Type which includes the ports of the servo pins */
+typedef enum {
+	TIMERONE_SERVO_PORT_B,
+	TIMERONE_SERVO_PORT_C,
+	TIMERONE_SERVO_PORT_D,
+	TIMERONE_SERVO_NUMBER_OF_PORTS
+} TimerOneServoPortType;
+
+/* Type which describes one servo */
+typedef struct {
+	TimerOneServoPortType Port;
+	byte Mask;
+	/* pulse width in microseconds */
+	unsigned int Pulse;
+} TimerOneServoType;
+
+/* Type which describes the end of the pulses of all servos with the same pulse width */
+typedef struct {
+	unsigned int Ticks;
+	byte Toggle[TIMERONE_SERVO_NUMBER_OF_PORTS];
+} TimerOneServoEdgeType;
+
+/* Type which describes the pulse ends of one frame sorted by time */
+typedef struct {
+	TimerOneServoEdgeType Edges[TIMERONE_SERVO_MAX_CHANNELS];
+	byte Length;
+} TimerOneServoScheduleType;
+
+
+/* compile time calculation of prescaler and timer top value, same ladder as setPeriod(unsigned long) */
+template <unsigned long Microseconds>
+struct TimerOnePeriod
+{
+	/* calculate timer cycles to reach timer period */
+	static const unsigned long TimerCycles = (F_CPU / 1000000) * Microseconds;
+	static const TimerOneClockSelectType ClockSelectBitGroup =
+		(TimerCycles < TIMERONE_RESOLUTION)         ? TIMERONE_REG_CS_NO_PRESCALER :
+		((TimerCycles >> 3) < TIMERONE_RESOLUTION)  ? TIMERONE_REG_CS_PRESCALE_8 :
+		((TimerCycles >> 6) < TIMERONE_RESOLUTION)  ? TIMERONE_REG_CS_PRESCALE_64 :
+		((TimerCycles >> 8) < TIMERONE_RESOLUTION)  ? TIMERONE_REG_CS_PRESCALE_256 : TIMERONE_REG_CS_PRESCALE_1024;
+	static const unsigned char PrescaleShiftScale =
+		(TIMERONE_REG_CS_NO_PRESCALER == ClockSelectBitGroup) ? 0 :
+		(TIMERONE_REG_CS_PRESCALE_8 == ClockSelectBitGroup)   ? 3 :
+		(TIMERONE_REG_CS_PRESCALE_64 == ClockSelectBitGroup)  ? 6 :
+		(TIMERONE_REG_CS_PRESCALE_256 == ClockSelectBitGroup) ? 8 : 10;
+	static const unsigned int Top = TimerCycles >> PrescaleShiftScale;
+	/* request out of bounds? */
+	STATIC_ASSERT((Microseconds <= (0xFFFFFFFFUL / (F_CPU / 1000000))) && ((TimerCycles >> 10) < TIMERONE_RESOLUTION), TimerOnePeriodOutOfBounds);
+};
+
 
 /******************************************************************************************************************************************************
  *  CLASS  TimerOne
@@ -81,21 +232,155 @@ class TimerOne
     TimerOne(const TimerOne&);
 	TimerOneStateType State;
 	TimerOneClockSelectType ClockSelectBitGroup;
+	TimerOneModeType Mode;
 	unsigned int PwmPeriod;
+	/* timer cycles of one period, used as time base in tickless mode */
+	unsigned int PeriodTicks;
+	/* number of overflows of the free running counter in tickless mode */
+	volatile unsigned int OverflowEpoch;
+	volatile unsigned long OverflowEpochHigh;
+	/* incremented by every Timer1 interrupt and by 16 bit register accesses of other interrupts, used by nowTicks() to detect them */
+	volatile byte InterruptSequence;
+	unsigned long CompareDeadline;
+	volatile boolean CompareArmed;
+#if (TIMERONE_INTERRUPT_COUNTER == STD_ON)
+	volatile unsigned long InterruptCounter;
+	volatile unsigned long WakeupCounter;
+#endif
+#if (TIMERONE_INPUT_CAPTURE == STD_ON)
+	/* single producer (capture interrupt), single consumer (readCapture) ring buffer */
+	TimerOneCaptureType CaptureBuffer[TIMERONE_CAPTURE_BUFFER_SIZE];
+	volatile byte CaptureHead;
+	volatile byte CaptureTail;
+	volatile unsigned int CaptureOverruns;
+	TimerOneCaptureEdgeType CaptureEdge;
+#endif
+#if (TIMERONE_LATENCY_HISTOGRAM == STD_ON)
+	LatencyHistogram CompareLatency;
+#endif
+#if (TIMERONE_CALLBACK_PROFILER == STD_ON)
+	TimerOneProfileType CallbackProfile;
+	void profileCallback(unsigned int);
+#endif
+#if (TIMERONE_SERVO == STD_ON)
+	TimerOneServoType Servos[TIMERONE_SERVO_MAX_CHANNELS];
+	byte NumberOfServos;
+	byte ServoMask[TIMERONE_SERVO_NUMBER_OF_PORTS];
+	TimerOneServoScheduleType ServoSchedules[2];
+	/* schedule which is applied by the compare B interrupt */
+	TimerOneServoScheduleType* ServoActive;
+	/* schedule which is taken over at the next frame start, NULL if the buffer is free */
+	TimerOneServoScheduleType* volatile ServoNext;
+	byte ServoEdgeIndex;
+	boolean ServosRunning;
+	stdReturnType buildServoSchedule(TimerOneServoScheduleType*) const;
+#endif
+#if (TIMERONE_TONE == STD_ON)
+#if (TIMERONE_TONE_DURATION == STD_ON)
+	/* Timer2 overflows until the end of the tone */
+	volatile unsigned long ToneOverflows;
+#endif
+	volatile boolean TonePlaying;
+#endif
+	stdReturnType getPrescaleShiftScale(char*) const;
+	unsigned long readTicks();
+	stdReturnType armCompare();
+	void wakeup();
 
   public:
     static TimerOne& getInstance();
 	TimerIsrCallbackF_void TimerCompareCallback;
 	stdReturnType init(long = 1000, TimerIsrCallbackF_void = NULL);
 	stdReturnType setPeriod(unsigned long);
+	template <unsigned long Microseconds> stdReturnType setPeriod();
+	void setPeriodTicks(unsigned int);
+	stdReturnType setMode(TimerOneModeType);
+	stdReturnType setClockSource(TimerOneClockSelectType);
+	TimerOneStateType getState() const { return State; }
+	TimerOneModeType getMode() const { return Mode; }
+	unsigned int getPeriodTicks() const { return PeriodTicks; }
+	unsigned long getTicks();
+	unsigned long long nowTicks();
+	stdReturnType setCompare(unsigned long);
+#if (TIMERONE_INTERRUPT_COUNTER == STD_ON)
+	unsigned long getInterruptCounter();
+	unsigned long getWakeupCounter();
+	void clearCounter();
+#endif
+#if (TIMERONE_INPUT_CAPTURE == STD_ON)
+	stdReturnType startCapture(TimerOneCaptureEdgeType, boolean = false);
+	void stopCapture();
+	byte readCapture(TimerOneCaptureType*, byte);
+	byte getCaptureCount() const { return (CaptureHead - CaptureTail) & TIMERONE_CAPTURE_BUFFER_MASK; }
+	unsigned int getCaptureOverruns();
+	void captureInterrupt();
+#endif
+#if (TIMERONE_LATENCY_HISTOGRAM == STD_ON)
+	void getLatency(LatencyHistogram&);
+	void clearLatency();
+#endif
+#if (TIMERONE_CALLBACK_PROFILER == STD_ON)
+	void getProfile(TimerOneProfileType*);
+	void clearProfile();
+#endif
+#if (TIMERONE_SERVO == STD_ON)
+	stdReturnType attachServo(TimerOneServoPortType, byte);
+	stdReturnType setServoPulse(byte, unsigned int);
+	stdReturnType updateServos();
+	stdReturnType startServos();
+	void stopServos();
+	byte getNumberOfServos() const { return NumberOfServos; }
+	byte getNumberOfServoEdges() const { return ServoActive->Length; }
+	boolean isServoUpdatePending();
+	void servoInterrupt();
+#endif
+#if (TIMERONE_TONE == STD_ON)
+	stdReturnType tone(unsigned int, unsigned long = 0);
+	void noTone();
+	boolean isTonePlaying() const { return TonePlaying; }
+#if (TIMERONE_TONE_DURATION == STD_ON)
+	void toneInterrupt();
+#endif
+#endif
 	stdReturnType start();
 	void stop();
 	stdReturnType resume();
 	stdReturnType attachInterrupt(TimerIsrCallbackF_void);
 	void detachInterrupt();
 	stdReturnType read(unsigned long*);
+	void compareInterrupt();
+#if (TIMERONE_TICKLESS == STD_ON)
+	void overflowInterrupt();
+#endif
 };
 
+
+
+/******************************************************************************************************************************************************
+  setPeriod()
+******************************************************************************************************************************************************/
+/*! \brief          set period of Timer1 compare interrupt at compile time
+ *  \details        prescaler and timer top value are calculated during compilation, so only the register stores
+ *                  remain. Out of bounds requests, from 4194304 microseconds at 16 MHz, fail to compile.
+ *  \tparam         Microseconds				period of the timer compare interrupt
+ *  \return         E_OK
+ *****************************************************************************************************************************************************/
+template <unsigned long Microseconds>
+stdReturnType TimerOne::setPeriod()
+{
+	ClockSelectBitGroup = TimerOnePeriod<Microseconds>::ClockSelectBitGroup;
+	PeriodTicks = TimerOnePeriod<Microseconds>::Top;
+	/* ICR1 is TOP in mode 12: clear timer on compare match (CTC), in tickless mode the counter runs up to MAX */
+	if(TIMERONE_MODE_PERIODIC == Mode) { ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { ICR1 = TimerOnePeriod<Microseconds>::Top; } }
+
+	if(TIMERONE_STATE_RUNNING == State)
+	{
+		/* reset clock select register, and starts the clock */
+		writeBitGroup(TCCR1B, TIMERONE_REG_CS_GM, TIMERONE_REG_CS_GP, ClockSelectBitGroup);
+	}
+	return E_OK;
+} /* setPeriod */
+
 /* TimerOne will be pre-instantiated in TimerOne source file */
 extern TimerOne& Timer1;
 
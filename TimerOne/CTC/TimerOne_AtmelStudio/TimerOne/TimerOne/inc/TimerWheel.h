@@ -0,0 +1,146 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       TimerWheel.h
+ *      \brief      Main header file of TimerWheel library
+ *
+ *      \details    Hierarchical timer wheel which multiplexes any number of one-shot and periodic software timers on the
+ *                  Timer1 compare interrupt. Insert and cancel are O(1), every tick only touches one slot of the first level.
+ *
+ *****************************************************************************************************************************************************/
+#ifndef _TIMERWHEEL_H_
+#define _TIMERWHEEL_H_
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include "Arduino.h"
+#include <StandardTypes.h>
+#include <TimerOne.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+/* every level of the wheel has 16 slots, 4 levels cover a timeout range of 2^16 ticks */
+#define TIMERWHEEL_LEVEL_BITS						4
+#define TIMERWHEEL_NUMBER_OF_LEVELS					4
+#define TIMERWHEEL_SLOTS_PER_LEVEL					(1 << TIMERWHEEL_LEVEL_BITS)
+#define TIMERWHEEL_SLOT_MASK						(TIMERWHEEL_SLOTS_PER_LEVEL - 1)
+#define TIMERWHEEL_MAX_DELTA						((1UL << (TIMERWHEEL_LEVEL_BITS * TIMERWHEEL_NUMBER_OF_LEVELS)) - 1UL)
+
+/* maximum number of ticks skipped in tickless mode, has to fit into a signed 32 bit counter distance */
+#define TIMERWHEEL_TICKLESS_MAX_SKIP				0x7FFF
+
+/******************************************************************************************************************************************************
+ *  LOCAL FUNCTION MACROS
+ *****************************************************************************************************************************************************/
+
+
+/******************************************************************************************************************************************************
+ *  GLOBAL DATA TYPES AND STRUCTURES
+ *****************************************************************************************************************************************************/
+
+
+/******************************************************************************************************************************************************
+ *  CLASS  TimerWheelTimer
+ *****************************************************************************************************************************************************/
+/* software timer, the memory is owned by the caller and linked into the wheel while the timer is armed */
+class TimerWheelTimer
+{
+  friend class TimerWheel;
+
+  private:
+	TimerWheelTimer* Next;
+	TimerWheelTimer** PrevNext;
+	unsigned long Expiry;
+	unsigned long Period;
+	TimerIsrCallbackF_void Callback;
+
+  public:
+	TimerWheelTimer() : Next(NULL), PrevNext(NULL), Expiry(0), Period(0), Callback(NULL) {}
+
+	// get methods
+	boolean isArmed() const { return PrevNext != NULL; }
+	unsigned long getExpiry() const { return Expiry; }
+	unsigned long getPeriod() const { return Period; }
+};
+
+
+/******************************************************************************************************************************************************
+ *  CLASS  TimerWheel
+ *****************************************************************************************************************************************************/
+class TimerWheel
+{
+/******************************************************************************************************************************************************
+ *  P U B L I C   D A T A   T Y P E S   A N D   S T R U C T U R E S
+******************************************************************************************************************************************************/
+  public:
+	/* Type which describes the internal state of the TimerWheel */
+	enum StateType {
+		STATE_INIT,
+		STATE_RUNNING
+	};
+
+/******************************************************************************************************************************************************
+ *  P R I V A T E   D A T A   A N D   F U N C T I N O N S
+******************************************************************************************************************************************************/
+  private:
+	TimerWheel();
+	~TimerWheel();
+	TimerWheel(const TimerWheel&);
+
+	StateType State;
+	TimerOneModeType Mode;
+	/* number of ticks processed since init */
+	volatile unsigned long Now;
+	/* Timer1 counter value of the last processed tick in tickless mode */
+	unsigned long NowCount;
+	unsigned int PeriodTicks;
+	boolean InTick;
+	TimerWheelTimer* Slots[TIMERWHEEL_NUMBER_OF_LEVELS][TIMERWHEEL_SLOTS_PER_LEVEL];
+	/* timers of the current tick which are not yet called */
+	TimerWheelTimer* Pending;
+
+	static void linkTimer(TimerWheelTimer**, TimerWheelTimer*);
+	static void unlinkTimer(TimerWheelTimer*);
+	void addTimer(TimerWheelTimer*);
+	void cascade(byte, byte);
+	unsigned long getNextEvent() const;
+	unsigned long getElapsedTicks() const;
+	void tickless();
+	stdReturnType reprogram();
+
+/******************************************************************************************************************************************************
+ *  P U B L I C   F U N C T I O N S
+******************************************************************************************************************************************************/
+  public:
+	static TimerWheel& getInstance();
+
+	// get methods
+	StateType getState() const { return State; }
+	unsigned long getTicks() const;
+
+	// set methods
+	stdReturnType init(unsigned long = 1000UL, TimerOneModeType = TIMERONE_MODE_PERIODIC);
+	stdReturnType startTimer(TimerWheelTimer&, unsigned long, TimerIsrCallbackF_void, unsigned long = 0);
+	stdReturnType stopTimer(TimerWheelTimer&);
+	void tick();
+	static void tickCallback();
+};
+
+/* TimerWheel will be pre-instantiated in TimerWheel source file */
+extern TimerWheel& Wheel;
+
+#endif
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
@@ -0,0 +1,251 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       FrequencyCounter.cpp
+ *      \brief      Main file of FrequencyCounter library
+ *
+ *      \details    Frequency counter for a signal on the T1 pin with Timer1 as edge counter and Timer2 as gate.
+ *
+ *****************************************************************************************************************************************************/
+#define _FREQUENCYCOUNTER_SOURCE_
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include "FrequencyCounter.h"
+#include <util/atomic.h>
+
+#if (TIMERONE_FREQUENCY_COUNTER == STD_ON)
+
+/******************************************************************************************************************************************************
+ * GLOBAL DATA
+ *****************************************************************************************************************************************************/
+FrequencyCounter& FreqCounter = FrequencyCounter::getInstance();              // pre-instantiate FrequencyCounter
+
+
+/******************************************************************************************************************************************************
+ * C O N S T R U C T O R S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  CONSTRUCTOR OF FrequencyCounter
+******************************************************************************************************************************************************/
+/*! \brief          FrequencyCounter constructor
+ *  \details        Instantiation of the FrequencyCounter library
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+FrequencyCounter::FrequencyCounter()
+{
+    State = STATE_INIT;
+    Gate = 0u;
+    Remaining = 0u;
+    Synchronizing = false;
+    GateStart = 0u;
+    Count = 0u;
+    Ready = false;
+} /* FrequencyCounter */
+
+
+/******************************************************************************************************************************************************
+  DESTRUCTOR OF FrequencyCounter
+******************************************************************************************************************************************************/
+FrequencyCounter::~FrequencyCounter()
+{
+
+} /* ~FrequencyCounter */
+
+
+/******************************************************************************************************************************************************
+  COPY CONSTRUCTOR OF FrequencyCounter
+******************************************************************************************************************************************************/
+FrequencyCounter& FrequencyCounter::getInstance()
+{
+    static FrequencyCounter SingletonInstance;
+    return SingletonInstance;
+}
+
+
+/******************************************************************************************************************************************************
+ * P U B L I C   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  init()
+******************************************************************************************************************************************************/
+/*! \brief          initialization of the edge counter and the gate timer
+ *  \details        the T1 pin is set to input and Timer1 counts its edges in tickless mode from now on. Timer2 is set
+ *                  to CTC mode with a compare match every millisecond and is started by start().
+ *  \param[in]      Edge                        counted edge of the signal
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre            Timer1 and Timer2 must not be used by someone else
+ *****************************************************************************************************************************************************/
+stdReturnType FrequencyCounter::init(EdgeType Edge)
+{
+    stdReturnType ReturnValue = E_NOT_OK;
+
+    if(STATE_INIT == State) {
+        /* T1 pin is the input of the external clock */
+        writeBit(DDRD, DDD5, 0);
+        ReturnValue = Timer1.init();
+        if(E_OK == ReturnValue) ReturnValue = Timer1.setMode(TIMERONE_MODE_TICKLESS);
+        if(E_OK == ReturnValue) {
+            ReturnValue = Timer1.setClockSource(EDGE_FALLING == Edge ? TIMERONE_REG_CS_EXTERNAL_FALLING : TIMERONE_REG_CS_EXTERNAL_RISING);
+        }
+        if(E_OK == ReturnValue) ReturnValue = Timer1.start();
+        if(E_OK == ReturnValue) {
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+                /* set Timer2 to CTC mode, stopped until start() */
+                writeBit(TIMSK2, OCIE2A, 0);
+                TCCR2B = 0u;
+                TCCR2A = (1u << WGM21);
+                OCR2A = FREQUENCYCOUNTER_GATE_TOP;
+            }
+            State = STATE_READY;
+        }
+    }
+    return ReturnValue;
+} /* init */
+
+
+/******************************************************************************************************************************************************
+  start()
+******************************************************************************************************************************************************/
+/*! \brief          start continuous measurement
+ *  \details        the first window starts at the next millisecond, each window starts at the end of the previous one.
+ *                  The end of a window is signaled by available().
+ *  \param[in]      GateMilliseconds            gate window in milliseconds
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre            FrequencyCounter has to be initialized
+ *****************************************************************************************************************************************************/
+stdReturnType FrequencyCounter::start(uint16_t GateMilliseconds)
+{
+    if((STATE_INIT != State) && (GateMilliseconds >= FREQUENCYCOUNTER_MIN_GATE) && (GateMilliseconds <= FREQUENCYCOUNTER_MAX_GATE)) {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            Gate = GateMilliseconds;
+            Remaining = GateMilliseconds;
+            Synchronizing = true;
+            Ready = false;
+            TCCR2B = 0u;
+            TCNT2 = 0u;
+            TIFR2 = (1u << OCF2A);
+            writeBit(TIMSK2, OCIE2A, 1);
+            /* start gate timer with prescaler 64 */
+            TCCR2B = (1u << CS22);
+            State = STATE_MEASURING;
+        }
+        return E_OK;
+    } else {
+        return E_NOT_OK;
+    }
+} /* start */
+
+
+/******************************************************************************************************************************************************
+  stop()
+******************************************************************************************************************************************************/
+/*! \brief          stop measurement
+ *  \details        the gate timer is stopped, Timer1 keeps counting edges. The last result stays readable.
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void FrequencyCounter::stop()
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        if(STATE_MEASURING == State) {
+            TCCR2B = 0u;
+            writeBit(TIMSK2, OCIE2A, 0);
+            State = STATE_READY;
+        }
+    }
+} /* stop */
+
+
+/******************************************************************************************************************************************************
+  read()
+******************************************************************************************************************************************************/
+/*! \brief          read edge count of the last window
+ *  \details        available() is cleared until the next window has ended
+ *
+ *  \return         number of edges in the last window
+ *****************************************************************************************************************************************************/
+uint32_t FrequencyCounter::read()
+{
+    uint32_t Edges;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        Edges = Count;
+        Ready = false;
+    }
+    return Edges;
+} /* read */
+
+
+/******************************************************************************************************************************************************
+  getFrequency()
+******************************************************************************************************************************************************/
+/*! \brief          read frequency of the last window
+ *  \details        the resolution is 1000 / gate window in Hz, available() is cleared like by read()
+ *
+ *  \return         frequency in Hz
+ *****************************************************************************************************************************************************/
+uint32_t FrequencyCounter::getFrequency()
+{
+    uint32_t Edges = read();
+
+    if(0u == Gate) return 0u;
+    /* split the division so Edges * 1000 cannot overflow */
+    return (Edges / Gate) * 1000uL + ((Edges % Gate) * 1000uL) / Gate;
+} /* getFrequency */
+
+
+/******************************************************************************************************************************************************
+  gateInterrupt()
+******************************************************************************************************************************************************/
+/*! \brief          count milliseconds of the gate window
+ *  \details        this function is called by the Timer2 compare interrupt. The edge count is read at the same offset
+ *                  to the compare match at start and end of a window, so the window length is only unchanged if the
+ *                  interrupt latency is constant, a varying latency moves each end of the window by its variation.
+ *                  Timer1.getTicks() bumps the interrupt sequence of Timer1, so a Timer1.nowTicks() which is
+ *                  interrupted here reads the counter again.
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void FrequencyCounter::gateInterrupt()
+{
+    uint32_t Edges = Timer1.getTicks();
+
+    if(Synchronizing) {
+        Synchronizing = false;
+        GateStart = Edges;
+    } else if(0u == --Remaining) {
+        Count = Edges - GateStart;
+        GateStart = Edges;
+        Remaining = Gate;
+        Ready = true;
+    }
+} /* gateInterrupt */
+
+
+/******************************************************************************************************************************************************
+  I S R   F U N C T I O N S
+******************************************************************************************************************************************************/
+ISR(TIMER2_COMPA_vect)
+{
+    FreqCounter.gateInterrupt();
+}
+
+#endif
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
@@ -0,0 +1,500 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       Stepper.cpp
+ *      \brief      Main file of Stepper library
+ *
+ *      \details    Step pulse generator for one stepper motor driver on Timer1 with queued moves and a trapezoidal
+ *                  speed profile.
+ *
+ *****************************************************************************************************************************************************/
+#define _STEPPER_SOURCE_
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include "Stepper.h"
+#include <util/atomic.h>
+
+
+/******************************************************************************************************************************************************
+ * GLOBAL DATA
+ *****************************************************************************************************************************************************/
+Stepper& StepperMotor = Stepper::getInstance();              // pre-instantiate Stepper
+
+
+/******************************************************************************************************************************************************
+ * C O N S T R U C T O R S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  CONSTRUCTOR OF Stepper
+******************************************************************************************************************************************************/
+/*! \brief          Stepper constructor
+ *  \details        Instantiation of the Stepper library
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+Stepper::Stepper()
+{
+    State = STATE_INIT;
+    StepPort = PORT_B;
+    StepMask = 0u;
+    DirectionPort = PORT_B;
+    DirectionMask = 0u;
+    Acceleration = 0u;
+    Deceleration = 0u;
+    AccelerationFactor = 0u;
+    DecelerationFactor = 0u;
+    QueueHead = 0u;
+    QueueTail = 0u;
+    Step = 0u;
+    Period = 0u;
+    PeriodFraction = 0u;
+    Position = 0;
+    StepCount = 0u;
+} /* Stepper */
+
+
+/******************************************************************************************************************************************************
+  DESTRUCTOR OF Stepper
+******************************************************************************************************************************************************/
+Stepper::~Stepper()
+{
+
+} /* ~Stepper */
+
+
+/******************************************************************************************************************************************************
+  COPY CONSTRUCTOR OF Stepper
+******************************************************************************************************************************************************/
+Stepper& Stepper::getInstance()
+{
+    static Stepper SingletonInstance;
+    return SingletonInstance;
+}
+
+
+/******************************************************************************************************************************************************
+ * P U B L I C   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  init()
+******************************************************************************************************************************************************/
+/*! \brief          initialization of the stepper driver pins and Timer1
+ *  \details        both pins are set to output low. Timer1 is initialized with prescaler 8 and started when the first
+ *                  move is queued.
+ *  \param[in]      sStepPort                   port of the step pin
+ *  \param[in]      StepBit                     bit of the step pin in the port register
+ *  \param[in]      sDirectionPort              port of the direction pin
+ *  \param[in]      DirectionBit                bit of the direction pin in the port register
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre            Timer1 must not be initialized by someone else
+ *****************************************************************************************************************************************************/
+stdReturnType Stepper::init(PortType sStepPort, byte StepBit, PortType sDirectionPort, byte DirectionBit)
+{
+    stdReturnType ReturnValue = E_NOT_OK;
+
+    if((STATE_INIT == State) && (sStepPort < NUMBER_OF_PORTS) && (StepBit < 8u) && (sDirectionPort < NUMBER_OF_PORTS) &&
+       (DirectionBit < 8u) && ((sStepPort != sDirectionPort) || (StepBit != DirectionBit))) {
+        StepPort = sStepPort;
+        StepMask = 1u << StepBit;
+        DirectionPort = sDirectionPort;
+        DirectionMask = 1u << DirectionBit;
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            writeDirection(false);
+            if(PORT_B == StepPort) {
+                PORTB &= ~StepMask;
+                DDRB |= StepMask;
+            } else if(PORT_C == StepPort) {
+                PORTC &= ~StepMask;
+                DDRC |= StepMask;
+            } else {
+                PORTD &= ~StepMask;
+                DDRD |= StepMask;
+            }
+            if(PORT_B == DirectionPort) DDRB |= DirectionMask;
+            else if(PORT_C == DirectionPort) DDRC |= DirectionMask;
+            else DDRD |= DirectionMask;
+        }
+        if(E_OK == Timer1.init(STEPPER_INIT_PERIOD, stepCallback)) {
+            ReturnValue = E_OK;
+            State = STATE_READY;
+        }
+    }
+    return ReturnValue;
+} /* init */
+
+
+/******************************************************************************************************************************************************
+  getPosition()
+******************************************************************************************************************************************************/
+/*! \brief          read position
+ *  \details
+ *
+ *  \return         steps since init, reverse steps count down
+ *****************************************************************************************************************************************************/
+int32_t Stepper::getPosition() const
+{
+    int32_t sPosition;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { sPosition = Position; }
+    return sPosition;
+} /* getPosition */
+
+
+/******************************************************************************************************************************************************
+  getStepCount()
+******************************************************************************************************************************************************/
+/*! \brief          read number of steps
+ *  \details
+ *
+ *  \return         steps in both directions since init
+ *****************************************************************************************************************************************************/
+uint32_t Stepper::getStepCount() const
+{
+    uint32_t sStepCount;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { sStepCount = StepCount; }
+    return sStepCount;
+} /* getStepCount */
+
+
+/******************************************************************************************************************************************************
+  setAcceleration()
+******************************************************************************************************************************************************/
+/*! \brief          set acceleration and deceleration of the following moves
+ *  \details        the ramp factor a / F^2 of the step recurrence is calculated here, so the interrupt only multiplies
+ *
+ *  \param[in]      sAcceleration               acceleration in steps/s^2
+ *  \param[in]      sDeceleration               deceleration in steps/s^2
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre            Stepper has to be initialized, no move may be running or queued
+ *****************************************************************************************************************************************************/
+stdReturnType Stepper::setAcceleration(uint32_t sAcceleration, uint32_t sDeceleration)
+{
+    stdReturnType ReturnValue = E_NOT_OK;
+
+    if((STATE_READY == State) && (QueueHead == QueueTail) && (sAcceleration > 0u) && (sAcceleration <= STEPPER_MAX_ACCELERATION) &&
+       (sDeceleration > 0u) && (sDeceleration <= STEPPER_MAX_ACCELERATION)) {
+        ReturnValue = E_OK;
+        Acceleration = sAcceleration;
+        Deceleration = sDeceleration;
+        AccelerationFactor = Acceleration * STEPPER_RAMP_SCALE;
+        DecelerationFactor = Deceleration * STEPPER_RAMP_SCALE;
+    }
+    return ReturnValue;
+} /* setAcceleration */
+
+
+/******************************************************************************************************************************************************
+  queueMove()
+******************************************************************************************************************************************************/
+/*! \brief          queue relative move
+ *  \details        the move starts and ends at standstill. The number of steps of the ramps is calculated here, if the
+ *                  move is too short to reach the speed, the speed profile is a triangle. The first move starts at once.
+ *  \param[in]      Steps                       number of steps, negative steps are reverse
+ *  \param[in]      Speed                       cruise speed in steps/s
+ *  \return         E_OK
+ *                  E_NOT_OK if the queue is full or a parameter is out of range
+ *  \pre            Acceleration has to be set
+ *****************************************************************************************************************************************************/
+stdReturnType Stepper::queueMove(int32_t Steps, uint16_t Speed)
+{
+    stdReturnType ReturnValue = E_NOT_OK;
+    byte Head = QueueHead;
+    byte NextHead = (Head + 1u) & STEPPER_QUEUE_MASK;
+    MoveType* NewMove = &Queue[Head];
+    uint32_t Intervals;
+    uint32_t AccelerationSteps;
+    uint32_t DecelerationSteps;
+    uint32_t StartTicks;
+
+    if((STATE_INIT != State) && (Acceleration > 0u) && (Steps != 0) && (Speed >= STEPPER_MIN_SPEED) && (Speed <= STEPPER_MAX_SPEED) &&
+       (NextHead != QueueTail)) {
+        ReturnValue = E_OK;
+        NewMove->Reverse = (Steps < 0);
+        NewMove->Steps = (Steps < 0) ? -Steps : Steps;
+        NewMove->CruisePeriod = ((STEPPER_TICK_FREQUENCY << 8) / Speed) << 8;
+        /* first interval from standstill F / sqrt(2 * a), the square root is scaled by 64 */
+        StartTicks = (STEPPER_TICK_FREQUENCY << 6) / squareRoot((Acceleration << 1) << 12);
+        if(StartTicks > 0xFFFFu) StartTicks = 0xFFFFu;
+        NewMove->StartPeriod = StartTicks << 16;
+        if(NewMove->StartPeriod < NewMove->CruisePeriod) NewMove->StartPeriod = NewMove->CruisePeriod;
+        /* steps of the ramps v^2 / (2 * a), shortened in the ratio of the ramps if the speed is not reached */
+        Intervals = NewMove->Steps - 1u;
+        AccelerationSteps = ((uint32_t) Speed * Speed) / (Acceleration << 1);
+        DecelerationSteps = ((uint32_t) Speed * Speed) / (Deceleration << 1);
+        if((AccelerationSteps + DecelerationSteps) > Intervals) {
+            AccelerationSteps = ((uint64_t) Intervals * AccelerationSteps) / (AccelerationSteps + DecelerationSteps);
+            DecelerationSteps = Intervals - AccelerationSteps;
+        }
+        NewMove->AccelerationSteps = AccelerationSteps;
+        NewMove->DecelerationStart = NewMove->Steps - DecelerationSteps;
+        QueueHead = NextHead;
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            if(STATE_READY == State) {
+                loadMove();
+                writePeriod();
+                if(E_OK == Timer1.start()) State = STATE_RUNNING;
+            }
+        }
+    }
+    return ReturnValue;
+} /* queueMove */
+
+
+/******************************************************************************************************************************************************
+  stop()
+******************************************************************************************************************************************************/
+/*! \brief          stop at once
+ *  \details        Timer1 is stopped without deceleration and all queued moves are dropped, the position is kept
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void Stepper::stop()
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        if(STATE_RUNNING == State) {
+            Timer1.stop();
+            State = STATE_READY;
+        }
+        QueueTail = QueueHead;
+    }
+} /* stop */
+
+
+/******************************************************************************************************************************************************
+  stepInterrupt()
+******************************************************************************************************************************************************/
+/*! \brief          output step and program the next step interval
+ *  \details        this function is called by the compare interrupt right after BOTTOM. The step pin is high while the
+ *                  next interval is calculated, so the pulse width is the run time of the calculation. In the ramps the
+ *                  interval follows the recurrence p' = p * (1 + q + 1.5 * q^2) with q = -+a / F^2 * p^2, which needs
+ *                  four 32 bit multiplications and no division, at cruise speed nothing is calculated. The next move
+ *                  is loaded after the last step, so its direction is set one interval before its first step.
+ *                  The step interval should be longer than the run time, see StepperBenchmark of the host simulator.
+ *                  A late step is output at once by Timer1.setPeriodTicks().
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void Stepper::stepInterrupt()
+{
+    writeStep();
+    Step++;
+    StepCount++;
+    if(Move.Reverse) Position--;
+    else Position++;
+    if(Step < Move.Steps) {
+        if(Step <= Move.AccelerationSteps) {
+            Period = rampPeriod(Period, AccelerationFactor, true);
+            if(Period < Move.CruisePeriod) Period = Move.CruisePeriod;
+        } else if(Step >= Move.DecelerationStart) {
+            Period = rampPeriod(Period, DecelerationFactor, false);
+        } else {
+            Period = Move.CruisePeriod;
+        }
+        writePeriod();
+    } else if(QueueHead != QueueTail) {
+        loadMove();
+        writePeriod();
+    } else {
+        Timer1.stop();
+        State = STATE_READY;
+    }
+    writeStep();
+} /* stepInterrupt */
+
+
+/******************************************************************************************************************************************************
+  stepCallback()
+******************************************************************************************************************************************************/
+/*! \brief          Timer1 compare callback
+ *  \details
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void Stepper::stepCallback()
+{
+    StepperMotor.stepInterrupt();
+} /* stepCallback */
+
+
+/******************************************************************************************************************************************************
+ * P R I V A T E   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  multiplyHigh()
+******************************************************************************************************************************************************/
+/*! \brief          upper 32 bit of a 32 x 32 bit multiplication
+ *  \details        built of four 16 x 16 bit multiplications, so no 64 bit arithmetic is needed
+ *
+ *  \param[in]      A                           first factor
+ *  \param[in]      B                           second factor
+ *  \return         (A * B) >> 32
+ *****************************************************************************************************************************************************/
+uint32_t Stepper::multiplyHigh(uint32_t A, uint32_t B)
+{
+    uint16_t AHigh = A >> 16;
+    uint16_t ALow = A;
+    uint16_t BHigh = B >> 16;
+    uint16_t BLow = B;
+    uint32_t Middle = (uint32_t) AHigh * BLow + (((uint32_t) ALow * BLow) >> 16);
+    uint32_t Middle2 = (uint32_t) ALow * BHigh + (Middle & 0xFFFFu);
+
+    return (uint32_t) AHigh * BHigh + (Middle >> 16) + (Middle2 >> 16);
+} /* multiplyHigh */
+
+
+/******************************************************************************************************************************************************
+  rampPeriod()
+******************************************************************************************************************************************************/
+/*! \brief          next step interval of a ramp
+ *  \details        q is limited to 0.5, where the series is still monotonic. Deceleration stops at the longest interval.
+ *
+ *  \param[in]      sPeriod                     step interval in ticks, 16.16 fixed point
+ *  \param[in]      Factor                      ramp factor a / F^2 * 2^56
+ *  \param[in]      Accelerate                  true to shorten the interval
+ *  \return         next step interval
+ *****************************************************************************************************************************************************/
+uint32_t Stepper::rampPeriod(uint32_t sPeriod, uint32_t Factor, boolean Accelerate)
+{
+    uint32_t Ratio;
+    uint32_t Square;
+    uint32_t Delta;
+
+    /* q * 2^24 */
+    Ratio = multiplyHigh(Factor, multiplyHigh(sPeriod, sPeriod));
+    if(Ratio >= (1uL << 23)) Ratio = 1uL << 31;
+    else Ratio <<= 8;
+    /* 1.5 * q^2 */
+    Square = multiplyHigh(Ratio, Ratio);
+    Square += Square >> 1;
+    if(Accelerate) {
+        Delta = multiplyHigh(sPeriod, Ratio - Square);
+        sPeriod -= Delta;
+    } else {
+        Delta = multiplyHigh(sPeriod, Ratio + Square);
+        sPeriod = (Delta < (0xFFFF0000uL - sPeriod)) ? (sPeriod + Delta) : 0xFFFF0000uL;
+    }
+    return sPeriod;
+} /* rampPeriod */
+
+
+/******************************************************************************************************************************************************
+  squareRoot()
+******************************************************************************************************************************************************/
+/*! \brief          integer square root
+ *  \details        bitwise, only used when a move is queued
+ *
+ *  \param[in]      Value                       radicand
+ *  \return         square root rounded down
+ *****************************************************************************************************************************************************/
+uint16_t Stepper::squareRoot(uint32_t Value)
+{
+    uint32_t Root = 0u;
+    uint32_t Bit = 1uL << 30;
+
+    while(Bit > Value) Bit >>= 2;
+    while(Bit != 0u) {
+        if(Value >= (Root + Bit)) {
+            Value -= Root + Bit;
+            Root = (Root >> 1) + Bit;
+        } else {
+            Root >>= 1;
+        }
+        Bit >>= 2;
+    }
+    return Root;
+} /* squareRoot */
+
+
+/******************************************************************************************************************************************************
+  loadMove()
+******************************************************************************************************************************************************/
+/*! \brief          take next move from the queue
+ *  \details        has to be called with interrupts disabled
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void Stepper::loadMove()
+{
+    Move = Queue[QueueTail];
+    QueueTail = (QueueTail + 1u) & STEPPER_QUEUE_MASK;
+    Step = 0u;
+    Period = Move.StartPeriod;
+    PeriodFraction = 0u;
+    writeDirection(Move.Reverse);
+} /* loadMove */
+
+
+/******************************************************************************************************************************************************
+  writePeriod()
+******************************************************************************************************************************************************/
+/*! \brief          program next step interval
+ *  \details        the fraction of the interval is carried to the next one, so the mean step rate is exact.
+ *                  The period of Timer1 is TOP + 1.
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void Stepper::writePeriod()
+{
+    uint32_t Sum = Period + PeriodFraction;
+
+    PeriodFraction = Sum;
+    Timer1.setPeriodTicks((Sum >> 16) - 1u);
+} /* writePeriod */
+
+
+/******************************************************************************************************************************************************
+  writeDirection()
+******************************************************************************************************************************************************/
+/*! \brief          set direction pin
+ *  \details        has to be called with interrupts disabled
+ *
+ *  \param[in]      Reverse                     direction pin is high in reverse direction
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void Stepper::writeDirection(boolean Reverse)
+{
+    if(PORT_B == DirectionPort) {
+        if(Reverse) PORTB |= DirectionMask;
+        else PORTB &= ~DirectionMask;
+    } else if(PORT_C == DirectionPort) {
+        if(Reverse) PORTC |= DirectionMask;
+        else PORTC &= ~DirectionMask;
+    } else {
+        if(Reverse) PORTD |= DirectionMask;
+        else PORTD &= ~DirectionMask;
+    }
+} /* writeDirection */
+
+
+/******************************************************************************************************************************************************
+  writeStep()
+******************************************************************************************************************************************************/
+/*! \brief          toggle step pin
+ *  \details        writing a one to PINx toggles the pin, other pins of the port are not touched
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void Stepper::writeStep()
+{
+    if(PORT_B == StepPort) PINB = StepMask;
+    else if(PORT_C == StepPort) PINC = StepMask;
+    else PIND = StepMask;
+} /* writeStep */
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
@@ -46,6 +46,44 @@ TimerOne::TimerOne()
 	State = TIMERONE_STATE_NONE;
 	TimerCompareCallback = NULL;
 	ClockSelectBitGroup = TIMERONE_REG_CS_NO_CLOCK;
+	Mode = TIMERONE_MODE_PERIODIC;
+	PeriodTicks = 0;
+	OverflowEpoch = 0;
+	OverflowEpochHigh = 0;
+	InterruptSequence = 0;
+	CompareDeadline = 0;
+	CompareArmed = false;
+#if (TIMERONE_INTERRUPT_COUNTER == STD_ON)
+	InterruptCounter = 0;
+	WakeupCounter = 0;
+#endif
+#if (TIMERONE_INPUT_CAPTURE == STD_ON)
+	CaptureHead = 0;
+	CaptureTail = 0;
+	CaptureOverruns = 0;
+	CaptureEdge = TIMERONE_CAPTURE_EDGE_RISING;
+#endif
+#if (TIMERONE_CALLBACK_PROFILER == STD_ON)
+	CallbackProfile.MaxDuration = 0;
+	CallbackProfile.Overruns = 0;
+	CallbackProfile.MissedPeriods = 0;
+#endif
+#if (TIMERONE_SERVO == STD_ON)
+	NumberOfServos = 0;
+	for(byte Port = 0; Port < TIMERONE_SERVO_NUMBER_OF_PORTS; Port++) ServoMask[Port] = 0;
+	ServoSchedules[0].Length = 0;
+	ServoSchedules[1].Length = 0;
+	ServoActive = &ServoSchedules[0];
+	ServoNext = NULL;
+	ServoEdgeIndex = TIMERONE_SERVO_FRAME_START;
+	ServosRunning = false;
+#endif
+#if (TIMERONE_TONE == STD_ON)
+#if (TIMERONE_TONE_DURATION == STD_ON)
+	ToneOverflows = 0;
+#endif
+	TonePlaying = false;
+#endif
 } /* TimerOne */
 
 
@@ -142,8 +180,9 @@ stdReturnType TimerOne::setPeriod(unsigned long Microseconds)
 			ClockSelectBitGroup = TIMERONE_REG_CS_PRESCALE_1024;
 			ReturnValue = E_NOT_OK;
 		}
-		/* ICR1 is TOP in mode 12: clear timer on compare match (CTC) */
-		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { ICR1 = TimerCycles; }
+		PeriodTicks = TimerCycles;
+		/* ICR1 is TOP in mode 12: clear timer on compare match (CTC), in tickless mode the counter runs up to MAX */
+		if(TIMERONE_MODE_PERIODIC == Mode) { ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { ICR1 = TimerCycles; } }
 
 		if(TIMERONE_STATE_RUNNING == State)
 		{
@@ -155,6 +194,670 @@ stdReturnType TimerOne::setPeriod(unsigned long Microseconds)
 } /* setPeriod */
 
 
+/******************************************************************************************************************************************************
+  setPeriodTicks()
+******************************************************************************************************************************************************/
+/*! \brief          set timer top value of periodic mode
+ *  \details        the prescaler is kept, so only ICR1 is written. It should be called by the compare callback right
+ *                  after BOTTOM. If the counter already passed the new top value, it is set just below it, so the next
+ *                  compare interrupt follows at once instead of after a counter overflow.
+ *  \param[in]      Ticks						timer top value, period is Ticks + 1 timer cycles
+ *  \return         -
+ *  \pre			Timer has to be in periodic mode
+ *****************************************************************************************************************************************************/
+void TimerOne::setPeriodTicks(unsigned int Ticks)
+{
+	PeriodTicks = Ticks;
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		/* an interrupted nowTicks() has to read again, the TEMP register is overwritten */
+		InterruptSequence++;
+		ICR1 = Ticks;
+		if(Ticks > 0 && TCNT1 >= Ticks) TCNT1 = Ticks - 1;
+	}
+} /* setPeriodTicks */
+
+
+/******************************************************************************************************************************************************
+  setMode()
+******************************************************************************************************************************************************/
+/*! \brief          set mode of the compare interrupt
+ *  \details        in periodic mode the counter is cleared on compare match and the interrupt occurs every period.
+ *                  In tickless mode the counter runs free up to MAX, an overflow epoch extends it to 32 bit and the
+ *                  compare interrupt only occurs at the deadline given by setCompare(), so no interrupt occurs while
+ *                  nothing is due.
+ *  \param[in]      sMode						mode of the compare interrupt
+ *  \return         E_OK
+ *                  E_NOT_OK					tickless mode is requested but TIMERONE_TICKLESS is STD_OFF
+ *  \pre			Timer has to be in READY or STOPPED STATE
+ *****************************************************************************************************************************************************/
+stdReturnType TimerOne::setMode(TimerOneModeType sMode)
+{
+#if (TIMERONE_TICKLESS == STD_OFF)
+	/* overflow interrupt is not compiled */
+	if(TIMERONE_MODE_TICKLESS == sMode) return E_NOT_OK;
+#endif
+	if(TIMERONE_STATE_READY == State || TIMERONE_STATE_STOPPED == State) {
+		Mode = sMode;
+		if(TIMERONE_MODE_TICKLESS == Mode) {
+			/* set mode 0: normal, counter runs up to MAX */
+			writeBit(TCCR1B, WGM12, 0);
+			writeBit(TCCR1B, WGM13, 0);
+		} else {
+			/* set mode 12: clear timer on compare match (CTC) */
+			writeBit(TCCR1B, WGM12, 1);
+			writeBit(TCCR1B, WGM13, 1);
+			ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { ICR1 = PeriodTicks; }
+		}
+		return E_OK;
+	} else {
+		return E_NOT_OK;
+	}
+} /* setMode */
+
+
+/******************************************************************************************************************************************************
+  setClockSource()
+******************************************************************************************************************************************************/
+/*! \brief          set clock of the counter
+ *  \details        the clock is applied by start(). With an external clock the counter counts edges on the T1 pin
+ *                  without any interrupt, in tickless mode getTicks() returns the number of edges extended by the
+ *                  overflow epoch. The external clock is sampled by the cpu clock, so it has to be below F_CPU / 2.5.
+ *                  setPeriod() selects a prescaler again.
+ *  \param[in]      ClockSelect				prescaler or external clock
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre			Timer has to be in READY or STOPPED STATE
+ *****************************************************************************************************************************************************/
+stdReturnType TimerOne::setClockSource(TimerOneClockSelectType ClockSelect)
+{
+	if((TIMERONE_STATE_READY == State || TIMERONE_STATE_STOPPED == State) && ClockSelect != TIMERONE_REG_CS_NO_CLOCK &&
+	   ClockSelect <= TIMERONE_REG_CS_EXTERNAL_RISING) {
+		ClockSelectBitGroup = ClockSelect;
+		return E_OK;
+	} else {
+		return E_NOT_OK;
+	}
+} /* setClockSource */
+
+
+/******************************************************************************************************************************************************
+  getTicks()
+******************************************************************************************************************************************************/
+/*! \brief          read free running counter
+ *  \details        this function returns the counter value extended by the overflow epoch, it is only meaningful
+ *                  in tickless mode
+ *  \return         timer cycles since start
+ *****************************************************************************************************************************************************/
+unsigned long TimerOne::getTicks()
+{
+	unsigned long Ticks;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { Ticks = readTicks(); }
+	return Ticks;
+} /* getTicks */
+
+
+/******************************************************************************************************************************************************
+  nowTicks()
+******************************************************************************************************************************************************/
+/*! \brief          read 64 bit timestamp
+ *  \details        this function returns the counter value extended by the 48 bit overflow epoch, it is only meaningful
+ *                  in tickless mode. Interrupts are not disabled, the read is repeated if a Timer1 interrupt or an
+ *                  access to the 16 bit registers by TimerOne from another interrupt occurred in between, because both
+ *                  increment the interrupt sequence. One tick lasts the prescaler value in CPU cycles.
+ *  \return         timer cycles since start
+ *  \pre			other interrupts may only access the Timer1 16 bit registers by getTicks(), nowTicks(),
+ *                  setCompare(), setPeriodTicks(), tone() and noTone()
+ *****************************************************************************************************************************************************/
+unsigned long long TimerOne::nowTicks()
+{
+	byte Sequence;
+	unsigned int CounterValue;
+	unsigned long long Epoch;
+
+	do {
+		Sequence = InterruptSequence;
+		CounterValue = TCNT1;
+		Epoch = ((unsigned long long) OverflowEpochHigh << TIMERONE_NUMBER_OF_BITS) | OverflowEpoch;
+		/* counter wrapped around but overflow interrupt is still pending, e.g. called with interrupts disabled */
+		if((TIFR1 & (1 << TOV1)) && CounterValue < (TIMERONE_RESOLUTION / 2)) Epoch++;
+	} while(Sequence != InterruptSequence);
+	/* called from an interrupt, a nowTicks() which was interrupted has to read again */
+	if(0 == (SREG & (1 << SREG_I))) InterruptSequence++;
+	return (Epoch << TIMERONE_NUMBER_OF_BITS) | CounterValue;
+} /* nowTicks */
+
+
+/******************************************************************************************************************************************************
+  setCompare()
+******************************************************************************************************************************************************/
+/*! \brief          set deadline of the next compare interrupt
+ *  \details        this function arms a single compare interrupt at the given counter value of the free running counter.
+ *                  Deadlines more than one counter cycle ahead are armed by the overflow interrupt of the epoch before.
+ *  \param[in]      Ticks						counter value of the deadline, see getTicks()
+ *  \return         E_OK
+ *                  E_NOT_OK					deadline has already passed or timer is not running in tickless mode
+ *  \pre			Timer has to be in RUNNING STATE and in tickless mode
+ *****************************************************************************************************************************************************/
+stdReturnType TimerOne::setCompare(unsigned long Ticks)
+{
+	stdReturnType ReturnValue = E_NOT_OK;
+
+	if(TIMERONE_STATE_RUNNING == State && TIMERONE_MODE_TICKLESS == Mode) {
+		ReturnValue = E_OK;
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+			writeBit(TIMSK1, OCIE1A, 0);
+			CompareDeadline = Ticks;
+			CompareArmed = true;
+			/* deadline is within the next counter cycle, otherwise it is armed by overflow interrupt */
+			if((long) (CompareDeadline - readTicks()) < (long) TIMERONE_RESOLUTION) {
+				if(E_NOT_OK == armCompare()) {
+					CompareArmed = false;
+					ReturnValue = E_NOT_OK;
+				}
+			}
+		}
+	}
+	return ReturnValue;
+} /* setCompare */
+
+
+#if (TIMERONE_INTERRUPT_COUNTER == STD_ON)
+/******************************************************************************************************************************************************
+  getInterruptCounter()
+******************************************************************************************************************************************************/
+/*! \brief          read number of Timer1 interrupts
+ *  \details        counts compare and overflow interrupts
+ *
+ *  \return         number of interrupts since last clear
+ *****************************************************************************************************************************************************/
+unsigned long TimerOne::getInterruptCounter()
+{
+	unsigned long Counter;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { Counter = InterruptCounter; }
+	return Counter;
+} /* getInterruptCounter */
+
+
+/******************************************************************************************************************************************************
+  getWakeupCounter()
+******************************************************************************************************************************************************/
+/*! \brief          read number of compare callback calls
+ *  \details        counts the interrupts where work was due
+ *
+ *  \return         number of wakeups since last clear
+ *****************************************************************************************************************************************************/
+unsigned long TimerOne::getWakeupCounter()
+{
+	unsigned long Counter;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { Counter = WakeupCounter; }
+	return Counter;
+} /* getWakeupCounter */
+
+
+/******************************************************************************************************************************************************
+  clearCounter()
+******************************************************************************************************************************************************/
+/*! \brief          clear interrupt and wakeup counter
+ *  \details
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerOne::clearCounter()
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		InterruptCounter = 0;
+		WakeupCounter = 0;
+	}
+} /* clearCounter */
+#endif
+
+
+#if (TIMERONE_LATENCY_HISTOGRAM == STD_ON)
+/******************************************************************************************************************************************************
+  getLatency()
+******************************************************************************************************************************************************/
+/*! \brief          read latency statistic of the compare interrupt
+ *  \details        latencies are in timer ticks, from the compare match to the entry of compareInterrupt()
+ *
+ *  \param[out]     Latency						copy of the statistic
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerOne::getLatency(LatencyHistogram& Latency)
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { Latency = CompareLatency; }
+} /* getLatency */
+
+
+/******************************************************************************************************************************************************
+  clearLatency()
+******************************************************************************************************************************************************/
+/*! \brief          clear latency statistic of the compare interrupt
+ *  \details
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerOne::clearLatency()
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { CompareLatency.clear(); }
+} /* clearLatency */
+#endif
+
+
+#if (TIMERONE_CALLBACK_PROFILER == STD_ON)
+/******************************************************************************************************************************************************
+  getProfile()
+******************************************************************************************************************************************************/
+/*! \brief          read run time statistic of the compare callback
+ *  \details
+ *
+ *  \param[out]     Profile						copy of the statistic
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerOne::getProfile(TimerOneProfileType* Profile)
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { *Profile = CallbackProfile; }
+} /* getProfile */
+
+
+/******************************************************************************************************************************************************
+  clearProfile()
+******************************************************************************************************************************************************/
+/*! \brief          clear run time statistic of the compare callback
+ *  \details
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerOne::clearProfile()
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		CallbackProfile.MaxDuration = 0;
+		CallbackProfile.Overruns = 0;
+		CallbackProfile.MissedPeriods = 0;
+	}
+} /* clearProfile */
+#endif
+
+
+#if (TIMERONE_INPUT_CAPTURE == STD_ON)
+/******************************************************************************************************************************************************
+  startCapture()
+******************************************************************************************************************************************************/
+/*! \brief          start timestamping edges on ICP1 (Arduino pin 8)
+ *  \details        every captured edge is stored into the ring buffer by the capture interrupt, it can be drained by
+ *                  readCapture() without waiting for the edges. Older captures are discarded.
+ *                  When both edges are captured the edge is switched in the interrupt, so pulses shorter than the
+ *                  interrupt latency are lost.
+ *  \param[in]      Edge						edges to capture
+ *  \param[in]      NoiseCanceler				filter input by four equal samples
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre			Timer has to be in tickless mode, because ICR1 is TOP in periodic mode
+ *****************************************************************************************************************************************************/
+stdReturnType TimerOne::startCapture(TimerOneCaptureEdgeType Edge, boolean NoiseCanceler)
+{
+	if(TIMERONE_MODE_TICKLESS == Mode && TIMERONE_STATE_NONE != State) {
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+			CaptureEdge = Edge;
+			CaptureHead = 0;
+			CaptureTail = 0;
+			CaptureOverruns = 0;
+			writeBit(TCCR1B, ICNC1, (NoiseCanceler ? 1 : 0));
+			writeBit(TCCR1B, ICES1, (TIMERONE_CAPTURE_EDGE_FALLING == Edge ? 0 : 1));
+			/* changing the edge may set the capture flag */
+			TIFR1 = (1 << ICF1);
+			writeBit(TIMSK1, ICIE1, 1);
+		}
+		return E_OK;
+	} else {
+		return E_NOT_OK;
+	}
+} /* startCapture */
+
+
+/******************************************************************************************************************************************************
+  stopCapture()
+******************************************************************************************************************************************************/
+/*! \brief          stop timestamping edges on ICP1
+ *  \details        captures already in the buffer can still be read
+ *                  
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerOne::stopCapture()
+{
+	writeBit(TIMSK1, ICIE1, 0);
+} /* stopCapture */
+
+
+/******************************************************************************************************************************************************
+  readCapture()
+******************************************************************************************************************************************************/
+/*! \brief          read captured edges
+ *  \details        copies up to Length captures from the ring buffer, oldest first. Interrupts are not disabled, the
+ *                  capture interrupt only writes the head and the reader only writes the tail of the buffer.
+ *  \param[out]     Captures					buffer for the captured edges
+ *  \param[in]      Length						size of Captures
+ *  \return         number of captures read
+ *****************************************************************************************************************************************************/
+byte TimerOne::readCapture(TimerOneCaptureType* Captures, byte Length)
+{
+	byte Tail = CaptureTail;
+	byte Head = CaptureHead;
+	byte Count = 0;
+
+	while(Tail != Head && Count < Length) {
+		Captures[Count++] = CaptureBuffer[Tail];
+		Tail = (Tail + 1) & TIMERONE_CAPTURE_BUFFER_MASK;
+	}
+	/* release the read entries to the capture interrupt */
+	CaptureTail = Tail;
+	return Count;
+} /* readCapture */
+
+
+/******************************************************************************************************************************************************
+  getCaptureOverruns()
+******************************************************************************************************************************************************/
+/*! \brief          get number of edges discarded because of a full buffer
+ *  \details        
+ *                  
+ *  \return         number of discarded edges
+ *****************************************************************************************************************************************************/
+unsigned int TimerOne::getCaptureOverruns()
+{
+	unsigned int Overruns;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { Overruns = CaptureOverruns; }
+	return Overruns;
+} /* getCaptureOverruns */
+#endif
+
+#if (TIMERONE_SERVO == STD_ON)
+/******************************************************************************************************************************************************
+  attachServo()
+******************************************************************************************************************************************************/
+/*! \brief          add port pin as servo channel
+ *  \details        the pin is set to output low. Channels are numbered in the order they are attached, their pulse
+ *                  width is the center of the pulse width limits until it is set.
+ *  \param[in]      Port						port of the pin
+ *  \param[in]      Bit						bit of the pin in the port register
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre			Servos must not be running
+ *****************************************************************************************************************************************************/
+stdReturnType TimerOne::attachServo(TimerOneServoPortType Port, byte Bit)
+{
+	stdReturnType ReturnValue = E_NOT_OK;
+	byte PinMask;
+
+	if(!ServosRunning && NumberOfServos < TIMERONE_SERVO_MAX_CHANNELS && Port < TIMERONE_SERVO_NUMBER_OF_PORTS && Bit < 8) {
+		PinMask = 1 << Bit;
+		/* pin is already a servo? */
+		if((ServoMask[Port] & PinMask) == 0) {
+			ReturnValue = E_OK;
+			Servos[NumberOfServos].Port = Port;
+			Servos[NumberOfServos].Mask = PinMask;
+			Servos[NumberOfServos].Pulse = (TIMERONE_SERVO_MIN_PULSE + TIMERONE_SERVO_MAX_PULSE) / 2;
+			NumberOfServos++;
+			ServoMask[Port] |= PinMask;
+			ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+				if(TIMERONE_SERVO_PORT_B == Port) {
+					PORTB &= ~PinMask;
+					DDRB |= PinMask;
+				} else if(TIMERONE_SERVO_PORT_C == Port) {
+					PORTC &= ~PinMask;
+					DDRC |= PinMask;
+				} else {
+					PORTD &= ~PinMask;
+					DDRD |= PinMask;
+				}
+			}
+		}
+	}
+	return ReturnValue;
+} /* attachServo */
+
+
+/******************************************************************************************************************************************************
+  setServoPulse()
+******************************************************************************************************************************************************/
+/*! \brief          set pulse width of a servo
+ *  \details        the pulse width is applied by the next updateServos(), so several servos move in the same frame
+ *
+ *  \param[in]      Channel					number of servo
+ *  \param[in]      Microseconds				pulse width
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *****************************************************************************************************************************************************/
+stdReturnType TimerOne::setServoPulse(byte Channel, unsigned int Microseconds)
+{
+	if(Channel < NumberOfServos && Microseconds >= TIMERONE_SERVO_MIN_PULSE && Microseconds <= TIMERONE_SERVO_MAX_PULSE) {
+		Servos[Channel].Pulse = Microseconds;
+		return E_OK;
+	} else {
+		return E_NOT_OK;
+	}
+} /* setServoPulse */
+
+
+/******************************************************************************************************************************************************
+  updateServos()
+******************************************************************************************************************************************************/
+/*! \brief          apply pulse widths of all servos
+ *  \details        the pulse ends are sorted into the free schedule buffer, servos with the same pulse width share one
+ *                  interrupt. While the servos are running the schedule is taken over at the next frame start, so all
+ *                  pulses of a frame belong to the same update. Has to be called again after the period was changed.
+ *  \return         E_OK
+ *                  E_NOT_OK if the last update is still pending or a pulse does not fit into the period
+ *  \pre			Timer has to be initialized in periodic mode
+ *****************************************************************************************************************************************************/
+stdReturnType TimerOne::updateServos()
+{
+	stdReturnType ReturnValue = E_NOT_OK;
+	TimerOneServoScheduleType* Schedule;
+
+	if(State != TIMERONE_STATE_NONE && TIMERONE_MODE_PERIODIC == Mode && !isServoUpdatePending()) {
+		Schedule = (ServoActive == &ServoSchedules[0]) ? &ServoSchedules[1] : &ServoSchedules[0];
+		if(E_OK == buildServoSchedule(Schedule)) {
+			ReturnValue = E_OK;
+			if(ServosRunning) ServoNext = Schedule;
+			else ServoActive = Schedule;
+		}
+	}
+	return ReturnValue;
+} /* updateServos */
+
+
+/******************************************************************************************************************************************************
+  startServos()
+******************************************************************************************************************************************************/
+/*! \brief          start servo pulses
+ *  \details        the first frame starts at the next BOTTOM, all servos go high at BOTTOM. The compare callback is
+ *                  called first at BOTTOM, its run time shortens the pulses, so it should be short.
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre			updateServos() has to be called before
+ *****************************************************************************************************************************************************/
+stdReturnType TimerOne::startServos()
+{
+	if(!ServosRunning && TIMERONE_MODE_PERIODIC == Mode && ServoActive->Length > 0) {
+		ServoEdgeIndex = TIMERONE_SERVO_FRAME_START;
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+			/* compare match at BOTTOM starts the frame */
+			OCR1B = 0;
+			TIFR1 = (1 << OCF1B);
+			writeBit(TIMSK1, OCIE1B, 1);
+			ServosRunning = true;
+		}
+		return E_OK;
+	} else {
+		return E_NOT_OK;
+	}
+} /* startServos */
+
+
+/******************************************************************************************************************************************************
+  stopServos()
+******************************************************************************************************************************************************/
+/*! \brief          stop servo pulses
+ *  \details        all servo pins are set low at once, so a running pulse is cut. A pending update is taken over.
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerOne::stopServos()
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		writeBit(TIMSK1, OCIE1B, 0);
+		PORTB &= ~ServoMask[TIMERONE_SERVO_PORT_B];
+		PORTC &= ~ServoMask[TIMERONE_SERVO_PORT_C];
+		PORTD &= ~ServoMask[TIMERONE_SERVO_PORT_D];
+		if(ServoNext != NULL) {
+			ServoActive = ServoNext;
+			ServoNext = NULL;
+		}
+		ServosRunning = false;
+	}
+} /* stopServos */
+
+
+/******************************************************************************************************************************************************
+  isServoUpdatePending()
+******************************************************************************************************************************************************/
+/*! \brief          check for pending servo update
+ *  \details        an update is pending until the next frame start
+ *
+ *  \return         true if the last update was not taken over yet
+ *****************************************************************************************************************************************************/
+boolean TimerOne::isServoUpdatePending()
+{
+	boolean Pending;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { Pending = (ServoNext != NULL); }
+	return Pending;
+} /* isServoUpdatePending */
+#endif
+
+
+#if (TIMERONE_TONE == STD_ON)
+/******************************************************************************************************************************************************
+  tone()
+******************************************************************************************************************************************************/
+/*! \brief          play square wave on OC1A
+ *  \details        the counter runs in mode 12 with TOP of half a period and OC1A toggles on each compare match, so the
+ *                  waveform is generated by hardware without any Timer1 interrupt. With TIMERONE_TONE_DURATION a
+ *                  duration is counted by Timer2 with prescaler 1024: the first overflow is preloaded with the
+ *                  remainder, then only one interrupt occurs every 256 Timer2 ticks (16.4 ms at 16 MHz), independent
+ *                  of the frequency. A playing tone is changed at once, so melodies need no noTone() in between.
+ *  \param[in]      Frequency					frequency in Hz
+ *  \param[in]      Milliseconds				duration of the tone, 0 plays until noTone()
+ *  \return         E_OK
+ *                  E_NOT_OK, also for a duration without TIMERONE_TONE_DURATION
+ *  \pre			Timer has to be in periodic mode and in READY or STOPPED STATE or playing a tone,
+ *                  Timer2 must not be used by someone else while a tone with duration is played
+ *****************************************************************************************************************************************************/
+stdReturnType TimerOne::tone(unsigned int Frequency, unsigned long Milliseconds)
+{
+	TimerOneClockSelectType ToneClockSelect;
+	unsigned long TimerCycles;
+#if (TIMERONE_TONE_DURATION == STD_ON)
+	unsigned long Ticks;
+	unsigned int FirstTicks;
+#else
+	/* the duration needs the Timer2 overflow interrupt */
+	if(Milliseconds > 0) return E_NOT_OK;
+#endif
+
+	if((TIMERONE_STATE_READY == State || TIMERONE_STATE_STOPPED == State || TonePlaying) && TIMERONE_MODE_PERIODIC == Mode &&
+	   Frequency > 0 && Frequency <= (F_CPU / 2)) {
+		/* timer cycles of half a period rounded to nearest, same ladder as setPeriod() */
+		TimerCycles = (F_CPU + Frequency) / (2UL * Frequency);
+		if(TimerCycles <= TIMERONE_RESOLUTION)              ToneClockSelect = TIMERONE_REG_CS_NO_PRESCALER;
+		else if((TimerCycles >>= 3) <= TIMERONE_RESOLUTION) ToneClockSelect = TIMERONE_REG_CS_PRESCALE_8;
+		else if((TimerCycles >>= 3) <= TIMERONE_RESOLUTION) ToneClockSelect = TIMERONE_REG_CS_PRESCALE_64;
+		else if((TimerCycles >>= 2) <= TIMERONE_RESOLUTION) ToneClockSelect = TIMERONE_REG_CS_PRESCALE_256;
+		else {
+			TimerCycles >>= 2;
+			ToneClockSelect = TIMERONE_REG_CS_PRESCALE_1024;
+		}
+#if (TIMERONE_TONE_DURATION == STD_ON)
+		/* Timer2 ticks of the duration, split so the product cannot overflow */
+		Ticks = (Milliseconds / 1000) * TIMERONE_TONE_TICK_FREQUENCY + ((Milliseconds % 1000) * TIMERONE_TONE_TICK_FREQUENCY) / 1000;
+		if(0 == Ticks) Ticks = 1;
+		FirstTicks = Ticks & 0xFF;
+		if(0 == FirstTicks) FirstTicks = 256;
+#endif
+
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+#if (TIMERONE_TONE_DURATION == STD_ON)
+			/* stop duration of the previous tone */
+			TCCR2B = 0;
+			writeBit(TIMSK2, TOIE2, 0);
+#endif
+			/* stop counter and compare interrupts, OC1A toggles when the counter is cleared at TOP */
+			writeBitGroup(TCCR1B, TIMERONE_REG_CS_GM, TIMERONE_REG_CS_GP, TIMERONE_REG_CS_NO_CLOCK);
+			writeBit(TIMSK1, OCIE1A, 0);
+			ICR1 = TimerCycles - 1;
+			OCR1A = 0;
+			TCNT1 = 0;
+			writeBit(TCCR1A, COM1A1, 0);
+			writeBit(TCCR1A, COM1A0, 1);
+			pinMode(TIMERONE_TONE_PIN, OUTPUT);
+#if (TIMERONE_TONE_DURATION == STD_ON)
+			if(Milliseconds > 0) {
+				ToneOverflows = (Ticks - FirstTicks) >> 8;
+				/* set Timer2 to normal mode with prescaler 1024 */
+				TCCR2A = 0;
+				TCNT2 = 256 - FirstTicks;
+				TIFR2 = (1 << TOV2);
+				writeBit(TIMSK2, TOIE2, 1);
+				TCCR2B = (1 << CS22) | (1 << CS21) | (1 << CS20);
+			}
+#endif
+			/* start counter by setting clock select register */
+			writeBitGroup(TCCR1B, TIMERONE_REG_CS_GM, TIMERONE_REG_CS_GP, ToneClockSelect);
+			InterruptSequence++;
+			TonePlaying = true;
+			State = TIMERONE_STATE_RUNNING;
+		}
+		return E_OK;
+	} else {
+		return E_NOT_OK;
+	}
+} /* tone */
+
+
+/******************************************************************************************************************************************************
+  noTone()
+******************************************************************************************************************************************************/
+/*! \brief          stop square wave on OC1A
+ *  \details        OC1A is disconnected and the pin is set low. The period of the timer is restored, start() runs
+ *                  the timer with it again. The end of a duration calls it from the Timer2 overflow interrupt, so the
+ *                  interrupt sequence is incremented like by the other 16 bit register accesses.
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerOne::noTone()
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		if(TonePlaying) {
+#if (TIMERONE_TONE_DURATION == STD_ON)
+			TCCR2B = 0;
+			writeBit(TIMSK2, TOIE2, 0);
+#endif
+			writeBitGroup(TCCR1B, TIMERONE_REG_CS_GM, TIMERONE_REG_CS_GP, TIMERONE_REG_CS_NO_CLOCK);
+			writeBit(TCCR1A, COM1A0, 0);
+			digitalWrite(TIMERONE_TONE_PIN, LOW);
+			ICR1 = PeriodTicks;
+			InterruptSequence++;
+			TonePlaying = false;
+			State = TIMERONE_STATE_STOPPED;
+		}
+	}
+} /* noTone */
+#endif
+
+
 /******************************************************************************************************************************************************
   start()
 ******************************************************************************************************************************************************/
@@ -170,10 +873,18 @@ stdReturnType TimerOne::start()
 	if(TIMERONE_STATE_READY == State || TIMERONE_STATE_STOPPED == State) {
 		/* reset counter value */
 		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { TCNT1 = 0; }
+		if(TIMERONE_MODE_TICKLESS == Mode) {
+			OverflowEpoch = 0;
+			OverflowEpochHigh = 0;
+			CompareArmed = false;
+			/* clear pending overflow and enable overflow interrupt to count the epoch */
+			TIFR1 = (1 << TOV1);
+			writeBit(TIMSK1, TOIE1, 1);
+		}
 		/* start counter by setting clock select register */
 		writeBitGroup(TCCR1B, TIMERONE_REG_CS_GM, TIMERONE_REG_CS_GP, ClockSelectBitGroup);
-		/* set compare interrupt, if callback is set */
-		if(TimerCompareCallback != NULL) {
+		/* set compare interrupt, if callback is set, in tickless mode it is set by setCompare() */
+		if(TimerCompareCallback != NULL && TIMERONE_MODE_PERIODIC == Mode) {
 			/* enable timer compare interrupt */
 			writeBit(TIMSK1, OCIE1A, 1);
 		}
@@ -258,6 +969,7 @@ void TimerOne::detachInterrupt()
 {
 	/* clears the timer compare interrupt enable bit */
 	writeBit(TIMSK1, OCIE1A, 0);
+	CompareArmed = false;
 } /* detachInterrupt */
 
 
@@ -282,26 +994,7 @@ stdReturnType TimerOne::read(unsigned long* Microseconds)
 		ReturnValue = E_OK;
         /* save current timer value */
 		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { CounterValue = TCNT1; }
-		switch (ClockSelectBitGroup)
-		{
-			case TIMERONE_REG_CS_NO_PRESCALER:
-				PrescaleShiftScale = 0;
-				break;
-			case TIMERONE_REG_CS_PRESCALE_8:
-				PrescaleShiftScale = 3;
-				break;
-			case TIMERONE_REG_CS_PRESCALE_64:
-				PrescaleShiftScale = 6;
-				break;
-			case TIMERONE_REG_CS_PRESCALE_256:
-				PrescaleShiftScale = 8;
-				break;
-			case TIMERONE_REG_CS_PRESCALE_1024:
-				PrescaleShiftScale = 10;
-				break;
-			default:
-				ReturnValue = E_NOT_OK;
-		}
+		ReturnValue = getPrescaleShiftScale(&PrescaleShiftScale);
 		/* transform counter value to microseconds in an efficient way */
 		*Microseconds = ((CounterValue * 1000UL) / (F_CPU / 1000UL)) << PrescaleShiftScale;
 	}
@@ -309,13 +1002,415 @@ stdReturnType TimerOne::read(unsigned long* Microseconds)
 } /* read */
 
 
+/******************************************************************************************************************************************************
+  compareInterrupt()
+******************************************************************************************************************************************************/
+/*! \brief          handle timer compare interrupt
+ *  \details        this function is called by the compare interrupt, in tickless mode the compare interrupt is disarmed
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerOne::compareInterrupt()
+{
+#if (TIMERONE_LATENCY_HISTOGRAM == STD_ON)
+	unsigned int Counter = TCNT1;
+	unsigned int Compare = OCR1A;
+	unsigned int Latency = Counter - Compare;
+
+	/* in periodic mode the counter wraps at TOP (ICR1) instead of MAX */
+	if((TIMERONE_MODE_PERIODIC == Mode) && (Counter < Compare)) Latency += ICR1 + 1;
+	CompareLatency.add(Latency);
+#endif
+#if (TIMERONE_INTERRUPT_COUNTER == STD_ON)
+	InterruptCounter++;
+#endif
+	InterruptSequence++;
+	if(TIMERONE_MODE_TICKLESS == Mode) {
+		writeBit(TIMSK1, OCIE1A, 0);
+		CompareArmed = false;
+	}
+	wakeup();
+} /* compareInterrupt */
+
+
+#if (TIMERONE_TICKLESS == STD_ON)
+/******************************************************************************************************************************************************
+  overflowInterrupt()
+******************************************************************************************************************************************************/
+/*! \brief          handle timer overflow interrupt
+ *  \details        this function is called by the overflow interrupt in tickless mode, it counts the overflow epoch and
+ *                  arms the compare interrupt when the deadline lies within the next counter cycle
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerOne::overflowInterrupt()
+{
+#if (TIMERONE_INTERRUPT_COUNTER == STD_ON)
+	InterruptCounter++;
+#endif
+	InterruptSequence++;
+	OverflowEpoch++;
+	if(0 == OverflowEpoch) OverflowEpochHigh++;
+	if(CompareArmed && (TIMSK1 & (1 << OCIE1A)) == 0) {
+		if((long) (CompareDeadline - readTicks()) < (long) TIMERONE_RESOLUTION) {
+			if(E_NOT_OK == armCompare()) {
+				/* deadline passed while arming, so call it directly */
+				CompareArmed = false;
+				wakeup();
+			}
+		}
+	}
+} /* overflowInterrupt */
+#endif
+
+
+#if (TIMERONE_INPUT_CAPTURE == STD_ON)
+/******************************************************************************************************************************************************
+  captureInterrupt()
+******************************************************************************************************************************************************/
+/*! \brief          handle timer capture interrupt
+ *  \details        this function is called by the capture interrupt, it stores the captured edge into the ring buffer.
+ *                  The capture interrupt has a higher priority than the overflow interrupt, so a pending overflow
+ *                  is taken into account for the timestamp.
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerOne::captureInterrupt()
+{
+	unsigned int CaptureValue = ICR1;
+	unsigned int Epoch = OverflowEpoch;
+	boolean RisingEdge = (TCCR1B & (1 << ICES1)) != 0;
+	byte Head = CaptureHead;
+	byte NextHead = (Head + 1) & TIMERONE_CAPTURE_BUFFER_MASK;
+
+#if (TIMERONE_INTERRUPT_COUNTER == STD_ON)
+	InterruptCounter++;
+#endif
+	InterruptSequence++;
+	/* counter wrapped around before the edge but overflow interrupt is still pending */
+	if((TIFR1 & (1 << TOV1)) && CaptureValue < (TIMERONE_RESOLUTION / 2)) Epoch++;
+	if(TIMERONE_CAPTURE_EDGE_BOTH == CaptureEdge) {
+		/* capture the opposite edge next */
+		writeBit(TCCR1B, ICES1, (RisingEdge ? 0 : 1));
+		TIFR1 = (1 << ICF1);
+	}
+	if(NextHead != CaptureTail) {
+		CaptureBuffer[Head].Ticks = ((unsigned long) Epoch << TIMERONE_NUMBER_OF_BITS) | CaptureValue;
+		CaptureBuffer[Head].RisingEdge = RisingEdge;
+		CaptureHead = NextHead;
+	} else {
+		CaptureOverruns++;
+	}
+} /* captureInterrupt */
+#endif
+
+
+#if (TIMERONE_SERVO == STD_ON)
+/******************************************************************************************************************************************************
+  servoInterrupt()
+******************************************************************************************************************************************************/
+/*! \brief          handle timer compare B interrupt of the servos
+ *  \details        this function is called by the compare B interrupt. At BOTTOM all servo pins are set high, at
+ *                  each edge the pins of the servos with this pulse width are set low. Writing a one to PINx toggles
+ *                  the pin, so other pins of the port are not touched. If the counter reached the next edge before
+ *                  its compare value was written, the edge is applied at once, so pulses close together end in the
+ *                  same interrupt and no edge is missed.
+ *                  A frame of N servos with distinct pulse widths takes N + 1 interrupts. Pulse ends closer than the
+ *                  interrupt run time chain in one interrupt, so its run time grows with the number of servos. The
+ *                  cycles per channel count are measured by ServoBenchmark of the host simulator.
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerOne::servoInterrupt()
+{
+	const TimerOneServoEdgeType* Edge;
+	unsigned int LastTicks;
+	unsigned int NextTicks;
+	unsigned int CounterValue;
+
+#if (TIMERONE_INTERRUPT_COUNTER == STD_ON)
+	InterruptCounter++;
+#endif
+	InterruptSequence++;
+	for(;;) {
+		if(ServoEdgeIndex != TIMERONE_SERVO_FRAME_START) {
+			Edge = &ServoActive->Edges[ServoEdgeIndex++];
+			PINB = Edge->Toggle[TIMERONE_SERVO_PORT_B];
+			PINC = Edge->Toggle[TIMERONE_SERVO_PORT_C];
+			PIND = Edge->Toggle[TIMERONE_SERVO_PORT_D];
+			LastTicks = Edge->Ticks;
+		} else {
+			/* all pins are low, take over pending schedule */
+			if(ServoNext != NULL) {
+				ServoActive = ServoNext;
+				ServoNext = NULL;
+			}
+			PINB = ServoMask[TIMERONE_SERVO_PORT_B];
+			PINC = ServoMask[TIMERONE_SERVO_PORT_C];
+			PIND = ServoMask[TIMERONE_SERVO_PORT_D];
+			ServoEdgeIndex = 0;
+			LastTicks = 0;
+		}
+		if(ServoEdgeIndex < ServoActive->Length) {
+			NextTicks = ServoActive->Edges[ServoEdgeIndex].Ticks;
+		} else {
+			/* next edge is the frame start at BOTTOM */
+			ServoEdgeIndex = TIMERONE_SERVO_FRAME_START;
+			NextTicks = 0;
+		}
+		OCR1B = NextTicks;
+		CounterValue = TCNT1;
+		/* compare match is still ahead, if the counter did not pass TOP and did not reach the next edge */
+		if(CounterValue >= LastTicks && (0 == NextTicks || CounterValue < NextTicks)) break;
+		/* edge is due, a compare match raised by the write is dropped */
+		TIFR1 = (1 << OCF1B);
+	}
+} /* servoInterrupt */
+#endif
+
+
+#if (TIMERONE_TONE_DURATION == STD_ON)
+/******************************************************************************************************************************************************
+  toneInterrupt()
+******************************************************************************************************************************************************/
+/*! \brief          count duration of the tone
+ *  \details        this function is called by the Timer2 overflow interrupt, the tone is stopped at the last overflow
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerOne::toneInterrupt()
+{
+	if(ToneOverflows > 0) ToneOverflows--;
+	else noTone();
+} /* toneInterrupt */
+#endif
+
+
+/******************************************************************************************************************************************************
+ * P R I V A T E   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  getPrescaleShiftScale()
+******************************************************************************************************************************************************/
+/*! \brief          get prescaler as power of two
+ *  \details
+ *
+ *  \param[out]     PrescaleShiftScale		prescaler of the selected clock
+ *  \return         E_OK
+ *                  E_NOT_OK if no clock is selected
+ *****************************************************************************************************************************************************/
+stdReturnType TimerOne::getPrescaleShiftScale(char* PrescaleShiftScale) const
+{
+	stdReturnType ReturnValue = E_OK;
+
+	switch (ClockSelectBitGroup)
+	{
+		case TIMERONE_REG_CS_NO_PRESCALER:
+			*PrescaleShiftScale = 0;
+			break;
+		case TIMERONE_REG_CS_PRESCALE_8:
+			*PrescaleShiftScale = 3;
+			break;
+		case TIMERONE_REG_CS_PRESCALE_64:
+			*PrescaleShiftScale = 6;
+			break;
+		case TIMERONE_REG_CS_PRESCALE_256:
+			*PrescaleShiftScale = 8;
+			break;
+		case TIMERONE_REG_CS_PRESCALE_1024:
+			*PrescaleShiftScale = 10;
+			break;
+		default:
+			*PrescaleShiftScale = 0;
+			ReturnValue = E_NOT_OK;
+	}
+	return ReturnValue;
+} /* getPrescaleShiftScale */
+
+
+#if (TIMERONE_SERVO == STD_ON)
+/******************************************************************************************************************************************************
+  buildServoSchedule()
+******************************************************************************************************************************************************/
+/*! \brief          sort pulse ends of all servos
+ *  \details        pulse widths are converted to timer ticks of the current prescaler and sorted by insertion,
+ *                  servos with the same tick count are merged into one edge
+ *  \param[out]     Schedule					schedule to build
+ *  \return         E_OK
+ *                  E_NOT_OK if a pulse does not end before TOP
+ *****************************************************************************************************************************************************/
+stdReturnType TimerOne::buildServoSchedule(TimerOneServoScheduleType* Schedule) const
+{
+	byte Order[TIMERONE_SERVO_MAX_CHANNELS];
+	unsigned int Ticks[TIMERONE_SERVO_MAX_CHANNELS];
+	char PrescaleShiftScale;
+	byte Position;
+	TimerOneServoEdgeType* Edge = NULL;
+
+	if(E_NOT_OK == getPrescaleShiftScale(&PrescaleShiftScale)) return E_NOT_OK;
+	for(byte Index = 0; Index < NumberOfServos; Index++) {
+		Ticks[Index] = ((unsigned long) Servos[Index].Pulse * (F_CPU / 1000000)) >> PrescaleShiftScale;
+		if(Ticks[Index] >= PeriodTicks) return E_NOT_OK;
+		Position = Index;
+		while(Position > 0 && Ticks[Order[Position - 1]] > Ticks[Index]) {
+			Order[Position] = Order[Position - 1];
+			Position--;
+		}
+		Order[Position] = Index;
+	}
+	Schedule->Length = 0;
+	for(Position = 0; Position < NumberOfServos; Position++) {
+		/* servos with the same tick count share one edge */
+		if(NULL == Edge || Edge->Ticks != Ticks[Order[Position]]) {
+			Edge = &Schedule->Edges[Schedule->Length++];
+			Edge->Ticks = Ticks[Order[Position]];
+			for(byte Port = 0; Port < TIMERONE_SERVO_NUMBER_OF_PORTS; Port++) Edge->Toggle[Port] = 0;
+		}
+		Edge->Toggle[Servos[Order[Position]].Port] |= Servos[Order[Position]].Mask;
+	}
+	return E_OK;
+} /* buildServoSchedule */
+#endif
+
+
+/******************************************************************************************************************************************************
+  readTicks()
+******************************************************************************************************************************************************/
+/*! \brief          read free running counter
+ *  \details        a pending overflow which is not yet counted by the overflow interrupt is taken into account. The
+ *                  interrupt sequence is incremented, so an interrupted nowTicks() reads again.
+ *  \return         timer cycles since start
+ *  \pre			interrupts have to be disabled
+ *****************************************************************************************************************************************************/
+unsigned long TimerOne::readTicks()
+{
+	unsigned int CounterValue = TCNT1;
+	unsigned int Epoch = OverflowEpoch;
+
+	InterruptSequence++;
+	/* counter wrapped around but overflow interrupt is still pending */
+	if((TIFR1 & (1 << TOV1)) && CounterValue < (TIMERONE_RESOLUTION / 2)) Epoch++;
+	return ((unsigned long) Epoch << TIMERONE_NUMBER_OF_BITS) | CounterValue;
+} /* readTicks */
+
+
+/******************************************************************************************************************************************************
+  armCompare()
+******************************************************************************************************************************************************/
+/*! \brief          arm compare interrupt for the deadline
+ *  \details        the deadline has to be within the next counter cycle
+ *
+ *  \return         E_OK
+ *                  E_NOT_OK					deadline passed before the compare interrupt was armed
+ *  \pre			interrupts have to be disabled
+ *****************************************************************************************************************************************************/
+stdReturnType TimerOne::armCompare()
+{
+	OCR1A = (unsigned int) CompareDeadline;
+	/* clear compare match of an earlier counter cycle */
+	TIFR1 = (1 << OCF1A);
+	writeBit(TIMSK1, OCIE1A, 1);
+	/* deadline reached and compare match was before flag was cleared */
+	if((long) (CompareDeadline - readTicks()) <= 0 && (TIFR1 & (1 << OCF1A)) == 0) {
+		writeBit(TIMSK1, OCIE1A, 0);
+		return E_NOT_OK;
+	}
+	return E_OK;
+} /* armCompare */
+
+
+/******************************************************************************************************************************************************
+  wakeup()
+******************************************************************************************************************************************************/
+/*! \brief          call compare callback
+ *  \details
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerOne::wakeup()
+{
+#if (TIMERONE_INTERRUPT_COUNTER == STD_ON)
+	WakeupCounter++;
+#endif
+#if (TIMERONE_CALLBACK_PROFILER == STD_ON)
+	unsigned int Start = TCNT1;
+
+	if(TimerCompareCallback != NULL) TimerCompareCallback();
+	profileCallback(Start);
+#else
+	if(TimerCompareCallback != NULL) TimerCompareCallback();
+#endif
+} /* wakeup */
+
+
+#if (TIMERONE_CALLBACK_PROFILER == STD_ON)
+/******************************************************************************************************************************************************
+  profileCallback()
+******************************************************************************************************************************************************/
+/*! \brief          update run time statistic of the compare callback
+ *  \details        in periodic mode the counter wraps at TOP, a pending compare flag shows that the callback ran into
+ *                  the next period. More than two periods can not be told apart from one by counter and flag.
+ *  \param[in]      Start						counter value before the callback
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerOne::profileCallback(unsigned int Start)
+{
+	unsigned int End = TCNT1;
+	unsigned long Duration;
+
+	if(End >= Start) Duration = End - Start;
+	/* counter wrapped, at TOP in periodic mode and at MAX in tickless mode */
+	else if(TIMERONE_MODE_PERIODIC == Mode) Duration = ((unsigned long) PeriodTicks + 1 - Start) + End;
+	else Duration = (TIMERONE_RESOLUTION - Start) + End;
+
+	if(TIMERONE_MODE_PERIODIC == Mode) {
+		if(TIFR1 & (1 << OCF1A)) {
+			if(CallbackProfile.Overruns < 0xFFFF) CallbackProfile.Overruns++;
+			if(End >= Start) {
+				/* flag is set, but counter is behind start again, so a whole period passed */
+				Duration += (unsigned long) PeriodTicks + 1;
+				if(CallbackProfile.MissedPeriods < 0xFFFF) CallbackProfile.MissedPeriods++;
+			}
+		}
+	}
+	if(Duration > CallbackProfile.MaxDuration) CallbackProfile.MaxDuration = Duration;
+} /* profileCallback */
+#endif
+
+
 /******************************************************************************************************************************************************
   I S R   F U N C T I O N S
 ******************************************************************************************************************************************************/
 ISR(TIMER1_COMPA_vect)
 {
-	Timer1.TimerCompareCallback();
+	Timer1.compareInterrupt();
+}
+
+#if (TIMERONE_TICKLESS == STD_ON)
+ISR(TIMER1_OVF_vect)
+{
+	Timer1.overflowInterrupt();
+}
+#endif
+
+#if (TIMERONE_INPUT_CAPTURE == STD_ON)
+ISR(TIMER1_CAPT_vect)
+{
+	Timer1.captureInterrupt();
+}
+#endif
+
+#if (TIMERONE_SERVO == STD_ON)
+ISR(TIMER1_COMPB_vect)
+{
+	Timer1.servoInterrupt();
+}
+#endif
+
+#if (TIMERONE_TONE_DURATION == STD_ON)
+ISR(TIMER2_OVF_vect)
+{
+	Timer1.toneInterrupt();
 }
+#endif
 
 
 /******************************************************************************************************************************************************
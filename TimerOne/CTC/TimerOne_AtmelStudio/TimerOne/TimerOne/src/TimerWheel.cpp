@@ -0,0 +1,461 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       TimerWheel.cpp
+ *      \brief      Main file of TimerWheel library
+ *
+ *      \details    Hierarchical timer wheel which multiplexes any number of one-shot and periodic software timers on the
+ *                  Timer1 compare interrupt.
+ *
+ *****************************************************************************************************************************************************/
+#define _TIMERWHEEL_SOURCE_
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include "TimerWheel.h"
+#include <util/atomic.h>
+
+
+/******************************************************************************************************************************************************
+ * GLOBAL DATA
+ *****************************************************************************************************************************************************/
+TimerWheel& Wheel = TimerWheel::getInstance();              // pre-instantiate TimerWheel
+
+
+/******************************************************************************************************************************************************
+ * C O N S T R U C T O R S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  CONSTRUCTOR OF TimerWheel
+******************************************************************************************************************************************************/
+/*! \brief          TimerWheel constructor
+ *  \details        Instantiation of the TimerWheel library
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+TimerWheel::TimerWheel()
+{
+	State = STATE_INIT;
+	Mode = TIMERONE_MODE_PERIODIC;
+	Now = 0;
+	NowCount = 0;
+	PeriodTicks = 0;
+	InTick = false;
+	Pending = NULL;
+	for(byte Level = 0; Level < TIMERWHEEL_NUMBER_OF_LEVELS; Level++) {
+		for(byte Index = 0; Index < TIMERWHEEL_SLOTS_PER_LEVEL; Index++) Slots[Level][Index] = NULL;
+	}
+} /* TimerWheel */
+
+
+/******************************************************************************************************************************************************
+  DESTRUCTOR OF TimerWheel
+******************************************************************************************************************************************************/
+TimerWheel::~TimerWheel()
+{
+
+} /* ~TimerWheel */
+
+
+/******************************************************************************************************************************************************
+  COPY CONSTRUCTOR OF TimerWheel
+******************************************************************************************************************************************************/
+TimerWheel& TimerWheel::getInstance()
+{
+	static TimerWheel SingletonInstance;
+	return SingletonInstance;
+}
+
+
+/******************************************************************************************************************************************************
+ * P U B L I C   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  init()
+******************************************************************************************************************************************************/
+/*! \brief          initialization of the timer wheel
+ *  \details        this functions initializes Timer1 with the tick period of the wheel and starts it.
+ *                  In tickless mode Timer1 only interrupts when the next timer expires or an upper level slot has to
+ *                  be cascaded, the ticks in between are skipped.
+ *  \param[in]      TickMicroseconds            period of one wheel tick
+ *  \param[in]      sMode                       periodic or tickless mode
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre            Timer1 must not be initialized by someone else
+ *****************************************************************************************************************************************************/
+stdReturnType TimerWheel::init(unsigned long TickMicroseconds, TimerOneModeType sMode)
+{
+	stdReturnType ReturnValue = E_NOT_OK;
+
+	if(STATE_INIT == State) {
+		if(E_OK == Timer1.init(TickMicroseconds, tickCallback)) {
+			if(E_OK == Timer1.setMode(sMode)) {
+				Mode = sMode;
+				PeriodTicks = Timer1.getPeriodTicks();
+				if(E_OK == Timer1.start()) {
+					ReturnValue = E_OK;
+					State = STATE_RUNNING;
+					if(TIMERONE_MODE_TICKLESS == Mode) {
+						ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { if(E_NOT_OK == reprogram()) ReturnValue = E_NOT_OK; }
+					}
+				}
+			}
+		}
+	}
+	return ReturnValue;
+} /* init */
+
+
+/******************************************************************************************************************************************************
+  getTicks()
+******************************************************************************************************************************************************/
+/*! \brief          read number of processed ticks
+ *  \details
+ *
+ *  \return         number of ticks since init
+ *****************************************************************************************************************************************************/
+unsigned long TimerWheel::getTicks() const
+{
+	unsigned long Ticks;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { Ticks = Now + getElapsedTicks(); }
+	return Ticks;
+} /* getTicks */
+
+
+/******************************************************************************************************************************************************
+  startTimer()
+******************************************************************************************************************************************************/
+/*! \brief          arm a software timer
+ *  \details        this function links the timer into the wheel, an already armed timer is restarted.
+ *                  The callback is called from interrupt context.
+ *  \param[in]      Timer                       timer which should be armed
+ *  \param[in]      Ticks                       number of ticks until the first expiry, at least one
+ *  \param[in]      sCallback                   callback function which should be called when the timer expires
+ *  \param[in]      PeriodTicks                 period of a periodic timer in ticks, 0 for a one-shot timer
+ *  \return         E_OK
+ *                  E_NOT_OK                    invalid parameter or compare interrupt could not be programmed in
+ *                                              tickless mode, the timer is armed then
+ *****************************************************************************************************************************************************/
+stdReturnType TimerWheel::startTimer(TimerWheelTimer& Timer, unsigned long Ticks, TimerIsrCallbackF_void sCallback, unsigned long PeriodTicks)
+{
+	stdReturnType ReturnValue = E_NOT_OK;
+
+	if((Ticks != 0) && (sCallback != NULL)) {
+		ReturnValue = E_OK;
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+			if(Timer.isArmed()) unlinkTimer(&Timer);
+			Timer.Callback = sCallback;
+			Timer.Period = PeriodTicks;
+			Timer.Expiry = Now + getElapsedTicks() + Ticks;
+			addTimer(&Timer);
+			/* new timer may expire before the programmed compare interrupt */
+			if(TIMERONE_MODE_TICKLESS == Mode && !InTick && STATE_RUNNING == State) {
+				if(E_NOT_OK == reprogram()) ReturnValue = E_NOT_OK;
+			}
+		}
+	}
+	return ReturnValue;
+} /* startTimer */
+
+
+/******************************************************************************************************************************************************
+  stopTimer()
+******************************************************************************************************************************************************/
+/*! \brief          cancel a software timer
+ *  \details
+ *
+ *  \param[in]      Timer                       timer which should be canceled
+ *  \return         E_OK
+ *                  E_NOT_OK                    timer was not armed
+ *****************************************************************************************************************************************************/
+stdReturnType TimerWheel::stopTimer(TimerWheelTimer& Timer)
+{
+	stdReturnType ReturnValue = E_NOT_OK;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		if(Timer.isArmed()) {
+			ReturnValue = E_OK;
+			unlinkTimer(&Timer);
+		}
+	}
+	return ReturnValue;
+} /* stopTimer */
+
+
+/******************************************************************************************************************************************************
+  tick()
+******************************************************************************************************************************************************/
+/*! \brief          process one tick of the wheel
+ *  \details        this function is called from the Timer1 compare interrupt, it cascades the upper levels when the
+ *                  lower level wrapped around and calls all timers which expire in this tick
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerWheel::tick()
+{
+	TimerWheelTimer* Timer;
+	unsigned long Ticks = Now + 1;
+	byte Index = Ticks & TIMERWHEEL_SLOT_MASK;
+
+	Now = Ticks;
+	/* lower level wrapped around, move timers of the next slot of the upper levels down */
+	if(0 == Index) {
+		for(byte Level = 1; Level < TIMERWHEEL_NUMBER_OF_LEVELS; Level++) {
+			byte LevelIndex = (Ticks >> (Level * TIMERWHEEL_LEVEL_BITS)) & TIMERWHEEL_SLOT_MASK;
+			cascade(Level, LevelIndex);
+			if(LevelIndex != 0) break;
+		}
+	}
+	/* move expired timers to pending list, so callbacks are able to start and stop timers */
+	Pending = Slots[0][Index];
+	Slots[0][Index] = NULL;
+	if(Pending != NULL) Pending->PrevNext = &Pending;
+
+	while(Pending != NULL) {
+		Timer = Pending;
+		unlinkTimer(Timer);
+		if(Timer->Period != 0) {
+			Timer->Expiry += Timer->Period;
+			/* timer is overdue by more than one period, call it again with the next tick */
+			if((long) (Timer->Expiry - Ticks) <= 0) Timer->Expiry = Ticks + 1;
+			addTimer(Timer);
+		}
+		Timer->Callback();
+	}
+} /* tick */
+
+
+/******************************************************************************************************************************************************
+  tickCallback()
+******************************************************************************************************************************************************/
+/*! \brief          Timer1 compare callback of the wheel
+ *  \details
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerWheel::tickCallback()
+{
+	TimerWheel& Instance = getInstance();
+
+	if(TIMERONE_MODE_TICKLESS == Instance.Mode) Instance.tickless();
+	else Instance.tick();
+} /* tickCallback */
+
+
+/******************************************************************************************************************************************************
+ * P R I V A T E   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  linkTimer()
+******************************************************************************************************************************************************/
+/*! \brief          link timer at the head of a list
+ *  \details
+ *
+ *  \param[in]      Head                        head of the list
+ *  \param[in]      Timer                       timer which should be linked
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerWheel::linkTimer(TimerWheelTimer** Head, TimerWheelTimer* Timer)
+{
+	Timer->Next = *Head;
+	if(Timer->Next != NULL) Timer->Next->PrevNext = &Timer->Next;
+    *Head = Timer;
+	Timer->PrevNext = Head;
+} /* linkTimer */
+
+
+/******************************************************************************************************************************************************
+  unlinkTimer()
+******************************************************************************************************************************************************/
+/*! \brief          unlink timer from its list
+ *  \details
+ *
+ *  \param[in]      Timer                       timer which should be unlinked
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerWheel::unlinkTimer(TimerWheelTimer* Timer)
+{
+    *Timer->PrevNext = Timer->Next;
+	if(Timer->Next != NULL) Timer->Next->PrevNext = Timer->PrevNext;
+	Timer->Next = NULL;
+	Timer->PrevNext = NULL;
+} /* unlinkTimer */
+
+
+/******************************************************************************************************************************************************
+  addTimer()
+******************************************************************************************************************************************************/
+/*! \brief          put timer into the slot of its expiry
+ *  \details        the level is selected by the distance to the expiry, timers beyond the range of the wheel are put
+ *                  into the last slot and will be cascaded again until they are in range
+ *  \param[in]      Timer                       timer which should be added
+ *  \return         -
+ *  \pre            interrupts have to be disabled
+ *****************************************************************************************************************************************************/
+void TimerWheel::addTimer(TimerWheelTimer* Timer)
+{
+	unsigned long Delta = Timer->Expiry - Now;
+	unsigned long Expiry = Timer->Expiry;
+	byte Level = 0;
+
+	/* timer is already expired, call it with the current tick */
+	if((long) Delta < 0) {
+		Delta = 0;
+		Expiry = Now;
+	} else if(Delta > TIMERWHEEL_MAX_DELTA) {
+		Delta = TIMERWHEEL_MAX_DELTA;
+		Expiry = Now + TIMERWHEEL_MAX_DELTA;
+	}
+	while((Delta >> ((Level + 1) * TIMERWHEEL_LEVEL_BITS)) != 0) Level++;
+
+	linkTimer(&Slots[Level][(Expiry >> (Level * TIMERWHEEL_LEVEL_BITS)) & TIMERWHEEL_SLOT_MASK], Timer);
+} /* addTimer */
+
+
+/******************************************************************************************************************************************************
+  cascade()
+******************************************************************************************************************************************************/
+/*! \brief          move all timers of an upper level slot to the lower levels
+ *  \details
+ *
+ *  \param[in]      Level                       level of the slot
+ *  \param[in]      Index                       index of the slot
+ *  \return         -
+ *  \pre            interrupts have to be disabled
+ *****************************************************************************************************************************************************/
+void TimerWheel::cascade(byte Level, byte Index)
+{
+	TimerWheelTimer* Timer = Slots[Level][Index];
+
+	Slots[Level][Index] = NULL;
+	while(Timer != NULL) {
+		TimerWheelTimer* Next = Timer->Next;
+		addTimer(Timer);
+		Timer = Next;
+	}
+} /* cascade */
+
+
+/******************************************************************************************************************************************************
+  getNextEvent()
+******************************************************************************************************************************************************/
+/*! \brief          find next tick which has to be processed
+ *  \details        this is the expiry of the next timer in the first level or the next cascade of a non-empty upper level
+ *                  slot, whichever comes first
+ *  \return         next tick with work to do
+ *  \pre            interrupts have to be disabled
+ *****************************************************************************************************************************************************/
+unsigned long TimerWheel::getNextEvent() const
+{
+	unsigned long NextEvent = Now + TIMERWHEEL_TICKLESS_MAX_SKIP;
+
+	for(byte Level = 0; Level < TIMERWHEEL_NUMBER_OF_LEVELS; Level++) {
+		byte Shift = Level * TIMERWHEEL_LEVEL_BITS;
+		unsigned long Block = Now >> Shift;
+
+		for(byte Distance = 1; Distance <= TIMERWHEEL_SLOTS_PER_LEVEL; Distance++) {
+			if(Slots[Level][(Block + Distance) & TIMERWHEEL_SLOT_MASK] != NULL) {
+				unsigned long Event = (Block + Distance) << Shift;
+				if((long) (Event - NextEvent) < 0) NextEvent = Event;
+				break;
+			}
+		}
+	}
+	return NextEvent;
+} /* getNextEvent */
+
+
+/******************************************************************************************************************************************************
+  getElapsedTicks()
+******************************************************************************************************************************************************/
+/*! \brief          number of ticks elapsed since the last processed tick
+ *  \details        in periodic mode every tick is processed, so this is always zero
+ *
+ *  \return         elapsed ticks
+ *  \pre            interrupts have to be disabled
+ *****************************************************************************************************************************************************/
+unsigned long TimerWheel::getElapsedTicks() const
+{
+	unsigned long ElapsedTicks = 0;
+
+	if(TIMERONE_MODE_TICKLESS == Mode && PeriodTicks != 0) {
+		ElapsedTicks = (Timer1.getTicks() - NowCount) / PeriodTicks;
+	}
+	return ElapsedTicks;
+} /* getElapsedTicks */
+
+
+/******************************************************************************************************************************************************
+  tickless()
+******************************************************************************************************************************************************/
+/*! \brief          process all due ticks in tickless mode
+ *  \details        empty ticks are skipped, afterwards the compare interrupt is programmed to the next event
+ *
+ *  \return         -
+ *  \pre            Timer1 has to be in RUNNING state and in tickless mode, otherwise nothing is done
+ *****************************************************************************************************************************************************/
+void TimerWheel::tickless()
+{
+	/* setCompare() fails without running tickless Timer1, all ticks would be skipped one event after the other */
+	if((TIMERONE_STATE_RUNNING != Timer1.getState()) || (TIMERONE_MODE_TICKLESS != Timer1.getMode())) return;
+	InTick = true;
+	for(;;) {
+		unsigned long NextEvent = getNextEvent();
+		unsigned long NextCount = NowCount + (NextEvent - Now) * PeriodTicks;
+
+		if((long) (NextCount - Timer1.getTicks()) > 0) {
+			if(E_OK == Timer1.setCompare(NextCount)) break;
+		}
+		/* all ticks before the next event are empty, so jump over them */
+		Now = NextEvent - 1;
+		NowCount = NextCount;
+		tick();
+	}
+	InTick = false;
+} /* tickless */
+
+
+/******************************************************************************************************************************************************
+  reprogram()
+******************************************************************************************************************************************************/
+/*! \brief          program compare interrupt to the next event
+ *  \details        if the next event is already due, the compare interrupt is programmed as soon as possible, so the
+ *                  timers are still called from interrupt context. The margin to the counter is doubled up to the
+ *                  counter range.
+ *  \return         E_OK
+ *                  E_NOT_OK                    Timer1 is not running in tickless mode or no deadline within the counter
+ *                                              range could be armed
+ *  \pre            interrupts have to be disabled
+ *****************************************************************************************************************************************************/
+stdReturnType TimerWheel::reprogram()
+{
+	stdReturnType ReturnValue = E_NOT_OK;
+	unsigned long Margin = (PeriodTicks != 0) ? PeriodTicks : 1;
+
+	/* setCompare() fails without running tickless Timer1, a larger margin would not help */
+	if((TIMERONE_STATE_RUNNING == Timer1.getState()) && (TIMERONE_MODE_TICKLESS == Timer1.getMode())) {
+		ReturnValue = Timer1.setCompare(NowCount + (getNextEvent() - Now) * PeriodTicks);
+		while((E_NOT_OK == ReturnValue) && (Margin <= TIMERONE_RESOLUTION)) {
+			ReturnValue = Timer1.setCompare(Timer1.getTicks() + Margin);
+			Margin <<= 1;
+		}
+	}
+	return ReturnValue;
+} /* reprogram */
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
@@ -0,0 +1,136 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       PwmSequencer.h
+ *      \brief      Main header file of PwmSequencer library
+ *
+ *      \details    Plays back tables of precomputed OCR1A/OCR1B values from the Timer1 overflow interrupt, one sample
+ *                  per pwm period. Tables can be located in RAM or PROGMEM and are double buffered.
+ *                  The samples are compare values of the TOP they are played with, so a period change by setPeriod() or
+ *                  setPeriodSync() stops the play back at the next BOTTOM.
+ *
+ *****************************************************************************************************************************************************/
+#ifndef _PWMSEQUENCER_H_
+#define _PWMSEQUENCER_H_
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include "Arduino.h"
+#include <avr/pgmspace.h>
+#include <StandardTypes.h>
+#include <TimerOne.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL FUNCTION MACROS
+ *****************************************************************************************************************************************************/
+
+
+/******************************************************************************************************************************************************
+ *  GLOBAL DATA TYPES AND STRUCTURES
+ *****************************************************************************************************************************************************/
+
+
+/******************************************************************************************************************************************************
+ *  CLASS  PwmSequencer
+ *****************************************************************************************************************************************************/
+class PwmSequencer
+{
+/******************************************************************************************************************************************************
+ *  P U B L I C   D A T A   T Y P E S   A N D   S T R U C T U R E S
+******************************************************************************************************************************************************/
+  public:
+	/* Type which describes the internal state of the PwmSequencer */
+	enum StateType {
+		STATE_INIT,
+		STATE_IDLE,
+		STATE_RUNNING
+	};
+
+	/* Type which describes the compare registers written by the sequencer */
+	enum ChannelType {
+		CHANNEL_A = 1u,
+		/* table contains OCR1A and OCR1B values alternately */
+		CHANNEL_AB = 2u,
+		CHANNEL_B = 3u
+	};
+
+	/* Type which describes what happens at the end of a table */
+	enum ModeType {
+		MODE_ONE_SHOT,
+		MODE_LOOP
+	};
+
+	/* Type which describes where a table is located */
+	enum MemoryType {
+		MEMORY_RAM,
+		MEMORY_PROGMEM
+	};
+
+/******************************************************************************************************************************************************
+ *  P R I V A T E   D A T A   A N D   F U N C T I N O N S
+******************************************************************************************************************************************************/
+  private:
+	struct BufferType {
+		const unsigned int* Samples;
+		unsigned int Length;
+		ModeType Mode;
+		MemoryType Memory;
+	};
+
+	PwmSequencer();
+	~PwmSequencer();
+	PwmSequencer(const PwmSequencer&);
+
+	volatile StateType State;
+	ChannelType Channel;
+	/* table which is played back */
+	BufferType Active;
+	/* table which is played back after the active one, Samples is NULL if the buffer is free */
+	BufferType Next;
+	unsigned int Index;
+	/* pwm resolution of Timer1 when the play back was started */
+	unsigned long Resolution;
+
+	unsigned int readSample(unsigned int) const;
+
+/******************************************************************************************************************************************************
+ *  P U B L I C   F U N C T I O N S
+******************************************************************************************************************************************************/
+  public:
+	static PwmSequencer& getInstance();
+
+	// get methods
+	StateType getState() const { return State; }
+	boolean isBufferFree() const;
+
+	// set methods
+	stdReturnType init(ChannelType);
+	stdReturnType play(const unsigned int*, unsigned int, ModeType = MODE_LOOP, MemoryType = MEMORY_RAM);
+	stdReturnType queue(const unsigned int*, unsigned int, ModeType = MODE_LOOP, MemoryType = MEMORY_RAM);
+	void stop();
+	void nextSample();
+	static void overflowCallback();
+};
+
+/* PwmSequencer will be pre-instantiated in PwmSequencer source file */
+extern PwmSequencer& Sequencer;
+
+#endif
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
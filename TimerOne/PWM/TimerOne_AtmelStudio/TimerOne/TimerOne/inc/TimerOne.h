@@ -24,6 +24,7 @@
 #include "Arduino.h"
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <util/atomic.h>
 #include <StandardTypes.h>
 
 
@@ -46,9 +47,37 @@
 
 #define TIMERONE_MAX_PRESCALER                      1024
 
+/* TOV1 is set at BOTTOM, ICF1 is set at TOP when ICR1 is TOP */
+#define TIMERONE_PHASE_FLAGS						((1 << TOV1) | (1 << ICF1))
+
+/* duty to compare value table, costs 512 bytes RAM and reduces the duty cycle resolution to 8 bit */
+#ifndef TIMERONE_DUTY_TABLE
+#define TIMERONE_DUTY_TABLE							STD_OFF
+#endif
+#define TIMERONE_DUTY_TABLE_SIZE					256
+
+/* overflow interrupt is defined by the sketch with TIMERONE_ISR(Handler), attachInterrupt() only enables it */
+#ifndef TIMERONE_STATIC_ISR
+#define TIMERONE_STATIC_ISR							STD_OFF
+#endif
+
+/* setPeriodSync() changes TOP, prescaler and duty cycles together at BOTTOM from the overflow interrupt */
+#ifndef TIMERONE_SYNC_PERIOD
+#define TIMERONE_SYNC_PERIOD						STD_OFF
+#endif
+
+/* enableComplementaryPwm() drives OC1B inverted to OC1A with a dead time on both edges */
+#ifndef TIMERONE_COMPLEMENTARY_PWM
+#define TIMERONE_COMPLEMENTARY_PWM					STD_ON
+#endif
+
 /******************************************************************************************************************************************************
  *  LOCAL FUNCTION MACROS
  *****************************************************************************************************************************************************/
+#if (TIMERONE_STATIC_ISR == STD_ON)
+/* handler is called directly and can be inlined, it has to be defined before and passed to init() or attachInterrupt() */
+# define TIMERONE_ISR(Handler)						ISR(TIMER1_OVF_vect) { Timer1.enterOverflowInterrupt(); Handler(); }
+#endif
 
 
 /******************************************************************************************************************************************************
@@ -76,6 +105,23 @@ typedef enum {
 	TIMERONE_REG_CS_PRESCALE_1024
 } TimerOneClockSelectType;
 
+/* Type which includes the supported pwm modes */
+typedef enum {
+	/* mode 8: dual slope, symmetric pulses */
+	TIMERONE_MODE_PHASE_FREQUENCY_CORRECT,
+	/* mode 14: single slope, double pwm frequency at the same prescaler and resolution */
+	TIMERONE_MODE_FAST_PWM
+} TimerOneModeType;
+
+/* Type which describes the progress of a synchronized period change */
+typedef enum {
+	TIMERONE_SYNC_IDLE,
+	/* new period is staged, compare registers are loaded at the next BOTTOM */
+	TIMERONE_SYNC_PENDING,
+	/* compare buffers hold the new duty cycles, TOP and prescaler are set at the next BOTTOM */
+	TIMERONE_SYNC_COMPARE_LOADED
+} TimerOneSyncStateType;
+
 /* Type which includes the Pwm Pins */
 typedef enum {
 	TIMERONE_PWM_PIN_9 = TIMERONE_A_ARDUINO_PIN,
@@ -83,6 +129,28 @@ typedef enum {
 } TimerOnePwmPinType;
 
 
+/* compile time calculation of prescaler and timer top value, same ladder as setPeriod(unsigned long) */
+template <unsigned long Microseconds>
+struct TimerOnePeriod
+{
+	/* counter runs backwards after TOP, interrupt is at BOTTOM so divide microseconds by 2 */
+	static const unsigned long TimerCycles = (F_CPU / 2000000) * Microseconds;
+	static const TimerOneClockSelectType ClockSelectBitGroup =
+		(TimerCycles < TIMERONE_RESOLUTION)         ? TIMERONE_REG_CS_NO_PRESCALER :
+		((TimerCycles >> 3) < TIMERONE_RESOLUTION)  ? TIMERONE_REG_CS_PRESCALE_8 :
+		((TimerCycles >> 6) < TIMERONE_RESOLUTION)  ? TIMERONE_REG_CS_PRESCALE_64 :
+		((TimerCycles >> 8) < TIMERONE_RESOLUTION)  ? TIMERONE_REG_CS_PRESCALE_256 : TIMERONE_REG_CS_PRESCALE_1024;
+	static const unsigned char PrescaleShiftScale =
+		(TIMERONE_REG_CS_NO_PRESCALER == ClockSelectBitGroup) ? 0 :
+		(TIMERONE_REG_CS_PRESCALE_8 == ClockSelectBitGroup)   ? 3 :
+		(TIMERONE_REG_CS_PRESCALE_64 == ClockSelectBitGroup)  ? 6 :
+		(TIMERONE_REG_CS_PRESCALE_256 == ClockSelectBitGroup) ? 8 : 10;
+	static const unsigned int Top = TimerCycles >> PrescaleShiftScale;
+	/* request out of bounds? */
+	STATIC_ASSERT((Microseconds <= (0xFFFFFFFFUL / (F_CPU / 2000000))) && ((TimerCycles >> 10) < TIMERONE_RESOLUTION), TimerOnePeriodOutOfBounds);
+};
+
+
 /******************************************************************************************************************************************************
  *  CLASS  TimerOne
  *****************************************************************************************************************************************************/
@@ -94,24 +162,111 @@ class TimerOne
 	TimerOne(const TimerOne&);
 	TimerOneStateType State;
 	TimerOneClockSelectType ClockSelectBitGroup;
+	TimerOneModeType Mode;
+	/* copy of TOP (ICR1), updated by setPeriod */
 	unsigned int PwmPeriod;
+#if (TIMERONE_DUTY_TABLE == STD_ON)
+	unsigned int DutyTable[TIMERONE_DUTY_TABLE_SIZE];
+#endif
+	/* counting direction, kept by read and overflow interrupt */
+	volatile boolean CountingDown;
+#if (TIMERONE_SYNC_PERIOD == STD_ON)
+	/* duty cycles of both channels, needed to scale the compare values to a new TOP */
+	unsigned int DutyCycleA;
+	unsigned int DutyCycleB;
+	volatile TimerOneSyncStateType SyncState;
+	unsigned int SyncTop;
+	TimerOneClockSelectType SyncClockSelect;
+	TimerIsrCallbackF_void SyncCallback;
+	void commitPeriod();
+#endif
+#if (TIMERONE_COMPLEMENTARY_PWM == STD_ON)
+	/* OC1A and inverted OC1B are driven as complementary pair, DeadTime is in nanoseconds */
+	boolean Complementary;
+	unsigned int ComplementaryDuty;
+	unsigned int DeadTime;
+	unsigned int DeadTimeTicks;
+# if (TIMERONE_SYNC_PERIOD == STD_ON)
+	unsigned int SyncDeadTimeTicks;
+# endif
+	unsigned int calcDeadTime(unsigned int, TimerOneClockSelectType) const;
+	void writeComplementary(unsigned int);
+#endif
+	/* longest period, dual slope counter needs twice the time */
+	unsigned long getMaxPeriod() const { return ((TIMERONE_RESOLUTION / (F_CPU / 1000000)) * TIMERONE_MAX_PRESCALER) << ((TIMERONE_MODE_FAST_PWM == Mode) ? 0 : 1); }
+	stdReturnType getPrescaleShiftScale(TimerOneClockSelectType, char*) const;
+	stdReturnType calcPeriod(unsigned long, unsigned int*, TimerOneClockSelectType*);
+	unsigned int calcCompare(unsigned int) const;
+	void updateDutyCache(unsigned int);
+	void updateComplementary();
 
   public:
 	static TimerOne& getInstance();
 	TimerIsrCallbackF_void TimerOverflowCallback;
-	stdReturnType init(long = 1000, TimerIsrCallbackF_void = NULL);
+	stdReturnType init(long = 1000, TimerIsrCallbackF_void = NULL, TimerOneModeType = TIMERONE_MODE_PHASE_FREQUENCY_CORRECT);
+	TimerOneModeType getMode() const { return Mode; }
 	stdReturnType setPeriod(unsigned long);
+	template <unsigned long Microseconds> stdReturnType setPeriod();
+#if (TIMERONE_SYNC_PERIOD == STD_ON)
+	stdReturnType setPeriodSync(unsigned long, TimerIsrCallbackF_void = NULL);
+	boolean isPeriodPending() const { return TIMERONE_SYNC_IDLE != SyncState; }
+#endif
 	stdReturnType enablePwm(TimerOnePwmPinType, unsigned int);
 	stdReturnType disablePwm(TimerOnePwmPinType);
 	stdReturnType setPwmDuty(TimerOnePwmPinType, unsigned int);
+#if (TIMERONE_COMPLEMENTARY_PWM == STD_ON)
+	stdReturnType enableComplementaryPwm(unsigned int, unsigned int);
+	void disableComplementaryPwm();
+	stdReturnType setComplementaryDuty(unsigned int);
+	unsigned int getDeadTimeTicks() const { return DeadTimeTicks; }
+#endif
 	stdReturnType start();
 	void stop();
 	stdReturnType resume();
 	stdReturnType attachInterrupt(TimerIsrCallbackF_void);
 	void detachInterrupt();
 	stdReturnType read(unsigned long*);
+	stdReturnType readCounter(unsigned long*);
+	stdReturnType getPwmFrequency(unsigned long*);
+	unsigned long getPwmResolution() const { return PwmPeriod + 1UL; }
+	void overflowInterrupt();
+#if (TIMERONE_SYNC_PERIOD == STD_ON)
+	void enterOverflowInterrupt() { CountingDown = false; TIFR1 = (1 << ICF1); if(TIMERONE_SYNC_IDLE != SyncState) commitPeriod(); }
+#else
+	void enterOverflowInterrupt() { CountingDown = false; TIFR1 = (1 << ICF1); }
+#endif
 };
 
+
+
+/******************************************************************************************************************************************************
+  setPeriod()
+******************************************************************************************************************************************************/
+/*! \brief          set period of Timer1 overflow interrupt at compile time
+ *  \details        prescaler and timer top value are calculated during compilation, so only the register stores
+ *                  remain. Out of bounds requests, from 8388608 microseconds at 16 MHz, fail to compile. The
+ *                  calculation is done for the dual slope counter, in fast pwm mode the period is calculated at run time.
+ *  \tparam         Microseconds				period of the timer overflow interrupt
+ *  \return         E_OK
+ *****************************************************************************************************************************************************/
+template <unsigned long Microseconds>
+stdReturnType TimerOne::setPeriod()
+{
+	if(TIMERONE_MODE_FAST_PWM == Mode) return setPeriod(Microseconds);
+	ClockSelectBitGroup = TimerOnePeriod<Microseconds>::ClockSelectBitGroup;
+	/* ICR1 is TOP in phase correct pwm mode */
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { ICR1 = TimerOnePeriod<Microseconds>::Top; }
+	updateDutyCache(TimerOnePeriod<Microseconds>::Top);
+	updateComplementary();
+
+	if(TIMERONE_STATE_RUNNING == State)
+	{
+		/* reset clock select register, and starts the clock */
+		writeBitGroup(TCCR1B, TIMERONE_REG_CS_GM, TIMERONE_REG_CS_GP, ClockSelectBitGroup);
+	}
+	return E_OK;
+} /* setPeriod */
+
 /* TimerOne will be pre-instantiated in TimerOne source file */
 extern TimerOne& Timer1;
 
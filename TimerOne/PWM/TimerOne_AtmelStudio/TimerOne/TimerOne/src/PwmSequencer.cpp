@@ -0,0 +1,302 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       PwmSequencer.cpp
+ *      \brief      Main file of PwmSequencer library
+ *
+ *      \details    Plays back tables of precomputed OCR1A/OCR1B values from the Timer1 overflow interrupt.
+ *
+ *
+ *****************************************************************************************************************************************************/
+#define _PWMSEQUENCER_SOURCE_
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include "PwmSequencer.h"
+#include <util/atomic.h>
+
+
+/******************************************************************************************************************************************************
+ * GLOBAL DATA
+ *****************************************************************************************************************************************************/
+PwmSequencer& Sequencer = PwmSequencer::getInstance();      // pre-instantiate PwmSequencer
+
+
+/******************************************************************************************************************************************************
+ * C O N S T R U C T O R S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  CONSTRUCTOR OF PwmSequencer
+******************************************************************************************************************************************************/
+/*! \brief          PwmSequencer constructor
+ *  \details        Instantiation of the PwmSequencer library
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+PwmSequencer::PwmSequencer()
+{
+	State = STATE_INIT;
+	Channel = CHANNEL_A;
+	Active.Samples = NULL;
+	Active.Length = 0u;
+	Active.Mode = MODE_LOOP;
+	Active.Memory = MEMORY_RAM;
+	Next = Active;
+	Index = 0u;
+	Resolution = 0u;
+} /* PwmSequencer */
+
+
+/******************************************************************************************************************************************************
+  DESTRUCTOR OF PwmSequencer
+******************************************************************************************************************************************************/
+PwmSequencer::~PwmSequencer()
+{
+
+} /* ~PwmSequencer */
+
+
+/******************************************************************************************************************************************************
+  COPY CONSTRUCTOR OF PwmSequencer
+******************************************************************************************************************************************************/
+PwmSequencer& PwmSequencer::getInstance()
+{
+	static PwmSequencer SingletonInstance;
+	return SingletonInstance;
+}
+
+
+/******************************************************************************************************************************************************
+ * P U B L I C   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  init()
+******************************************************************************************************************************************************/
+/*! \brief          initialization of the sequencer
+ *  \details        this function attaches the sequencer to the Timer1 overflow interrupt. The pwm outputs have to be
+ *                  enabled by Timer1.enablePwm().
+ *  \param[in]      sChannel                    compare registers written by the sequencer
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre            Timer1 has to be initialized, its overflow callback is used by the sequencer
+ *****************************************************************************************************************************************************/
+stdReturnType PwmSequencer::init(ChannelType sChannel)
+{
+	stdReturnType ReturnValue = E_NOT_OK;
+
+	if(STATE_INIT == State) {
+		if(E_OK == Timer1.attachInterrupt(overflowCallback)) {
+			ReturnValue = E_OK;
+			Channel = sChannel;
+			State = STATE_IDLE;
+		}
+	}
+	return ReturnValue;
+} /* init */
+
+
+/******************************************************************************************************************************************************
+  isBufferFree()
+******************************************************************************************************************************************************/
+/*! \brief          check if a table can be queued
+ *  \details
+ *
+ *  \return         true if no table is waiting for the end of the active one
+ *****************************************************************************************************************************************************/
+boolean PwmSequencer::isBufferFree() const
+{
+	boolean BufferFree;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { BufferFree = (Next.Samples == NULL); }
+	return BufferFree;
+} /* isBufferFree */
+
+
+/******************************************************************************************************************************************************
+  play()
+******************************************************************************************************************************************************/
+/*! \brief          play back a table immediately
+ *  \details        the active and a queued table are dropped, the first sample is written at the next BOTTOM and
+ *                  becomes active at the BOTTOM after that, because the compare registers are double buffered.
+ *                  The table is read by the interrupt, so it has to stay valid while it is played back.
+ *                  The samples have to be written for the current TOP, a period change stops the play back.
+ *  \param[in]      Samples                     compare register values, for CHANNEL_AB alternately OCR1A and OCR1B
+ *  \param[in]      Length                      number of values in table
+ *  \param[in]      sMode                       stop or start again at the end of the table
+ *  \param[in]      Memory                      table is located in RAM or PROGMEM
+ *  \return         E_OK
+ *                  E_NOT_OK                    a period change of setPeriodSync() is pending
+ *  \pre            Sequencer has to be initialized
+ *****************************************************************************************************************************************************/
+stdReturnType PwmSequencer::play(const unsigned int* Samples, unsigned int Length, ModeType sMode, MemoryType Memory)
+{
+	stdReturnType ReturnValue = E_NOT_OK;
+
+#if (TIMERONE_SYNC_PERIOD == STD_ON)
+	/* the samples would be played with the TOP which is replaced */
+	if(Timer1.isPeriodPending()) return E_NOT_OK;
+#endif
+	if((STATE_INIT != State) && (Samples != NULL) && (Length > 0u)) {
+		if((CHANNEL_AB != Channel) || (0u == (Length & 1u))) {
+			ReturnValue = E_OK;
+			ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+				Resolution = Timer1.getPwmResolution();
+				Active.Samples = Samples;
+				Active.Length = Length;
+				Active.Mode = sMode;
+				Active.Memory = Memory;
+				Next.Samples = NULL;
+				Index = 0u;
+				State = STATE_RUNNING;
+			}
+		}
+	}
+	return ReturnValue;
+} /* play */
+
+
+/******************************************************************************************************************************************************
+  queue()
+******************************************************************************************************************************************************/
+/*! \brief          play back a table after the active one
+ *  \details        the table is swapped in by the interrupt at the end of the active table, so a new table can be
+ *                  prepared while the other one is played back. If the sequencer is idle, the table is played
+ *                  back immediately.
+ *  \param[in]      Samples                     compare register values, for CHANNEL_AB alternately OCR1A and OCR1B
+ *  \param[in]      Length                      number of values in table
+ *  \param[in]      sMode                       stop or start again at the end of the table
+ *  \param[in]      Memory                      table is located in RAM or PROGMEM
+ *  \return         E_OK
+ *                  E_NOT_OK                    a table is already queued
+ *  \pre            Sequencer has to be initialized
+ *****************************************************************************************************************************************************/
+stdReturnType PwmSequencer::queue(const unsigned int* Samples, unsigned int Length, ModeType sMode, MemoryType Memory)
+{
+	stdReturnType ReturnValue = E_NOT_OK;
+
+	if(STATE_IDLE == State) {
+		ReturnValue = play(Samples, Length, sMode, Memory);
+	} else if((STATE_RUNNING == State) && (Samples != NULL) && (Length > 0u)) {
+		if((CHANNEL_AB != Channel) || (0u == (Length & 1u))) {
+			ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+				if(Next.Samples == NULL) {
+					ReturnValue = E_OK;
+					Next.Samples = Samples;
+					Next.Length = Length;
+					Next.Mode = sMode;
+					Next.Memory = Memory;
+					/* active table ended in the meantime */
+					if(STATE_IDLE == State) {
+						Resolution = Timer1.getPwmResolution();
+						Active = Next;
+						Next.Samples = NULL;
+						Index = 0u;
+						State = STATE_RUNNING;
+					}
+				}
+			}
+		}
+	}
+	return ReturnValue;
+} /* queue */
+
+
+/******************************************************************************************************************************************************
+  stop()
+******************************************************************************************************************************************************/
+/*! \brief          stop play back
+ *  \details        the compare registers keep the last sample
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void PwmSequencer::stop()
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		Next.Samples = NULL;
+		if(STATE_RUNNING == State) State = STATE_IDLE;
+	}
+} /* stop */
+
+
+/******************************************************************************************************************************************************
+  nextSample()
+******************************************************************************************************************************************************/
+/*! \brief          write next sample into the compare registers
+ *  \details        this function is called by the overflow interrupt at BOTTOM, the written values become active at
+ *                  the next BOTTOM. At the end of the table the queued table is swapped in. If the period was changed,
+ *                  the play back is stopped without writing, the compare registers keep the values of the TimerOne.
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void PwmSequencer::nextSample()
+{
+	if((STATE_RUNNING == State) && (Timer1.getPwmResolution() != Resolution)) {
+		Next.Samples = NULL;
+		State = STATE_IDLE;
+	}
+	if(STATE_RUNNING == State) {
+		if(CHANNEL_B == Channel) {
+			OCR1B = readSample(Index++);
+		} else {
+			OCR1A = readSample(Index++);
+			if(CHANNEL_AB == Channel) OCR1B = readSample(Index++);
+		}
+		if(Index >= Active.Length) {
+			Index = 0u;
+			if(Next.Samples != NULL) {
+				Active = Next;
+				Next.Samples = NULL;
+			} else if(MODE_ONE_SHOT == Active.Mode) {
+				State = STATE_IDLE;
+			}
+		}
+	}
+} /* nextSample */
+
+
+/******************************************************************************************************************************************************
+  overflowCallback()
+******************************************************************************************************************************************************/
+/*! \brief          Timer1 overflow callback
+ *  \details
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void PwmSequencer::overflowCallback()
+{
+	Sequencer.nextSample();
+} /* overflowCallback */
+
+
+/******************************************************************************************************************************************************
+ * P R I V A T E   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  readSample()
+******************************************************************************************************************************************************/
+/*! \brief          read sample of active table
+ *  \details
+ *
+ *  \param[in]      SampleIndex                 index of sample in table
+ *  \return         compare register value
+ *****************************************************************************************************************************************************/
+unsigned int PwmSequencer::readSample(unsigned int SampleIndex) const
+{
+	if(MEMORY_PROGMEM == Active.Memory) return pgm_read_word(&Active.Samples[SampleIndex]);
+	else return Active.Samples[SampleIndex];
+} /* readSample */
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
@@ -46,6 +46,26 @@ TimerOne::TimerOne()
 	State = TIMERONE_STATE_NONE;
 	TimerOverflowCallback = NULL;
 	ClockSelectBitGroup = TIMERONE_REG_CS_NO_CLOCK;
+	Mode = TIMERONE_MODE_PHASE_FREQUENCY_CORRECT;
+	CountingDown = false;
+	PwmPeriod = 0;
+#if (TIMERONE_SYNC_PERIOD == STD_ON)
+	DutyCycleA = 0;
+	DutyCycleB = 0;
+	SyncState = TIMERONE_SYNC_IDLE;
+	SyncTop = 0;
+	SyncClockSelect = TIMERONE_REG_CS_NO_CLOCK;
+	SyncCallback = NULL;
+#endif
+#if (TIMERONE_COMPLEMENTARY_PWM == STD_ON)
+	Complementary = false;
+	ComplementaryDuty = 0;
+	DeadTime = 0;
+	DeadTimeTicks = 0;
+# if (TIMERONE_SYNC_PERIOD == STD_ON)
+	SyncDeadTimeTicks = 0;
+# endif
+#endif
 } /* TimerOne */
 
 
@@ -80,11 +100,12 @@ TimerOne& TimerOne::getInstance()
  *                  
  *  \param[in]      Microseconds				period of the timer overflow interrupt
  *  \param[in]      sTimerOverflowCallback      Callback function which should be called when timer overflow interrupt occurs
+ *  \param[in]      sMode						pwm mode, fast pwm has the overflow interrupt at TOP
  *  \return         E_OK
  *                  E_NOT_OK
  *  \pre			Timer has to be in NONE STATE
  *****************************************************************************************************************************************************/
-stdReturnType TimerOne::init(long Microseconds, TimerIsrCallbackF_void sTimerOverflowCallback)
+stdReturnType TimerOne::init(long Microseconds, TimerIsrCallbackF_void sTimerOverflowCallback, TimerOneModeType sMode)
 {
 	stdReturnType ReturnValue = E_NOT_OK;
 
@@ -95,11 +116,20 @@ stdReturnType TimerOne::init(long Microseconds, TimerIsrCallbackF_void sTimerOve
 	    TCCR1A = 0;
 	    TCCR1B = 0;
 	    
-	    /* set mode 8: phase and frequency correct pwm */
-	    writeBit(TCCR1A, WGM10, 0);
-	    writeBit(TCCR1A, WGM11, 0);
-	    writeBit(TCCR1B, WGM12, 0);
-		writeBit(TCCR1B, WGM13, 1);
+		Mode = sMode;
+		if(TIMERONE_MODE_FAST_PWM == Mode) {
+			/* set mode 14: fast pwm with ICR1 as TOP */
+			writeBit(TCCR1A, WGM10, 0);
+			writeBit(TCCR1A, WGM11, 1);
+			writeBit(TCCR1B, WGM12, 1);
+			writeBit(TCCR1B, WGM13, 1);
+		} else {
+			/* set mode 8: phase and frequency correct pwm */
+			writeBit(TCCR1A, WGM10, 0);
+			writeBit(TCCR1A, WGM11, 0);
+			writeBit(TCCR1B, WGM12, 0);
+			writeBit(TCCR1B, WGM13, 1);
+		}
 		
 		if(setPeriod(Microseconds) == E_NOT_OK) ReturnValue = E_NOT_OK;
 		if(sTimerOverflowCallback != NULL) if(attachInterrupt(sTimerOverflowCallback) == E_NOT_OK) ReturnValue = E_NOT_OK;
@@ -123,27 +153,15 @@ stdReturnType TimerOne::init(long Microseconds, TimerIsrCallbackF_void sTimerOve
 stdReturnType TimerOne::setPeriod(unsigned long Microseconds)
 {
 	stdReturnType ReturnValue = E_NOT_OK;
-	unsigned long TimerCycles;
+	unsigned int Top;
     
     /* was request out of bounds? */
-    if(Microseconds <= ((TIMERONE_RESOLUTION / (F_CPU / 1000000)) * TIMERONE_MAX_PRESCALER * 2)) {
-        ReturnValue = E_OK;
-        /* calculate timer cycles to reach timer period, counter runs backwards after TOP, interrupt is at BOTTOM so divide microseconds by 2 */
-        TimerCycles = (F_CPU / 2000000) * Microseconds;
-        /* calculate timer prescaler */
-        if(TimerCycles < TIMERONE_RESOLUTION)              ClockSelectBitGroup = TIMERONE_REG_CS_NO_PRESCALER;
-        else if((TimerCycles >>= 3) < TIMERONE_RESOLUTION) ClockSelectBitGroup = TIMERONE_REG_CS_PRESCALE_8;
-        else if((TimerCycles >>= 3) < TIMERONE_RESOLUTION) ClockSelectBitGroup = TIMERONE_REG_CS_PRESCALE_64;
-        else if((TimerCycles >>= 2) < TIMERONE_RESOLUTION) ClockSelectBitGroup = TIMERONE_REG_CS_PRESCALE_256;
-        else if((TimerCycles >>= 2) < TIMERONE_RESOLUTION) ClockSelectBitGroup = TIMERONE_REG_CS_PRESCALE_1024;
-        else {
-            /* request was out of bounds, set as maximum */
-            TimerCycles = TIMERONE_RESOLUTION - 1;
-            ClockSelectBitGroup = TIMERONE_REG_CS_PRESCALE_1024;
-            ReturnValue = E_NOT_OK;
-        }
-        /* ICR1 is TOP in phase correct pwm mode */
-        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { ICR1 = TimerCycles; }
+    if(Microseconds <= getMaxPeriod()) {
+        ReturnValue = calcPeriod(Microseconds, &Top, &ClockSelectBitGroup);
+        /* ICR1 is TOP in both pwm modes */
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { ICR1 = Top; }
+        updateDutyCache(Top);
+        updateComplementary();
 
         if(TIMERONE_STATE_RUNNING == State)
         {
@@ -155,6 +173,67 @@ stdReturnType TimerOne::setPeriod(unsigned long Microseconds)
 } /* setPeriod */
 
 
+#if (TIMERONE_SYNC_PERIOD == STD_ON)
+/******************************************************************************************************************************************************
+  setPeriodSync()
+******************************************************************************************************************************************************/
+/*! \brief          change period of running timer at BOTTOM
+ *  \details        the new TOP and prescaler are staged and applied by the overflow interrupt, so no runt or stretched
+ *                  pwm period occurs. The compare buffers are loaded with the scaled duty cycles by the next overflow
+ *                  interrupt, ICR1 and the prescaler are written after the BOTTOM where the compare buffers are taken
+ *                  over, see commitPeriod(). Duty cycles set in between are applied together with the new period.
+ *                  A complementary pair keeps its dead time, it is converted to ticks of the new prescaler.
+ *                  If the timer is not running, the period is set immediately like setPeriod().
+ *  \param[in]      Microseconds				period of the timer overflow interrupt
+ *  \param[in]      sSyncCallback				called by the overflow interrupt when the new period is active
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *****************************************************************************************************************************************************/
+stdReturnType TimerOne::setPeriodSync(unsigned long Microseconds, TimerIsrCallbackF_void sSyncCallback)
+{
+	stdReturnType ReturnValue = E_NOT_OK;
+	unsigned int Top;
+	TimerOneClockSelectType ClockSelect;
+	unsigned long Ticks;
+#if (TIMERONE_COMPLEMENTARY_PWM == STD_ON)
+	unsigned int DeadTimeTicksNew;
+#endif
+
+	if(TIMERONE_STATE_RUNNING != State) return setPeriod(Microseconds);
+	/* was request out of bounds? */
+	if(Microseconds <= getMaxPeriod()) {
+		ReturnValue = calcPeriod(Microseconds, &Top, &ClockSelect);
+#if (TIMERONE_COMPLEMENTARY_PWM == STD_ON)
+		DeadTimeTicksNew = calcDeadTime(DeadTime, ClockSelect);
+#endif
+#if (TIMERONE_DUTY_TABLE == STD_ON)
+		/* a pending change must not read the duty table while it is rebuilt, it is restarted below */
+		SyncState = TIMERONE_SYNC_IDLE;
+		updateDutyCache(Top);
+#endif
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+			SyncTop = Top;
+			SyncClockSelect = ClockSelect;
+			SyncCallback = sSyncCallback;
+#if (TIMERONE_COMPLEMENTARY_PWM == STD_ON)
+			SyncDeadTimeTicks = DeadTimeTicksNew;
+#endif
+			SyncState = TIMERONE_SYNC_PENDING;
+		}
+		if(!(TIMSK1 & (1 << TOIE1))) {
+			/* an overflow flag of a BOTTOM passed before must not commit the period at once. In phase and frequency
+			   correct mode readCounter() clears it and keeps the counting direction it shows. */
+			if(TIMERONE_MODE_FAST_PWM == Mode) TIFR1 = (1 << TOV1);
+			else readCounter(&Ticks);
+		}
+		/* the overflow interrupt commits the period, even without callback */
+		writeBit(TIMSK1, TOIE1, 1);
+	}
+	return ReturnValue;
+} /* setPeriodSync */
+#endif
+
+
 /******************************************************************************************************************************************************
   enablePwm()
 ******************************************************************************************************************************************************/
@@ -171,6 +250,10 @@ stdReturnType TimerOne::enablePwm(TimerOnePwmPinType PwmPin, unsigned int DutyCy
 {
 	stdReturnType ReturnValue = E_NOT_OK;
 
+#if (TIMERONE_COMPLEMENTARY_PWM == STD_ON)
+	/* both pins are used by the complementary pair */
+	if(Complementary) return E_NOT_OK;
+#endif
 	if(TIMERONE_STATE_READY == State || TIMERONE_STATE_RUNNING == State || TIMERONE_STATE_STOPPED == State)
 	{
         ReturnValue = E_OK;
@@ -223,33 +306,46 @@ stdReturnType TimerOne::disablePwm(TimerOnePwmPinType PwmPin)
   setPwmDuty()
 ******************************************************************************************************************************************************/
 /*! \brief          set pwm duty cycle on given pin
- *  \details        
- *                  
+ *  \details        the compare value is calculated from the cached TOP value or read from the duty table, so ICR1
+ *                  is not read
  *  \param[in]      PwmPin					pin where pwm duty cycle should be set
  *  \param[in]      DutyCycle				duty cycle of pwm
  *  \return         E_OK
  *                  E_NOT_OK
- *  \pre			Timer has to be in READY, RUNNING or STOPPED STATE
+ *  \pre			Timer has to be in READY, RUNNING or STOPPED STATE, complementary pwm has to be disabled
  *****************************************************************************************************************************************************/
 stdReturnType TimerOne::setPwmDuty(TimerOnePwmPinType PwmPin, unsigned int DutyCycle)
 {
 	stdReturnType ReturnValue = E_NOT_OK;
-	unsigned long DutyCycleTrans;
+	unsigned int DutyCycleTrans;
 
+#if (TIMERONE_COMPLEMENTARY_PWM == STD_ON)
+	/* an independent compare value would break the dead time */
+	if(Complementary) return E_NOT_OK;
+#endif
 	if(TIMERONE_STATE_READY == State || TIMERONE_STATE_RUNNING == State || TIMERONE_STATE_STOPPED == State) {
 		/* duty cycle out of bound? */
 		if(DutyCycle <= TIMERONE_RESOLUTION) {	
+			DutyCycleTrans = calcCompare(DutyCycle);
 			ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
-				/* use rule of three to calculate duty cycle related to timer top value */
-				DutyCycleTrans = (unsigned long) ICR1 * DutyCycle;
-				DutyCycleTrans >>= TIMERONE_NUMBER_OF_BITS;
 				/* set output compare register value for given pwm pin */
 				if(TIMERONE_PWM_PIN_9 == PwmPin) {
                     ReturnValue = E_OK;
+#if (TIMERONE_SYNC_PERIOD == STD_ON)
+                    /* while a period change is pending, the compare value is loaded by the overflow interrupt */
+                    DutyCycleA = DutyCycle;
+                    if(TIMERONE_SYNC_PENDING != SyncState) OCR1A = DutyCycleTrans;
+#else
                     OCR1A = DutyCycleTrans;
+#endif
 				} else if(TIMERONE_PWM_PIN_10 == PwmPin) {
                     ReturnValue = E_OK;
+#if (TIMERONE_SYNC_PERIOD == STD_ON)
+                    DutyCycleB = DutyCycle;
+                    if(TIMERONE_SYNC_PENDING != SyncState) OCR1B = DutyCycleTrans;
+#else
                     OCR1B = DutyCycleTrans;
+#endif
 				}
 			}
 		}
@@ -258,6 +354,110 @@ stdReturnType TimerOne::setPwmDuty(TimerOnePwmPinType PwmPin, unsigned int DutyC
 } /* setPwmDuty */
 
 
+#if (TIMERONE_COMPLEMENTARY_PWM == STD_ON)
+/******************************************************************************************************************************************************
+  enableComplementaryPwm()
+******************************************************************************************************************************************************/
+/*! \brief          enable complementary pwm on pin 9 and pin 10
+ *  \details        OC1A is non-inverting, OC1B is inverting and its compare value is the one of OC1A plus the dead
+ *                  time. So pin 10 goes high the dead time after pin 9 went low and goes low the dead time before
+ *                  pin 9 goes high again. Only phase and frequency correct mode has a dead time on both edges, in
+ *                  fast pwm mode both pins would switch at BOTTOM at the same time.
+ *                  The dead time is rounded up to timer ticks, it is converted again if the prescaler changes.
+ *                  The compare registers are loaded directly, so the first period after start() has the dead time.
+ *  \param[in]      DutyCycle				duty cycle of pin 9, the dead time is taken from the duty cycle of pin 10
+ *  \param[in]      sDeadTime				dead time in nanoseconds
+ *  \return         E_OK
+ *                  E_NOT_OK if dead time is not shorter than TOP
+ *  \pre			Timer has to be in READY or STOPPED state in phase and frequency correct mode
+ *****************************************************************************************************************************************************/
+stdReturnType TimerOne::enableComplementaryPwm(unsigned int DutyCycle, unsigned int sDeadTime)
+{
+	stdReturnType ReturnValue = E_NOT_OK;
+	unsigned int DeadTimeTicksNew;
+
+	if((TIMERONE_STATE_READY == State || TIMERONE_STATE_STOPPED == State) && TIMERONE_MODE_PHASE_FREQUENCY_CORRECT == Mode) {
+		DeadTimeTicksNew = calcDeadTime(sDeadTime, ClockSelectBitGroup);
+		if(DutyCycle <= TIMERONE_RESOLUTION && DeadTimeTicksNew < PwmPeriod) {
+			ReturnValue = E_OK;
+			DeadTime = sDeadTime;
+			DeadTimeTicks = DeadTimeTicksNew;
+			ComplementaryDuty = DutyCycle;
+			/* compare registers are double buffered in pwm mode, normal mode writes them directly while the clock is stopped */
+			writeBit(TCCR1B, WGM13, 0);
+			ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { writeComplementary(calcCompare(DutyCycle)); }
+			writeBit(TCCR1B, WGM13, 1);
+#if (TIMERONE_SYNC_PERIOD == STD_ON)
+			DutyCycleA = DutyCycle;
+#endif
+			/* activate non-inverting compare output on OC1A and inverting compare output on OC1B */
+			writeBit(TCCR1A, COM1A1, 1);
+			writeBit(TCCR1A, COM1A0, 0);
+			writeBit(TCCR1A, COM1B1, 1);
+			writeBit(TCCR1A, COM1B0, 1);
+			pinMode(TIMERONE_PWM_PIN_9, OUTPUT);
+			pinMode(TIMERONE_PWM_PIN_10, OUTPUT);
+			Complementary = true;
+		}
+	}
+	return ReturnValue;
+} /* enableComplementaryPwm */
+
+
+/******************************************************************************************************************************************************
+  disableComplementaryPwm()
+******************************************************************************************************************************************************/
+/*! \brief          disable complementary pwm on pin 9 and pin 10
+ *  \details        both compare outputs are disconnected, the pins are driven by their port register again
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerOne::disableComplementaryPwm()
+{
+	/* deactivate compare output mode of both pins in timer control register */
+	writeBit(TCCR1A, COM1A1, 0);
+	writeBit(TCCR1A, COM1B1, 0);
+	writeBit(TCCR1A, COM1B0, 0);
+	Complementary = false;
+} /* disableComplementaryPwm */
+
+
+/******************************************************************************************************************************************************
+  setComplementaryDuty()
+******************************************************************************************************************************************************/
+/*! \brief          set duty cycle of complementary pwm
+ *  \details        only one compare value is calculated, the dead time is added in ticks. Both compare registers are
+ *                  written in the same atomic block, so they are taken over at the same BOTTOM.
+ *                  The duty cycle is limited, so pin 10 is low if pin 9 is high for the whole period minus the dead time.
+ *  \param[in]      DutyCycle				duty cycle of pin 9
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre			Complementary pwm has to be enabled
+ *****************************************************************************************************************************************************/
+stdReturnType TimerOne::setComplementaryDuty(unsigned int DutyCycle)
+{
+	stdReturnType ReturnValue = E_NOT_OK;
+	unsigned int Compare;
+
+	if(Complementary && DutyCycle <= TIMERONE_RESOLUTION) {
+		ReturnValue = E_OK;
+		Compare = calcCompare(DutyCycle);
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+			ComplementaryDuty = DutyCycle;
+#if (TIMERONE_SYNC_PERIOD == STD_ON)
+			/* while a period change is pending, the compare values are loaded by the overflow interrupt */
+			DutyCycleA = DutyCycle;
+			if(TIMERONE_SYNC_PENDING != SyncState) writeComplementary(Compare);
+#else
+			writeComplementary(Compare);
+#endif
+		}
+	}
+	return ReturnValue;
+} /* setComplementaryDuty */
+#endif
+
+
 /******************************************************************************************************************************************************
   start()
 ******************************************************************************************************************************************************/
@@ -273,8 +473,10 @@ stdReturnType TimerOne::start()
 	unsigned int TCNT1_tmp;
 
 	if(TIMERONE_STATE_READY == State || TIMERONE_STATE_STOPPED == State) {
-		/* reset counter value */
+		/* reset counter value and direction */
 		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { TCNT1 = 0; }
+		CountingDown = false;
+		TIFR1 = TIMERONE_PHASE_FLAGS;
 		/* start counter by setting clock select register */
 		writeBitGroup(TCCR1B, TIMERONE_REG_CS_GM, TIMERONE_REG_CS_GP, ClockSelectBitGroup);
 		/* set overflow interrupt, if callback is set */
@@ -382,38 +584,11 @@ void TimerOne::detachInterrupt()
 stdReturnType TimerOne::read(unsigned long* Microseconds)
 {
 	stdReturnType ReturnValue = E_NOT_OK;
-	unsigned long TCNT1_tmp;
-	unsigned int CounterValue;
+	unsigned long CounterValue;
 	char PrescaleShiftScale = 0;
 
-	if(TIMERONE_STATE_RUNNING == State) {
-        ReturnValue = E_OK;
-		/* save current timer value */
-		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { CounterValue = TCNT1; }
-		switch (ClockSelectBitGroup)
-		{
-			case TIMERONE_REG_CS_NO_PRESCALER:
-				PrescaleShiftScale = 0;
-				break;
-			case TIMERONE_REG_CS_PRESCALE_8:
-				PrescaleShiftScale = 3;
-				break;
-			case TIMERONE_REG_CS_PRESCALE_64:
-				PrescaleShiftScale = 6;
-				break;
-			case TIMERONE_REG_CS_PRESCALE_256:
-				PrescaleShiftScale = 8;
-				break;
-			case TIMERONE_REG_CS_PRESCALE_1024:
-				PrescaleShiftScale = 10;
-				break;
-			default:
-				ReturnValue = E_NOT_OK;
-		}
-		/* wait one counter tick, needed to find out counter counting up or down */
-		do { ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { TCNT1_tmp = TCNT1; }} while (TCNT1_tmp == CounterValue);
-		/* if counter counting down, add top value to current value */
-		if(TCNT1_tmp < CounterValue) { ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { CounterValue = (int) (ICR1 - CounterValue) + (int) ICR1; }}
+	if(E_OK == readCounter(&CounterValue)) {
+		ReturnValue = getPrescaleShiftScale(ClockSelectBitGroup, &PrescaleShiftScale);
 		/* transform counter value to microseconds in an efficient way */
 		*Microseconds = ((CounterValue * 1000UL) / (F_CPU / 1000UL)) << PrescaleShiftScale;
 	}
@@ -421,13 +596,380 @@ stdReturnType TimerOne::read(unsigned long* Microseconds)
 } /* read */
 
 
+/******************************************************************************************************************************************************
+  readCounter()
+******************************************************************************************************************************************************/
+/*! \brief          read current position in the period in timer ticks
+ *  \details        the counting direction is taken from the TOP (ICF1) and BOTTOM (TOV1) flags, so no waiting for the
+ *                  counter is needed. The result is not scaled by the prescaler.
+ *                  Only if neither the overflow interrupt is enabled nor read was called within half a period, both
+ *                  flags are set and the direction is found out by waiting one counter tick.
+ *                  In fast pwm mode the counter only counts up, so it is the position in the period.
+ *  \param[out]     Ticks				timer ticks since BOTTOM, up to two times TOP
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre			Timer has to be in RUNNING STATE
+ *****************************************************************************************************************************************************/
+stdReturnType TimerOne::readCounter(unsigned long* Ticks)
+{
+	stdReturnType ReturnValue = E_NOT_OK;
+	unsigned int CounterValue;
+	unsigned int CounterValueNext;
+	unsigned int Top;
+	byte Flags;
+
+	if(TIMERONE_STATE_RUNNING == State && TIMERONE_MODE_FAST_PWM == Mode) {
+		ReturnValue = E_OK;
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { *Ticks = TCNT1; }
+	} else if(TIMERONE_STATE_RUNNING == State) {
+		ReturnValue = E_OK;
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+			/* save current timer value, read it again if TOP or BOTTOM was passed while reading */
+			Flags = TIFR1 & TIMERONE_PHASE_FLAGS;
+			CounterValue = TCNT1;
+			if(Flags != (TIFR1 & TIMERONE_PHASE_FLAGS)) {
+				Flags = TIFR1 & TIMERONE_PHASE_FLAGS;
+				CounterValue = TCNT1;
+			}
+			Top = ICR1;
+			if((1 << ICF1) == Flags) {
+				/* TOP was passed since last BOTTOM */
+				CountingDown = true;
+			} else if(Flags & (1 << TOV1)) {
+				if(((1 << TOV1) == Flags) || (TIMSK1 & (1 << TOIE1))) {
+					/* BOTTOM was passed, pending overflow interrupt means BOTTOM was passed last */
+					CountingDown = false;
+				} else {
+					/* TOP and BOTTOM were passed, wait one counter tick, needed to find out counter counting up or down */
+					do { CounterValueNext = TCNT1; } while (CounterValueNext == CounterValue);
+					CountingDown = (CounterValueNext < CounterValue);
+				}
+			}
+			/* clear evaluated flags, a pending overflow interrupt is cleared by hardware */
+			if(TIMSK1 & (1 << TOIE1)) Flags &= ~(1 << TOV1);
+			TIFR1 = Flags;
+		}
+		/* if counter counting down, add top value to current value */
+		if(CountingDown) *Ticks = (2UL * Top) - CounterValue;
+		else *Ticks = CounterValue;
+	}
+	return ReturnValue;
+} /* readCounter */
+
+
+/******************************************************************************************************************************************************
+  getPwmFrequency()
+******************************************************************************************************************************************************/
+/*! \brief          read pwm frequency of current period and mode
+ *  \details        fast pwm has twice the frequency of phase and frequency correct pwm at the same TOP, the
+ *                  resolution is given by getPwmResolution()
+ *  \param[out]     Frequency			pwm frequency in hertz, rounded down
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre			Timer has to be in READY, RUNNING or STOPPED state
+ *****************************************************************************************************************************************************/
+stdReturnType TimerOne::getPwmFrequency(unsigned long* Frequency)
+{
+	stdReturnType ReturnValue = E_NOT_OK;
+	char PrescaleShiftScale;
+	unsigned long TicksPerPeriod;
+
+	if(TIMERONE_STATE_READY == State || TIMERONE_STATE_RUNNING == State || TIMERONE_STATE_STOPPED == State) {
+		ReturnValue = getPrescaleShiftScale(ClockSelectBitGroup, &PrescaleShiftScale);
+		/* single slope counts from BOTTOM to TOP, dual slope up and down again */
+		if(TIMERONE_MODE_FAST_PWM == Mode) TicksPerPeriod = PwmPeriod + 1UL;
+		else TicksPerPeriod = 2UL * PwmPeriod;
+		if(E_OK == ReturnValue && TicksPerPeriod != 0) *Frequency = (F_CPU >> PrescaleShiftScale) / TicksPerPeriod;
+		else ReturnValue = E_NOT_OK;
+	}
+	return ReturnValue;
+} /* getPwmFrequency */
+
+
+/******************************************************************************************************************************************************
+  overflowInterrupt()
+******************************************************************************************************************************************************/
+/*! \brief          handle timer overflow interrupt
+ *  \details        counter is at BOTTOM, so it counts up again. In fast pwm mode the interrupt is at TOP.
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerOne::overflowInterrupt()
+{
+	enterOverflowInterrupt();
+	/* overflow interrupt may be enabled by setPeriodSync() only */
+	if(TimerOverflowCallback != NULL) TimerOverflowCallback();
+} /* overflowInterrupt */
+
+
+/******************************************************************************************************************************************************
+ * P R I V A T E   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  calcPeriod()
+******************************************************************************************************************************************************/
+/*! \brief          calculate prescaler and timer top value of a period
+ *  \details
+ *
+ *  \param[in]      Microseconds				period of the timer overflow interrupt
+ *  \param[out]     Top						timer top value
+ *  \param[out]     ClockSelect				clock select bit group of the prescaler
+ *  \return         E_OK
+ *                  E_NOT_OK if period is too long, then it is set to the maximum
+ *****************************************************************************************************************************************************/
+stdReturnType TimerOne::calcPeriod(unsigned long Microseconds, unsigned int* Top, TimerOneClockSelectType* ClockSelect)
+{
+	stdReturnType ReturnValue = E_OK;
+	unsigned long TimerCycles;
+
+	/* calculate timer cycles to reach timer period, in dual slope mode counter runs backwards after TOP, interrupt is at BOTTOM so divide microseconds by 2 */
+	if(TIMERONE_MODE_FAST_PWM == Mode) TimerCycles = (F_CPU / 1000000) * Microseconds;
+	else TimerCycles = (F_CPU / 2000000) * Microseconds;
+
+	/* calculate timer prescaler */
+	if(TimerCycles < TIMERONE_RESOLUTION)              *ClockSelect = TIMERONE_REG_CS_NO_PRESCALER;
+	else if((TimerCycles >>= 3) < TIMERONE_RESOLUTION) *ClockSelect = TIMERONE_REG_CS_PRESCALE_8;
+	else if((TimerCycles >>= 3) < TIMERONE_RESOLUTION) *ClockSelect = TIMERONE_REG_CS_PRESCALE_64;
+	else if((TimerCycles >>= 2) < TIMERONE_RESOLUTION) *ClockSelect = TIMERONE_REG_CS_PRESCALE_256;
+	else if((TimerCycles >>= 2) < TIMERONE_RESOLUTION) *ClockSelect = TIMERONE_REG_CS_PRESCALE_1024;
+	else {
+		/* request was out of bounds, set as maximum */
+		TimerCycles = TIMERONE_RESOLUTION - 1;
+		*ClockSelect = TIMERONE_REG_CS_PRESCALE_1024;
+		ReturnValue = E_NOT_OK;
+	}
+	/* single slope period is TOP + 1 timer cycles */
+	if(TIMERONE_MODE_FAST_PWM == Mode && TimerCycles > 0) TimerCycles--;
+	*Top = TimerCycles;
+	return ReturnValue;
+} /* calcPeriod */
+
+
+/******************************************************************************************************************************************************
+  getPrescaleShiftScale()
+******************************************************************************************************************************************************/
+/*! \brief          get prescaler as power of two
+ *  \details
+ *
+ *  \param[in]      ClockSelect				clock select bit group of the prescaler
+ *  \param[out]     PrescaleShiftScale		prescaler of given clock select
+ *  \return         E_OK
+ *                  E_NOT_OK if no clock is selected
+ *****************************************************************************************************************************************************/
+stdReturnType TimerOne::getPrescaleShiftScale(TimerOneClockSelectType ClockSelect, char* PrescaleShiftScale) const
+{
+	stdReturnType ReturnValue = E_OK;
+
+	switch (ClockSelect)
+	{
+		case TIMERONE_REG_CS_NO_PRESCALER:
+			*PrescaleShiftScale = 0;
+			break;
+		case TIMERONE_REG_CS_PRESCALE_8:
+			*PrescaleShiftScale = 3;
+			break;
+		case TIMERONE_REG_CS_PRESCALE_64:
+			*PrescaleShiftScale = 6;
+			break;
+		case TIMERONE_REG_CS_PRESCALE_256:
+			*PrescaleShiftScale = 8;
+			break;
+		case TIMERONE_REG_CS_PRESCALE_1024:
+			*PrescaleShiftScale = 10;
+			break;
+		default:
+			*PrescaleShiftScale = 0;
+			ReturnValue = E_NOT_OK;
+	}
+	return ReturnValue;
+} /* getPrescaleShiftScale */
+
+
+/******************************************************************************************************************************************************
+  calcCompare()
+******************************************************************************************************************************************************/
+/*! \brief          calculate compare value of a duty cycle
+ *  \details        the compare value is calculated from the cached TOP value or read from the duty table
+ *
+ *  \param[in]      DutyCycle				duty cycle of pwm
+ *  \return         compare value
+ *****************************************************************************************************************************************************/
+unsigned int TimerOne::calcCompare(unsigned int DutyCycle) const
+{
+#if (TIMERONE_DUTY_TABLE == STD_ON)
+	return DutyTable[DutyCycle >> (TIMERONE_NUMBER_OF_BITS - 8)];
+#else
+	/* use rule of three to calculate duty cycle related to timer top value, 16 x 16 bit multiplication */
+	return ((unsigned long) PwmPeriod * DutyCycle) >> TIMERONE_NUMBER_OF_BITS;
+#endif
+} /* calcCompare */
+
+
+#if (TIMERONE_SYNC_PERIOD == STD_ON)
+/******************************************************************************************************************************************************
+  commitPeriod()
+******************************************************************************************************************************************************/
+/*! \brief          apply staged period
+ *  \details        this function is called by the overflow interrupt. In phase and frequency correct mode the counter
+ *                  has just left BOTTOM, the first call loads the compare buffers, which are taken over at the next
+ *                  BOTTOM. The second call writes ICR1 and the prescaler right after that BOTTOM, so the whole period
+ *                  uses the new values.
+ *                  In fast pwm mode the interrupt is at TOP. The counter is held at TOP while the compare buffers are
+ *                  loaded, so they are taken over at the BOTTOM which follows, and ICR1 and the prescaler are written
+ *                  by the same call after the counter left TOP, which takes one timer tick at most. If the counter
+ *                  has already left TOP, the interrupt was late and the next call writes them.
+ *                  If the counter has already counted after BOTTOM when the prescaler is changed, it is converted to
+ *                  ticks of the new prescaler.
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerOne::commitPeriod()
+{
+	/* ICR1 is not double buffered, in fast pwm mode it is TOP of the running period */
+	unsigned int Top = (TIMERONE_MODE_FAST_PWM == Mode) ? ICR1 : 0;
+	unsigned int CompareA;
+	unsigned int CompareB;
+	unsigned long Ticks;
+	char OldShiftScale;
+	char NewShiftScale;
+	bool AtTop;
+
+	if(TIMERONE_SYNC_PENDING == SyncState) {
+		PwmPeriod = SyncTop;
+		CompareA = calcCompare(DutyCycleA);
+		CompareB = calcCompare(DutyCycleB);
+		if(TIMERONE_MODE_FAST_PWM == Mode && TCNT1 == Top) writeBitGroup(TCCR1B, TIMERONE_REG_CS_GM, TIMERONE_REG_CS_GP, TIMERONE_REG_CS_NO_CLOCK);
+#if (TIMERONE_COMPLEMENTARY_PWM == STD_ON)
+		if(Complementary) {
+			/* dead time in ticks of the new prescaler, which is taken over at the same BOTTOM */
+			DeadTimeTicks = SyncDeadTimeTicks;
+			writeComplementary(CompareA);
+		} else {
+			OCR1A = CompareA;
+			OCR1B = CompareB;
+		}
+#else
+		OCR1A = CompareA;
+		OCR1B = CompareB;
+#endif
+		SyncState = TIMERONE_SYNC_COMPARE_LOADED;
+		if(TIMERONE_MODE_FAST_PWM != Mode) return;
+		AtTop = (TCNT1 == Top);
+		writeBitGroup(TCCR1B, TIMERONE_REG_CS_GM, TIMERONE_REG_CS_GP, ClockSelectBitGroup);
+		if(!AtTop) return;
+	}
+	/* in fast pwm mode ICR1 is written after BOTTOM too, the new TOP would be missed if it was below the counter */
+	if(TIMERONE_MODE_FAST_PWM == Mode) while(TCNT1 == Top);
+	Ticks = TCNT1;
+	ICR1 = SyncTop;
+	getPrescaleShiftScale(ClockSelectBitGroup, &OldShiftScale);
+	getPrescaleShiftScale(SyncClockSelect, &NewShiftScale);
+	ClockSelectBitGroup = SyncClockSelect;
+	writeBitGroup(TCCR1B, TIMERONE_REG_CS_GM, TIMERONE_REG_CS_GP, ClockSelectBitGroup);
+	if(Ticks > 0) {
+		/* interrupt was late, the ticks since BOTTOM were counted with the old prescaler */
+		Ticks = (Ticks << OldShiftScale) >> NewShiftScale;
+		TCNT1 = (Ticks < SyncTop) ? Ticks : SyncTop;
+	}
+	SyncState = TIMERONE_SYNC_IDLE;
+	if(TimerOverflowCallback == NULL) writeBit(TIMSK1, TOIE1, 0);
+	if(SyncCallback != NULL) SyncCallback();
+} /* commitPeriod */
+#endif
+
+
+/******************************************************************************************************************************************************
+  updateDutyCache()
+******************************************************************************************************************************************************/
+/*! \brief          update cached TOP value and duty table
+ *  \details        this function is called by setPeriod, only then TOP changes
+ *                  
+ *  \param[in]      Top						new value of ICR1
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerOne::updateDutyCache(unsigned int Top)
+{
+	PwmPeriod = Top;
+#if (TIMERONE_DUTY_TABLE == STD_ON)
+	for(unsigned int Index = 0; Index < TIMERONE_DUTY_TABLE_SIZE; Index++) {
+		DutyTable[Index] = ((unsigned long) Top * Index) >> 8;
+	}
+#endif
+} /* updateDutyCache */
+
+
+/******************************************************************************************************************************************************
+  updateComplementary()
+******************************************************************************************************************************************************/
+/*! \brief          update dead time and compare values of complementary pwm
+ *  \details        this function is called by setPeriod after TOP and prescaler were changed. The compare values are
+ *                  taken over at the next BOTTOM, but the new prescaler is active at once, use setPeriodSync() to
+ *                  keep the dead time while a complementary pair is running.
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerOne::updateComplementary()
+{
+#if (TIMERONE_COMPLEMENTARY_PWM == STD_ON)
+	if(Complementary) {
+		DeadTimeTicks = calcDeadTime(DeadTime, ClockSelectBitGroup);
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { writeComplementary(calcCompare(ComplementaryDuty)); }
+	}
+#endif
+} /* updateComplementary */
+
+
+#if (TIMERONE_COMPLEMENTARY_PWM == STD_ON)
+/******************************************************************************************************************************************************
+  calcDeadTime()
+******************************************************************************************************************************************************/
+/*! \brief          calculate dead time in timer ticks
+ *  \details        the dead time is rounded up, so it never gets shorter than requested
+ *
+ *  \param[in]      Nanoseconds				dead time
+ *  \param[in]      ClockSelect				clock select bit group of the prescaler
+ *  \return         dead time in timer ticks
+ *****************************************************************************************************************************************************/
+unsigned int TimerOne::calcDeadTime(unsigned int Nanoseconds, TimerOneClockSelectType ClockSelect) const
+{
+	char PrescaleShiftScale;
+	unsigned long DeadTimeCycles;
+
+	getPrescaleShiftScale(ClockSelect, &PrescaleShiftScale);
+	DeadTimeCycles = ((unsigned long) Nanoseconds * (F_CPU / 1000000) + 999) / 1000;
+	return (DeadTimeCycles + (1UL << PrescaleShiftScale) - 1) >> PrescaleShiftScale;
+} /* calcDeadTime */
+
+
+/******************************************************************************************************************************************************
+  writeComplementary()
+******************************************************************************************************************************************************/
+/*! \brief          write compare registers of complementary pwm
+ *  \details        OCR1B is OCR1A plus the dead time, up to TOP where the inverting output is continuously low.
+ *                  Has to be called with interrupts disabled.
+ *  \param[in]      Compare					compare value of OC1A
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerOne::writeComplementary(unsigned int Compare)
+{
+	unsigned int CompareMax = (DeadTimeTicks < PwmPeriod) ? (PwmPeriod - DeadTimeTicks) : 0;
+
+	if(Compare > CompareMax) Compare = CompareMax;
+	OCR1A = Compare;
+	/* dead time longer than the period, both outputs stay low */
+	OCR1B = (DeadTimeTicks < PwmPeriod) ? (Compare + DeadTimeTicks) : PwmPeriod;
+} /* writeComplementary */
+#endif
+
+
 /******************************************************************************************************************************************************
   I S R   F U N C T I O N S
 ******************************************************************************************************************************************************/
+#if (TIMERONE_STATIC_ISR == STD_OFF)
 ISR(TIMER1_OVF_vect)
 {
-	Timer1.TimerOverflowCallback();
+	Timer1.overflowInterrupt();
 }
+#endif
 
 
 /******************************************************************************************************************************************************
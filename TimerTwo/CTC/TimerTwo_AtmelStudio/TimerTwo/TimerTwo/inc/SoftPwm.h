@@ -0,0 +1,152 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       SoftPwm.h
+ *      \brief      Main header file of SoftPwm library
+ *
+ *      \details    Software pwm on up to 24 port pins driven by Timer2. The duty cycles are sorted into a list of
+ *                  edges, channels with the same duty cycle share one edge. The Timer2 compare B interrupt applies
+ *                  each edge with one toggle store per port, so the interrupt load depends on the number of distinct
+ *                  duty cycles and not on the number of channels.
+ *
+ *****************************************************************************************************************************************************/
+#ifndef _SOFTPWM_H_
+#define _SOFTPWM_H_
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include "Arduino.h"
+#include <StandardTypes.h>
+#include <TimerTwo.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+#define SOFTPWM_MAX_CHANNELS                        24u
+#define SOFTPWM_MAX_DUTY                            255u
+
+/* edge index of the frame start */
+#define SOFTPWM_FRAME_START                         0xFFu
+
+/******************************************************************************************************************************************************
+ *  LOCAL FUNCTION MACROS
+ *****************************************************************************************************************************************************/
+
+
+/******************************************************************************************************************************************************
+ *  GLOBAL DATA TYPES AND STRUCTURES
+ *****************************************************************************************************************************************************/
+
+
+/******************************************************************************************************************************************************
+ *  CLASS  SoftPwm
+ *****************************************************************************************************************************************************/
+class SoftPwm
+{
+/******************************************************************************************************************************************************
+ *  P U B L I C   D A T A   T Y P E S   A N D   S T R U C T U R E S
+******************************************************************************************************************************************************/
+  public:
+    /* Type which describes the internal state of the SoftPwm */
+    enum StateType {
+        STATE_INIT,
+        STATE_READY,
+        STATE_RUNNING
+    };
+
+    /* Type which includes the ports of the channels */
+    enum PortType {
+        PORT_B,
+        PORT_C,
+        PORT_D,
+        NUMBER_OF_PORTS
+    };
+
+/******************************************************************************************************************************************************
+ *  P R I V A T E   D A T A   A N D   F U N C T I N O N S
+******************************************************************************************************************************************************/
+  private:
+    /* channels switched off at Tick, one toggle mask per port */
+    struct EdgeType {
+        byte Tick;
+        byte Toggle[NUMBER_OF_PORTS];
+    };
+
+    struct ScheduleType {
+        EdgeType Edges[SOFTPWM_MAX_CHANNELS];
+        byte Length;
+        /* channels which are high at the start of the frame */
+        byte On[NUMBER_OF_PORTS];
+        /* channels which are high for the whole frame */
+        byte Full[NUMBER_OF_PORTS];
+    };
+
+    struct ChannelType {
+        PortType Port;
+        byte Mask;
+        byte Duty;
+    };
+
+    SoftPwm();
+    ~SoftPwm();
+    SoftPwm(const SoftPwm&);
+
+    StateType State;
+    ChannelType Channels[SOFTPWM_MAX_CHANNELS];
+    byte NumberOfChannels;
+    byte Mask[NUMBER_OF_PORTS];
+    ScheduleType Schedules[2];
+    /* schedule which is applied by the interrupt */
+    ScheduleType* Active;
+    /* schedule which is taken over at the next frame start, NULL if the buffer is free */
+    ScheduleType* volatile Next;
+    byte EdgeIndex;
+    /* toggle masks of the next frame start */
+    byte Start[NUMBER_OF_PORTS];
+    /* channels which are high at the end of the frame */
+    byte Full[NUMBER_OF_PORTS];
+    /* timer ticks of a frame minus one (OCR2A) */
+    byte Top;
+
+    void buildSchedule(ScheduleType&) const;
+    void prepareFrame();
+
+/******************************************************************************************************************************************************
+ *  P U B L I C   F U N C T I O N S
+******************************************************************************************************************************************************/
+  public:
+    static SoftPwm& getInstance();
+
+    // get methods
+    StateType getState() const { return State; }
+    byte getNumberOfChannels() const { return NumberOfChannels; }
+    byte getNumberOfEdges() const { return Active->Length; }
+    boolean isUpdatePending() const;
+
+    // set methods
+    stdReturnType init(unsigned long);
+    stdReturnType addChannel(PortType, byte);
+    stdReturnType setDuty(byte, byte);
+    stdReturnType update();
+    stdReturnType start();
+    void stop();
+    void edgeInterrupt();
+};
+
+/* SoftPwm will be pre-instantiated in SoftPwm source file */
+extern SoftPwm& SoftwarePwm;
+
+#endif
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
@@ -12,7 +12,8 @@
  *      \brief      Main header file of TimerTwo library
  *
  *      \details    Arduino library to use Timer two
- *                  
+ *                  Timer2 runs in CTC mode driven by HwTimer2Ctc (see HwTimer.h), this library adds post-scaler,
+ *                  tone and real time clock.
  *
  *****************************************************************************************************************************************************/
 #ifndef _TIMERTWO_H_
@@ -24,7 +25,9 @@
 #include "Arduino.h"
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <avr/sleep.h>
 #include <StandardTypes.h>
+#include <HwTimer.h>
 
 
 /******************************************************************************************************************************************************
@@ -39,6 +42,44 @@
 
 #define TIMERTWO_MAX_PRESCALER						1024
 
+/* periods longer than the hardware allows are extended by a software post-scaler in the compare interrupt, it costs a
+   down-counter in every compare interrupt */
+#ifndef TIMERTWO_POSTSCALER
+#define TIMERTWO_POSTSCALER							STD_OFF
+#endif
+
+/* the post-scaler counts the longest hardware period, so the compare interrupt is as rare as possible */
+#define TIMERTWO_POSTSCALER_TOP						255
+#define TIMERTWO_POSTSCALER_PERIOD_CYCLES			((TIMERTWO_POSTSCALER_TOP + 1UL) * TIMERTWO_MAX_PRESCALER)
+
+/* square wave on OC2A (Arduino pin 11) in compare output toggle mode */
+#ifndef TIMERTWO_TONE
+#define TIMERTWO_TONE								STD_OFF
+#endif
+#define TIMERTWO_TONE_PIN							11
+/* duration of a tone counted by Timer1 overflows, needs the Timer1 overflow interrupt */
+#ifndef TIMERTWO_TONE_DURATION
+#define TIMERTWO_TONE_DURATION						STD_OFF
+#endif
+/* Timer1 runs with prescaler 1024 while a tone with duration is played */
+#define TIMERTWO_TONE_TICK_FREQUENCY				(F_CPU / 1024UL)
+#if (TIMERTWO_TONE_DURATION == STD_ON) && (TIMERTWO_TONE == STD_OFF)
+# error "TIMERTWO_TONE_DURATION needs TIMERTWO_TONE"
+#endif
+
+/* real time clock from a 32.768 kHz watch crystal on TOSC1/TOSC2, Timer2 keeps running in power-save sleep */
+#ifndef TIMERTWO_RTC
+#define TIMERTWO_RTC								STD_OFF
+#endif
+#define TIMERTWO_RTC_CRYSTAL_FREQUENCY				32768UL
+/* prescaler 128, the counter overflows once per second */
+#define TIMERTWO_RTC_TICK_FREQUENCY					(TIMERTWO_RTC_CRYSTAL_FREQUENCY / 128)
+/* a compare match one tick ahead may pass before OCR2A is transferred to the asynchronous clock domain, it is waited
+   for without sleep */
+#define TIMERTWO_RTC_MIN_SLEEP_TICKS				2
+/* update busy flags of all registers of the asynchronous clock domain */
+#define TIMERTWO_RTC_BUSY_MASK						((1 << TCN2UB) | (1 << OCR2AUB) | (1 << OCR2BUB) | (1 << TCR2AUB) | (1 << TCR2BUB))
+
 /******************************************************************************************************************************************************
  *  LOCAL FUNCTION MACROS
  *****************************************************************************************************************************************************/
@@ -48,16 +89,7 @@
  *  GLOBAL DATA TYPES AND STRUCTURES
  *****************************************************************************************************************************************************/
 /* Timer ISR callback function */
-typedef void (*TimerIsrCallbackF_void)(void);
-
-/* Type which describes the internal state of the TimerTwo */
-typedef enum {
-	TIMERTWO_STATE_NONE,
-	TIMERTWO_STATE_INIT,
-	TIMERTWO_STATE_READY,
-	TIMERTWO_STATE_RUNNING,
-	TIMERTWO_STATE_STOPPED
-} TimerTwoStateType;
+typedef HwTimer2Ctc::TimerIsrCallbackF_void TimerIsrCallbackF_void;
 
 /* Type which includes the values of the Clock Select Bit Group */
 typedef enum {
@@ -71,6 +103,21 @@ typedef enum {
 	TIMERTWO_REG_CS_PRESCALE_1024
 } TimerTwoClockSelectType;
 
+/* Type which describes a calendar date and time */
+typedef struct {
+	unsigned int Year;
+	/* 1 to 12 */
+	byte Month;
+	/* 1 to 31 */
+	byte Day;
+	byte Hour;
+	byte Minute;
+	byte Second;
+	/* 0 is sunday */
+	byte Weekday;
+} TimerTwoDateTimeType;
+
+
 
 /******************************************************************************************************************************************************
  *  CLASS  TimerTwo
@@ -82,22 +129,89 @@ class TimerTwo
   	~TimerTwo();
   	TimerTwo(const TimerTwo&);
 
-	TimerTwoStateType State;
-	TimerTwoClockSelectType ClockSelectBitGroup;
+#if (TIMERTWO_POSTSCALER == STD_ON)
+	/* hardware periods until the next callback, counted down by the compare interrupt */
+	unsigned long PostscalerCount;
+	unsigned long PostscalerReload;
+	/* cpu cycles the period is longer than PostscalerReload hardware periods */
+	unsigned long PostscalerRemainder;
+	/* cpu cycles the next callback is early, negative if it is late */
+	long PostscalerError;
+#endif
+#if (TIMERTWO_TONE == STD_ON)
+#if (TIMERTWO_TONE_DURATION == STD_ON)
+	/* Timer1 overflows until the end of the tone */
+	volatile unsigned long ToneOverflows;
+#endif
+	volatile boolean TonePlaying;
+	/* OCR2A of the period, restored by noTone() */
+	byte ToneSavedTop;
+#endif
+#if (TIMERTWO_RTC == STD_ON)
+	/* seconds since start of the real time clock, extends the counter to getRtcTicks() */
+	volatile unsigned long RtcOverflows;
+	/* seconds since 1970-01-01 00:00:00 */
+	volatile unsigned long RtcTime;
+	boolean RtcRunning;
+	void syncRtc();
+#endif
+	void setPostscaler(unsigned long, unsigned long);
 
   public:
 	static TimerTwo& getInstance();
-	TimerIsrCallbackF_void TimerOverflowCallback;
 	stdReturnType init(long = 1000, TimerIsrCallbackF_void = NULL);
 	stdReturnType setPeriod(unsigned long);
+	template <unsigned long Microseconds> stdReturnType setPeriod();
 	stdReturnType start();
 	void stop();
 	stdReturnType resume();
 	stdReturnType attachInterrupt(TimerIsrCallbackF_void);
 	void detachInterrupt();
 	stdReturnType read(unsigned int*);
+#if (TIMERTWO_POSTSCALER == STD_ON)
+	void getPostscalerError(long*);
+#endif
+#if (TIMERTWO_TONE == STD_ON)
+	stdReturnType tone(unsigned int, unsigned long = 0);
+	void noTone();
+	boolean isTonePlaying() const { return TonePlaying; }
+#if (TIMERTWO_TONE_DURATION == STD_ON)
+	void toneInterrupt();
+#endif
+#endif
+#if (TIMERTWO_RTC == STD_ON)
+	stdReturnType initRtc(TimerIsrCallbackF_void = NULL);
+	boolean isRtcRunning() const { return RtcRunning; }
+	unsigned long getRtcTicks();
+	stdReturnType sleepUntil(unsigned long);
+	void setTime(unsigned long);
+	unsigned long getTime();
+	stdReturnType setDateTime(const TimerTwoDateTimeType*);
+	void getDateTime(TimerTwoDateTimeType*);
+	void rtcInterrupt();
+#endif
+	void compareInterrupt();
 };
 
+
+
+/******************************************************************************************************************************************************
+  setPeriod()
+******************************************************************************************************************************************************/
+/*! \brief          set period of Timer2 compare interrupt at compile time
+ *  \details        prescaler and timer top value are calculated during compilation by HwTimer2Ctc, so only the
+ *                  register stores remain. Out of bounds requests, from 16384 microseconds at 16 MHz, fail to
+ *                  compile, the post-scaler is not used.
+ *  \tparam         Microseconds				period of the timer compare interrupt
+ *  \return         E_OK
+ *****************************************************************************************************************************************************/
+template <unsigned long Microseconds>
+stdReturnType TimerTwo::setPeriod()
+{
+	setPostscaler(1, 0);
+	return HwTimer2Ctc::setPeriod<Microseconds>();
+} /* setPeriod */
+
 /* TimerTwo will be pre-instantiated in TimerTwo source file */
 extern TimerTwo& Timer2;
 
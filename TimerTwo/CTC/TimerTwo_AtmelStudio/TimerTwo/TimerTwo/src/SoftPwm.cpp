@@ -0,0 +1,431 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       SoftPwm.cpp
+ *      \brief      Main file of SoftPwm library
+ *
+ *      \details    Software pwm on port pins driven by the Timer2 compare B interrupt.
+ *
+ *
+ *****************************************************************************************************************************************************/
+#define _SOFTPWM_SOURCE_
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include "SoftPwm.h"
+#include <util/atomic.h>
+
+
+/******************************************************************************************************************************************************
+ * GLOBAL DATA
+ *****************************************************************************************************************************************************/
+SoftPwm& SoftwarePwm = SoftPwm::getInstance();              // pre-instantiate SoftPwm
+
+
+/******************************************************************************************************************************************************
+ * C O N S T R U C T O R S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  CONSTRUCTOR OF SoftPwm
+******************************************************************************************************************************************************/
+/*! \brief          SoftPwm constructor
+ *  \details        Instantiation of the SoftPwm library
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+SoftPwm::SoftPwm()
+{
+    State = STATE_INIT;
+    NumberOfChannels = 0u;
+    Schedules[0].Length = 0u;
+    Schedules[1].Length = 0u;
+    for(byte Port = 0u; Port < NUMBER_OF_PORTS; Port++) {
+        Mask[Port] = 0u;
+        Start[Port] = 0u;
+        Full[Port] = 0u;
+        Schedules[0].On[Port] = 0u;
+        Schedules[0].Full[Port] = 0u;
+    }
+    Active = &Schedules[0];
+    Next = NULL;
+    EdgeIndex = SOFTPWM_FRAME_START;
+    Top = 0u;
+} /* SoftPwm */
+
+
+/******************************************************************************************************************************************************
+  DESTRUCTOR OF SoftPwm
+******************************************************************************************************************************************************/
+SoftPwm::~SoftPwm()
+{
+
+} /* ~SoftPwm */
+
+
+/******************************************************************************************************************************************************
+  COPY CONSTRUCTOR OF SoftPwm
+******************************************************************************************************************************************************/
+SoftPwm& SoftPwm::getInstance()
+{
+    static SoftPwm SingletonInstance;
+    return SingletonInstance;
+}
+
+
+/******************************************************************************************************************************************************
+ * P U B L I C   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  init()
+******************************************************************************************************************************************************/
+/*! \brief          initialization of the software pwm
+ *  \details        this function sets the Timer2 period to one pwm frame. A frame has OCR2A + 1 timer ticks, the
+ *                  duty cycles are scaled to them. The frame has to fit into one hardware period of Timer2.
+ *  \param[in]      FrameMicroseconds           period of the pwm
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre            Timer2 has to be initialized, its compare B interrupt is used by the software pwm
+ *****************************************************************************************************************************************************/
+stdReturnType SoftPwm::init(unsigned long FrameMicroseconds)
+{
+    stdReturnType ReturnValue = E_NOT_OK;
+
+    /* the post-scaler of Timer2 cannot be used for a frame */
+    if((STATE_INIT == State) && (FrameMicroseconds <= ((TIMERTWO_RESOLUTION / (F_CPU / 1000000)) * TIMERTWO_MAX_PRESCALER))) {
+        if(E_OK == Timer2.setPeriod(FrameMicroseconds)) {
+            ReturnValue = E_OK;
+            Top = OCR2A;
+            State = STATE_READY;
+        }
+    }
+    return ReturnValue;
+} /* init */
+
+
+/******************************************************************************************************************************************************
+  addChannel()
+******************************************************************************************************************************************************/
+/*! \brief          add port pin as pwm channel
+ *  \details        the pin is set to output low. Channels are numbered in the order they are added, their duty cycle
+ *                  is 0 until update() is called.
+ *  \param[in]      Port                        port of the pin
+ *  \param[in]      Bit                         bit of the pin in the port register
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre            Software pwm has to be initialized and not running
+ *****************************************************************************************************************************************************/
+stdReturnType SoftPwm::addChannel(PortType Port, byte Bit)
+{
+    stdReturnType ReturnValue = E_NOT_OK;
+    byte PinMask;
+
+    if((STATE_READY == State) && (NumberOfChannels < SOFTPWM_MAX_CHANNELS) && (Port < NUMBER_OF_PORTS) && (Bit < 8u)) {
+        PinMask = 1u << Bit;
+        /* pin is already a channel? */
+        if(0u == (Mask[Port] & PinMask)) {
+            ReturnValue = E_OK;
+            Channels[NumberOfChannels].Port = Port;
+            Channels[NumberOfChannels].Mask = PinMask;
+            Channels[NumberOfChannels].Duty = 0u;
+            NumberOfChannels++;
+            Mask[Port] |= PinMask;
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+                if(PORT_B == Port) {
+                    PORTB &= ~PinMask;
+                    DDRB |= PinMask;
+                } else if(PORT_C == Port) {
+                    PORTC &= ~PinMask;
+                    DDRC |= PinMask;
+                } else {
+                    PORTD &= ~PinMask;
+                    DDRD |= PinMask;
+                }
+            }
+        }
+    }
+    return ReturnValue;
+} /* addChannel */
+
+
+/******************************************************************************************************************************************************
+  setDuty()
+******************************************************************************************************************************************************/
+/*! \brief          set duty cycle of a channel
+ *  \details        the duty cycle is applied by the next update(), so several channels change in the same frame
+ *
+ *  \param[in]      Channel                     number of channel
+ *  \param[in]      Duty                        duty cycle, SOFTPWM_MAX_DUTY is always high
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *****************************************************************************************************************************************************/
+stdReturnType SoftPwm::setDuty(byte Channel, byte Duty)
+{
+    if(Channel < NumberOfChannels) {
+        Channels[Channel].Duty = Duty;
+        return E_OK;
+    } else {
+        return E_NOT_OK;
+    }
+} /* setDuty */
+
+
+/******************************************************************************************************************************************************
+  update()
+******************************************************************************************************************************************************/
+/*! \brief          apply duty cycles of all channels
+ *  \details        the edges are sorted into the free schedule, the interrupt takes it over at the next frame start.
+ *                  So all channels change in the same frame and no frame is cut short.
+ *  \return         E_OK
+ *                  E_NOT_OK                    the previous update is still pending
+ *  \pre            Software pwm has to be initialized
+ *****************************************************************************************************************************************************/
+stdReturnType SoftPwm::update()
+{
+    stdReturnType ReturnValue = E_NOT_OK;
+    ScheduleType* Schedule;
+
+    if((STATE_INIT != State) && !isUpdatePending()) {
+        ReturnValue = E_OK;
+        /* active schedule is not swapped by the interrupt while no update is pending */
+        Schedule = (Active == &Schedules[0]) ? &Schedules[1] : &Schedules[0];
+        buildSchedule(*Schedule);
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            if(STATE_RUNNING == State) Next = Schedule;
+            else Active = Schedule;
+        }
+    }
+    return ReturnValue;
+} /* update */
+
+
+/******************************************************************************************************************************************************
+  isUpdatePending()
+******************************************************************************************************************************************************/
+/*! \brief          check if an update is waiting for the next frame start
+ *  \details
+ *
+ *  \return         true if update() would fail
+ *****************************************************************************************************************************************************/
+boolean SoftPwm::isUpdatePending() const
+{
+    boolean Pending;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { Pending = (Next != NULL); }
+    return Pending;
+} /* isUpdatePending */
+
+
+/******************************************************************************************************************************************************
+  start()
+******************************************************************************************************************************************************/
+/*! \brief          start software pwm
+ *  \details        Timer2 is started and the first frame starts at once
+ *
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre            Software pwm has to be initialized and Timer2 has to be in READY or STOPPED state
+ *****************************************************************************************************************************************************/
+stdReturnType SoftPwm::start()
+{
+    stdReturnType ReturnValue = E_NOT_OK;
+
+    if(STATE_READY == State) {
+        /* all channels are low, see stop() */
+        for(byte Port = 0u; Port < NUMBER_OF_PORTS; Port++) Full[Port] = 0u;
+        EdgeIndex = SOFTPWM_FRAME_START;
+        prepareFrame();
+        writeBit(TIMSK2, OCIE2B, 1);
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            if(E_OK == Timer2.start()) {
+                ReturnValue = E_OK;
+                State = STATE_RUNNING;
+                /* drop a compare match of the old compare value, apply first frame start and schedule its first edge */
+                TIFR2 = (1 << OCF2B);
+                edgeInterrupt();
+            } else {
+                writeBit(TIMSK2, OCIE2B, 0);
+            }
+        }
+    }
+    return ReturnValue;
+} /* start */
+
+
+/******************************************************************************************************************************************************
+  stop()
+******************************************************************************************************************************************************/
+/*! \brief          stop software pwm
+ *  \details        Timer2 is stopped and all channels are set low, a pending update is taken over
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void SoftPwm::stop()
+{
+    if(STATE_RUNNING == State) {
+        Timer2.stop();
+        writeBit(TIMSK2, OCIE2B, 0);
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            PORTB &= ~Mask[PORT_B];
+            PORTC &= ~Mask[PORT_C];
+            PORTD &= ~Mask[PORT_D];
+            if(Next != NULL) {
+                Active = Next;
+                Next = NULL;
+            }
+        }
+        State = STATE_READY;
+    }
+} /* stop */
+
+
+/******************************************************************************************************************************************************
+  edgeInterrupt()
+******************************************************************************************************************************************************/
+/*! \brief          apply due edges and schedule the next one
+ *  \details        this function is called by the compare B interrupt. Each edge is one toggle store per port, writing
+ *                  a one to PINx toggles the pin, so other pins of the port are not touched. If the counter reached
+ *                  the next edge before its compare value was written, the edge is applied at once, so an edge is
+ *                  late by at most the run time of this loop and is never missed. There is no busy waiting.
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void SoftPwm::edgeInterrupt()
+{
+    const EdgeType* Edge;
+    byte LastTick;
+    byte NextTick;
+    byte Count;
+
+    for(;;) {
+        if(SOFTPWM_FRAME_START != EdgeIndex) {
+            Edge = &Active->Edges[EdgeIndex++];
+            PINB = Edge->Toggle[PORT_B];
+            PINC = Edge->Toggle[PORT_C];
+            PIND = Edge->Toggle[PORT_D];
+            LastTick = Edge->Tick;
+        } else {
+            PINB = Start[PORT_B];
+            PINC = Start[PORT_C];
+            PIND = Start[PORT_D];
+            EdgeIndex = 0u;
+            LastTick = 0u;
+        }
+        if(EdgeIndex < Active->Length) {
+            NextTick = Active->Edges[EdgeIndex].Tick;
+        } else {
+            /* next edge is the frame start at BOTTOM */
+            EdgeIndex = SOFTPWM_FRAME_START;
+            prepareFrame();
+            NextTick = 0u;
+        }
+        OCR2B = NextTick;
+        Count = TCNT2;
+        /* compare match is still ahead, if the counter did not pass BOTTOM and did not reach the next edge */
+        if((Count >= LastTick) && ((0u == NextTick) || (Count < NextTick))) break;
+        /* edge is due, a compare match raised by the write is dropped */
+        TIFR2 = (1 << OCF2B);
+    }
+} /* edgeInterrupt */
+
+
+/******************************************************************************************************************************************************
+ * P R I V A T E   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  buildSchedule()
+******************************************************************************************************************************************************/
+/*! \brief          sort duty cycles of all channels into edges
+ *  \details        the duty cycles are scaled to timer ticks and sorted by insertion, channels with the same tick are
+ *                  merged into one edge. Channels with duty cycle 0 or SOFTPWM_MAX_DUTY need no edge.
+ *  \param[out]     Schedule                    schedule which is built
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void SoftPwm::buildSchedule(ScheduleType& Schedule) const
+{
+    byte Order[SOFTPWM_MAX_CHANNELS];
+    byte Ticks[SOFTPWM_MAX_CHANNELS];
+    byte NumberOfOrdered = 0u;
+    byte Position;
+    unsigned int Tick;
+    const ChannelType* Channel;
+    EdgeType* Edge = NULL;
+
+    Schedule.Length = 0u;
+    for(byte Port = 0u; Port < NUMBER_OF_PORTS; Port++) {
+        Schedule.On[Port] = 0u;
+        Schedule.Full[Port] = 0u;
+    }
+    for(byte Index = 0u; Index < NumberOfChannels; Index++) {
+        Channel = &Channels[Index];
+        /* scale duty cycle to timer ticks, SOFTPWM_MAX_DUTY is the whole frame */
+        Tick = ((unsigned int) Channel->Duty * (Top + 1u) + (SOFTPWM_MAX_DUTY / 2u)) / SOFTPWM_MAX_DUTY;
+        if(0u == Tick) continue;
+        Schedule.On[Channel->Port] |= Channel->Mask;
+        if(Tick > Top) {
+            Schedule.Full[Channel->Port] |= Channel->Mask;
+        } else {
+            Ticks[Index] = Tick;
+            Position = NumberOfOrdered++;
+            while((Position > 0u) && (Ticks[Order[Position - 1u]] > Tick)) {
+                Order[Position] = Order[Position - 1u];
+                Position--;
+            }
+            Order[Position] = Index;
+        }
+    }
+    for(Position = 0u; Position < NumberOfOrdered; Position++) {
+        Channel = &Channels[Order[Position]];
+        /* channels with the same tick share one edge */
+        if((NULL == Edge) || (Edge->Tick != Ticks[Order[Position]])) {
+            Edge = &Schedule.Edges[Schedule.Length++];
+            Edge->Tick = Ticks[Order[Position]];
+            for(byte Port = 0u; Port < NUMBER_OF_PORTS; Port++) Edge->Toggle[Port] = 0u;
+        }
+        Edge->Toggle[Channel->Port] |= Channel->Mask;
+    }
+} /* buildSchedule */
+
+
+/******************************************************************************************************************************************************
+  prepareFrame()
+******************************************************************************************************************************************************/
+/*! \brief          prepare toggle masks of the next frame start
+ *  \details        a pending schedule is taken over. At the end of a frame only the channels which were high for the
+ *                  whole frame are high, so the frame start toggles the difference to the channels which start high.
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void SoftPwm::prepareFrame()
+{
+    if(Next != NULL) {
+        Active = Next;
+        Next = NULL;
+    }
+    for(byte Port = 0u; Port < NUMBER_OF_PORTS; Port++) {
+        Start[Port] = Active->On[Port] ^ Full[Port];
+        Full[Port] = Active->Full[Port];
+    }
+} /* prepareFrame */
+
+
+/******************************************************************************************************************************************************
+  I S R   F U N C T I O N S
+******************************************************************************************************************************************************/
+ISR(TIMER2_COMPB_vect)
+{
+    SoftwarePwm.edgeInterrupt();
+}
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
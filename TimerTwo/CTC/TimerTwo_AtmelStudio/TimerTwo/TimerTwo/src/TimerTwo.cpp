@@ -43,9 +43,24 @@ TimerTwo& Timer2 = TimerTwo::getInstance();              // pre-instantiate Time
  *****************************************************************************************************************************************************/
 TimerTwo::TimerTwo()
 {
-	State = TIMERTWO_STATE_NONE;
-	TimerOverflowCallback = NULL;
-	ClockSelectBitGroup = TIMERTWO_REG_CS_NO_CLOCK;
+#if (TIMERTWO_POSTSCALER == STD_ON)
+	PostscalerCount = 1;
+	PostscalerReload = 1;
+	PostscalerRemainder = 0;
+	PostscalerError = 0;
+#endif
+#if (TIMERTWO_TONE == STD_ON)
+#if (TIMERTWO_TONE_DURATION == STD_ON)
+	ToneOverflows = 0;
+#endif
+	TonePlaying = false;
+	ToneSavedTop = 0;
+#endif
+#if (TIMERTWO_RTC == STD_ON)
+	RtcOverflows = 0;
+	RtcTime = 0;
+	RtcRunning = false;
+#endif
 } /* TimerTwo */
 
 
@@ -76,36 +91,27 @@ TimerTwo& TimerTwo::getInstance()
   init()
 ******************************************************************************************************************************************************/
 /*! \brief          initialization of the Timer2 hardware
- *  \details        this functions initializes the Timer2 hardware
+ *  \details        this functions initializes the Timer2 hardware in mode 2: clear timer on compare match (CTC)
  *                  
- *  \param[in]      Microseconds				period of the timer overflow interrupt
- *  \param[in]      sTimerOverflowCallback      Callback function which should be called when timer overflow interrupt occurs
+ *  \param[in]      Microseconds				period of the timer compare interrupt
+ *  \param[in]      sTimerCompareCallback       Callback function which should be called when timer compare interrupt occurs
  *  \return         E_OK
  *                  E_NOT_OK
- *  \pre			Timer has to be in NONE STATE
+ *  \pre			Timer has to be in INIT STATE, real time clock must not be running
  *****************************************************************************************************************************************************/
 stdReturnType TimerTwo::init(long Microseconds, TimerIsrCallbackF_void sTimerCompareCallback)
 {
 	stdReturnType ReturnValue = E_NOT_OK;
 
-	if(TIMERTWO_STATE_NONE == State) {
-        ReturnValue = E_OK;
-		State = TIMERTWO_STATE_INIT;
-		/* clear control register */
-	    TCCR2A = 0;
-	    TCCR2B = 0;
-	    
-	    /* set mode 2: clear timer on compare match (CTC) */
-	    writeBit(TCCR2A, WGM20, 0);
-	    writeBit(TCCR2A, WGM21, 1);
-	    writeBit(TCCR2B, WGM22, 0);
-		
-		if(E_NOT_OK == setPeriod(Microseconds)) ReturnValue = E_NOT_OK;
-		if(sTimerCompareCallback != NULL) if(E_NOT_OK == attachInterrupt(sTimerCompareCallback)) ReturnValue = E_NOT_OK;
-
-		State = TIMERTWO_STATE_READY;
+#if (TIMERTWO_RTC == STD_ON)
+	if(RtcRunning) return E_NOT_OK;
+#endif
+	if(HwTimer2Ctc::STATE_INIT == HwTimer2Ctc::getState()) {
+		/* the period of HwTimer2Ctc has no post-scaler, so it is set again below */
+		(void) HwTimer2Ctc::init(Microseconds, sTimerCompareCallback);
+		ReturnValue = setPeriod(Microseconds);
 	}
-		return ReturnValue;
+	return ReturnValue;
 } /* init */
 
 
@@ -114,44 +120,34 @@ stdReturnType TimerTwo::init(long Microseconds, TimerIsrCallbackF_void sTimerCom
 ******************************************************************************************************************************************************/
 /*! \brief          set period of Timer2 compare interrupt
  *  \details        this functions sets the period of the Timer2 compare interrupt therefore 
- *                  prescaler and timer top value will be calculated
- *  \param[in]      Microseconds				period of the timer overflow interrupt
+ *                  prescaler and timer top value will be calculated by HwTimer2Ctc. With TIMERTWO_POSTSCALER longer
+ *                  periods run the timer with its longest hardware period and the compare interrupt calls the callback
+ *                  every n-th time. The remaining cpu cycles are carried over from callback to callback, so the period
+ *                  is kept exactly on average.
+ *  \param[in]      Microseconds				period of the timer compare interrupt
  *  \return         E_OK
- *                  E_NOT_OK
+ *                  E_NOT_OK					period out of bounds, maximum period is set
  *****************************************************************************************************************************************************/
 stdReturnType TimerTwo::setPeriod(unsigned long Microseconds)
 {
-	stdReturnType ReturnValue = E_NOT_OK;
-	unsigned long TimerCycles;
-
-    /* was request out of bounds? */
-    if(Microseconds <= ((TIMERTWO_RESOLUTION / (F_CPU / 1000000)) * TIMERTWO_MAX_PRESCALER)) {
-        ReturnValue = E_OK;
-        /* calculate timer cycles to reach timer period */
-        TimerCycles = (F_CPU / 1000000) * Microseconds;
-        /* calculate timer prescaler */
-        if(TimerCycles < TIMERTWO_RESOLUTION)              ClockSelectBitGroup = TIMERTWO_REG_CS_NO_PRESCALER;
-        else if((TimerCycles >>= 3) < TIMERTWO_RESOLUTION) ClockSelectBitGroup = TIMERTWO_REG_CS_PRESCALE_8;
-        else if((TimerCycles >>= 2) < TIMERTWO_RESOLUTION) ClockSelectBitGroup = TIMERTWO_REG_CS_PRESCALE_32;
-        else if((TimerCycles >>= 1) < TIMERTWO_RESOLUTION) ClockSelectBitGroup = TIMERTWO_REG_CS_PRESCALE_64;
-        else if((TimerCycles >>= 1) < TIMERTWO_RESOLUTION) ClockSelectBitGroup = TIMERTWO_REG_CS_PRESCALE_128;
-        else if((TimerCycles >>= 1) < TIMERTWO_RESOLUTION) ClockSelectBitGroup = TIMERTWO_REG_CS_PRESCALE_256;
-        else if((TimerCycles >>= 2) < TIMERTWO_RESOLUTION) ClockSelectBitGroup = TIMERTWO_REG_CS_PRESCALE_1024;
-        else {
-            /* request was out of bounds, set as maximum */
-            TimerCycles = TIMERTWO_RESOLUTION - 1;
-            ClockSelectBitGroup = TIMERTWO_REG_CS_PRESCALE_1024;
-            ReturnValue = E_NOT_OK;
-        }
-        /* OCR2A is TOP in mode 2: clear timer on compare match (CTC) */
-        OCR2A = TimerCycles;
-
-        if(TIMERTWO_STATE_RUNNING == State)
-        {
-            /* reset clock select register, and starts the clock */
-            writeBitGroup(TCCR2B, TIMERTWO_REG_CS_GM, TIMERTWO_REG_CS_GP, ClockSelectBitGroup);						
-        }
-    }
+	stdReturnType ReturnValue;
+#if (TIMERTWO_POSTSCALER == STD_ON)
+	unsigned long PeriodsHigh, CyclesLow;
+#endif
+
+	ReturnValue = HwTimer2Ctc::setPeriod(Microseconds);
+	setPostscaler(1, 0);
+#if (TIMERTWO_POSTSCALER == STD_ON)
+	if((E_NOT_OK == ReturnValue) && (Microseconds > 0)) {
+		/* HwTimer2Ctc has set the longest hardware period, TOP 255 with prescaler 1024 */
+		ReturnValue = E_OK;
+		/* cpu cycles of the period do not fit in 32 bit, so split microseconds at a multiple of the hardware period */
+		PeriodsHigh = Microseconds / TIMERTWO_POSTSCALER_PERIOD_CYCLES;
+		CyclesLow = (Microseconds % TIMERTWO_POSTSCALER_PERIOD_CYCLES) * (F_CPU / 1000000);
+		setPostscaler(PeriodsHigh * (F_CPU / 1000000) + CyclesLow / TIMERTWO_POSTSCALER_PERIOD_CYCLES,
+		              CyclesLow % TIMERTWO_POSTSCALER_PERIOD_CYCLES);
+	}
+#endif
 	return ReturnValue;
 } /* setPeriod */
 
@@ -164,25 +160,18 @@ stdReturnType TimerTwo::setPeriod(unsigned long Microseconds)
  *                  
  *  \return         E_OK
  *                  E_NOT_OK
- *  \pre			Timer has to be in READY or STOPPED STATE
+ *  \pre			Timer has to be in IDLE or STOPPED STATE and must not play a tone
  *****************************************************************************************************************************************************/
 stdReturnType TimerTwo::start()
 {
-	if(TIMERTWO_STATE_READY == State || TIMERTWO_STATE_STOPPED == State) {
-		/* reset counter value */
-		TCNT2 = 0;
-		/* start counter by setting clock select register */
-		writeBitGroup(TCCR2B, TIMERTWO_REG_CS_GM, TIMERTWO_REG_CS_GP, ClockSelectBitGroup);
-		/* set compare interrupt, if callback is set */
-		if(TimerOverflowCallback != NULL) {
-			/* enable timer compare interrupt */
-			writeBit(TIMSK2, OCIE2A, 1);
-		}
-		State = TIMERTWO_STATE_RUNNING;
-		return E_OK;
-	} else {
-		return E_NOT_OK;
-	}
+#if (TIMERTWO_TONE == STD_ON)
+	if(TonePlaying) return E_NOT_OK;
+#endif
+#if (TIMERTWO_POSTSCALER == STD_ON)
+	/* restart post-scaler with the whole period */
+	if(HwTimer2Ctc::STATE_RUNNING != HwTimer2Ctc::getState()) setPostscaler(PostscalerReload, PostscalerRemainder);
+#endif
+	return HwTimer2Ctc::start();
 } /* start */
 
 
@@ -196,9 +185,7 @@ stdReturnType TimerTwo::start()
  *****************************************************************************************************************************************************/
 void TimerTwo::stop()
 {
-	/* stop counter by clearing clock select register */
-	writeBitGroup(TCCR2B, TIMERTWO_REG_CS_GM, TIMERTWO_REG_CS_GP, TIMERTWO_REG_CS_NO_CLOCK);
-	State = TIMERTWO_STATE_STOPPED;
+	HwTimer2Ctc::stop();
 } /* stop */
 
 
@@ -210,17 +197,14 @@ void TimerTwo::stop()
  *                  
  *  \return         E_OK
  *                  E_NOT_OK
- *  \pre			Timer has to be in STOPPED STATE
+ *  \pre			Timer has to be in STOPPED STATE and must not play a tone
  *****************************************************************************************************************************************************/
 stdReturnType TimerTwo::resume()
 {
-	if(TIMERTWO_STATE_STOPPED == State) {
-		/* resume counter by setting clock select register */
-		writeBitGroup(TCCR2B, TIMERTWO_REG_CS_GM, TIMERTWO_REG_CS_GP, ClockSelectBitGroup);
-		return E_OK;
-	} else {
-		return E_NOT_OK;
-	}
+#if (TIMERTWO_TONE == STD_ON)
+	if(TonePlaying) return E_NOT_OK;
+#endif
+	return HwTimer2Ctc::resume();
 } /* resume */
 
 
@@ -230,20 +214,13 @@ stdReturnType TimerTwo::resume()
 /*! \brief          set timer compare interrupt callback
  *  \details        
  *                  
- *  \param[in]      sTimerOverflowCallback				timer compare callback function
+ *  \param[in]      sTimerCompareCallback				timer compare callback function
  *  \return         E_OK
  *                  E_NOT_OK
  *****************************************************************************************************************************************************/
 stdReturnType TimerTwo::attachInterrupt(TimerIsrCallbackF_void sTimerCompareCallback)
 {
-	if(sTimerCompareCallback != NULL) {
-		TimerOverflowCallback = sTimerCompareCallback;
-		/* enable timer compare interrupt */
-		if(State == TIMERTWO_STATE_RUNNING) writeBit(TIMSK2, OCIE2A, 1);
-		return E_OK;
-	} else {
-		return E_NOT_OK;
-	}
+	return HwTimer2Ctc::attachInterrupt(sTimerCompareCallback);
 } /* attachInterrupt */
 
 
@@ -257,8 +234,7 @@ stdReturnType TimerTwo::attachInterrupt(TimerIsrCallbackF_void sTimerCompareCall
  *****************************************************************************************************************************************************/
 void TimerTwo::detachInterrupt()
 {
-	/* clears the timer compare interrupt enable bit */
-	writeBit(TIMSK2, OCIE2A, 0);
+	HwTimer2Ctc::detachInterrupt();
 } /* detachInterrupt */
 
 
@@ -275,47 +251,510 @@ void TimerTwo::detachInterrupt()
  *****************************************************************************************************************************************************/
 stdReturnType TimerTwo::read(unsigned int* Microseconds)
 {
-	stdReturnType ReturnValue = E_NOT_OK;
-	int CounterValue;
-	byte PrescaleShiftScale = 0;
-
-	if(TIMERTWO_STATE_RUNNING == State || TIMERTWO_STATE_STOPPED == State) {
-        ReturnValue = E_OK;
-		/* save current timer value */
-		CounterValue = TCNT2;
-		switch (ClockSelectBitGroup)
-		{
-			case TIMERTWO_REG_CS_NO_PRESCALER:
-				PrescaleShiftScale = 0;
-				break;
-			case TIMERTWO_REG_CS_PRESCALE_8:
-				PrescaleShiftScale = 3;
-				break;
-			case TIMERTWO_REG_CS_PRESCALE_32:
-				PrescaleShiftScale = 5;
-				break;
-			case TIMERTWO_REG_CS_PRESCALE_64:
-				PrescaleShiftScale = 6;
-				break;
-			case TIMERTWO_REG_CS_PRESCALE_128:
-				PrescaleShiftScale = 7;
-				break;
-			case TIMERTWO_REG_CS_PRESCALE_256:
-				PrescaleShiftScale = 8;
-				break;
-			case TIMERTWO_REG_CS_PRESCALE_1024:
-				PrescaleShiftScale = 10;
-				break;
-			default:
-				ReturnValue = E_NOT_OK;
+	stdReturnType ReturnValue;
+	uint32_t Value;
+
+	ReturnValue = HwTimer2Ctc::read(Value);
+	if(E_OK == ReturnValue) *Microseconds = Value;
+	return ReturnValue;
+} /* read */
+
+
+#if (TIMERTWO_POSTSCALER == STD_ON)
+/******************************************************************************************************************************************************
+  getPostscalerError()
+******************************************************************************************************************************************************/
+/*! \brief          read deviation of the next callback from the exact period
+ *  \details        the deviation is always less than half a hardware period of the post-scaler, because the
+ *                  remainder is carried over and does not accumulate
+ *  \param[out]     Microseconds		positive if the next callback is early, negative if it is late
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerTwo::getPostscalerError(long* Microseconds)
+{
+	long Error;
+	byte InterruptState = SREG;
+
+	cli();
+	Error = PostscalerError;
+	SREG = InterruptState;
+	*Microseconds = Error / (long) (F_CPU / 1000000);
+} /* getPostscalerError */
+#endif
+
+
+#if (TIMERTWO_TONE == STD_ON)
+/******************************************************************************************************************************************************
+  tone()
+******************************************************************************************************************************************************/
+/*! \brief          play square wave on OC2A
+ *  \details        the counter runs in mode 2 with TOP of half a period and OC2A toggles on each compare match, so the
+ *                  waveform is generated by hardware without any Timer2 interrupt. With TIMERTWO_TONE_DURATION a
+ *                  duration is counted by Timer1 with prescaler 1024: the first overflow is preloaded with the
+ *                  remainder, so at most one interrupt occurs every 4.2 s at 16 MHz. A playing tone is changed at once.
+ *  \param[in]      Frequency					frequency in Hz, at least F_CPU / 2^19 (31 Hz at 16 MHz)
+ *  \param[in]      Milliseconds				duration of the tone, 0 plays until noTone()
+ *  \return         E_OK
+ *                  E_NOT_OK, also for a duration without TIMERTWO_TONE_DURATION
+ *  \pre			Timer has to be in IDLE or STOPPED STATE or playing a tone,
+ *                  Timer1 must not be used by someone else while a tone with duration is played
+ *****************************************************************************************************************************************************/
+stdReturnType TimerTwo::tone(unsigned int Frequency, unsigned long Milliseconds)
+{
+	TimerTwoClockSelectType ToneClockSelect;
+	unsigned long TimerCycles;
+#if (TIMERTWO_TONE_DURATION == STD_ON)
+	unsigned long Ticks;
+	unsigned long FirstTicks;
+#endif
+	byte InterruptState;
+
+#if (TIMERTWO_TONE_DURATION == STD_OFF)
+	/* the duration needs the Timer1 overflow interrupt */
+	if(Milliseconds > 0) return E_NOT_OK;
+#endif
+	if((HwTimer2Ctc::STATE_IDLE == HwTimer2Ctc::getState() || HwTimer2Ctc::STATE_STOPPED == HwTimer2Ctc::getState() || TonePlaying) &&
+	   Frequency > (F_CPU / 2 / TIMERTWO_RESOLUTION / TIMERTWO_MAX_PRESCALER) && Frequency <= (F_CPU / 2)) {
+		/* timer cycles of half a period rounded to nearest, same ladder as setPeriod() */
+		TimerCycles = (F_CPU + Frequency) / (2UL * Frequency);
+		if(TimerCycles <= TIMERTWO_RESOLUTION)              ToneClockSelect = TIMERTWO_REG_CS_NO_PRESCALER;
+		else if((TimerCycles >>= 3) <= TIMERTWO_RESOLUTION) ToneClockSelect = TIMERTWO_REG_CS_PRESCALE_8;
+		else if((TimerCycles >>= 2) <= TIMERTWO_RESOLUTION) ToneClockSelect = TIMERTWO_REG_CS_PRESCALE_32;
+		else if((TimerCycles >>= 1) <= TIMERTWO_RESOLUTION) ToneClockSelect = TIMERTWO_REG_CS_PRESCALE_64;
+		else if((TimerCycles >>= 1) <= TIMERTWO_RESOLUTION) ToneClockSelect = TIMERTWO_REG_CS_PRESCALE_128;
+		else if((TimerCycles >>= 1) <= TIMERTWO_RESOLUTION) ToneClockSelect = TIMERTWO_REG_CS_PRESCALE_256;
+		else {
+			TimerCycles >>= 2;
+			ToneClockSelect = TIMERTWO_REG_CS_PRESCALE_1024;
 		}
-        /* transform counter value to microseconds in an efficient way */
-		*Microseconds = ((CounterValue * 1000UL) / (F_CPU / 1000UL)) << PrescaleShiftScale;
+#if (TIMERTWO_TONE_DURATION == STD_ON)
+		/* Timer1 ticks of the duration, split so the product cannot overflow */
+		Ticks = (Milliseconds / 1000) * TIMERTWO_TONE_TICK_FREQUENCY + ((Milliseconds % 1000) * TIMERTWO_TONE_TICK_FREQUENCY) / 1000;
+		if(0 == Ticks) Ticks = 1;
+		FirstTicks = Ticks & 0xFFFF;
+		if(0 == FirstTicks) FirstTicks = 0x10000;
+#endif
+
+		InterruptState = SREG;
+		cli();
+#if (TIMERTWO_TONE_DURATION == STD_ON)
+		/* stop duration of the previous tone */
+		TCCR1B = 0;
+		writeBit(TIMSK1, TOIE1, 0);
+#endif
+		/* stop counter and compare interrupt, OC2A toggles when the counter is cleared at TOP */
+		writeBitGroup(TCCR2B, TIMERTWO_REG_CS_GM, TIMERTWO_REG_CS_GP, TIMERTWO_REG_CS_NO_CLOCK);
+		writeBit(TIMSK2, OCIE2A, 0);
+		if(!TonePlaying) ToneSavedTop = OCR2A;
+		OCR2A = TimerCycles - 1;
+		TCNT2 = 0;
+		writeBit(TCCR2A, COM2A1, 0);
+		writeBit(TCCR2A, COM2A0, 1);
+		pinMode(TIMERTWO_TONE_PIN, OUTPUT);
+#if (TIMERTWO_TONE_DURATION == STD_ON)
+		if(Milliseconds > 0) {
+			ToneOverflows = (Ticks - FirstTicks) >> 16;
+			/* set Timer1 to normal mode with prescaler 1024 */
+			TCCR1A = 0;
+			TCNT1 = 0x10000 - FirstTicks;
+			TIFR1 = (1 << TOV1);
+			writeBit(TIMSK1, TOIE1, 1);
+			TCCR1B = (1 << CS12) | (1 << CS10);
+		}
+#endif
+		/* start counter by setting clock select register */
+		writeBitGroup(TCCR2B, TIMERTWO_REG_CS_GM, TIMERTWO_REG_CS_GP, ToneClockSelect);
+		TonePlaying = true;
+		SREG = InterruptState;
+		return E_OK;
 	} else {
-		ReturnValue = E_NOT_OK;
+		return E_NOT_OK;
 	}
-	return ReturnValue;
-} /* read */
+} /* tone */
+
+
+/******************************************************************************************************************************************************
+  noTone()
+******************************************************************************************************************************************************/
+/*! \brief          stop square wave on OC2A
+ *  \details        OC2A is disconnected and the pin is set low. The period of the timer is restored, start() runs
+ *                  the timer with it again. The state of the timer is not changed by the tone.
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerTwo::noTone()
+{
+	byte InterruptState = SREG;
+
+	cli();
+	if(TonePlaying) {
+#if (TIMERTWO_TONE_DURATION == STD_ON)
+		TCCR1B = 0;
+		writeBit(TIMSK1, TOIE1, 0);
+#endif
+		writeBitGroup(TCCR2B, TIMERTWO_REG_CS_GM, TIMERTWO_REG_CS_GP, TIMERTWO_REG_CS_NO_CLOCK);
+		writeBit(TCCR2A, COM2A0, 0);
+		digitalWrite(TIMERTWO_TONE_PIN, LOW);
+		OCR2A = ToneSavedTop;
+		TonePlaying = false;
+	}
+	SREG = InterruptState;
+} /* noTone */
+
+
+#if (TIMERTWO_TONE_DURATION == STD_ON)
+/******************************************************************************************************************************************************
+  toneInterrupt()
+******************************************************************************************************************************************************/
+/*! \brief          count duration of the tone
+ *  \details        this function is called by the Timer1 overflow interrupt, the tone is stopped at the last overflow
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerTwo::toneInterrupt()
+{
+	if(ToneOverflows > 0) ToneOverflows--;
+	else noTone();
+} /* toneInterrupt */
+#endif
+#endif
+
+
+#if (TIMERTWO_RTC == STD_ON)
+/******************************************************************************************************************************************************
+  initRtc()
+******************************************************************************************************************************************************/
+/*! \brief          initialization of Timer2 as real time clock
+ *  \details        Timer2 is clocked asynchronously by the watch crystal on TOSC1/TOSC2 with prescaler 128, so the
+ *                  counter overflows once per second and keeps running in power-save sleep. The overflow interrupt
+ *                  counts the seconds and calls the callback. Registers written in asynchronous mode are transferred
+ *                  at the next edge of the crystal clock, the update busy flags in ASSR are waited for before the
+ *                  interrupts are enabled. The crystal needs about one second to settle after power up.
+ *  \param[in]      sTimerOverflowCallback      Callback function which is called every second
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre			Timer has to be in INIT STATE, TOSC1/TOSC2 replace PB6/PB7 and the internal RC oscillator has to
+ *                  be the system clock
+ *****************************************************************************************************************************************************/
+stdReturnType TimerTwo::initRtc(TimerIsrCallbackF_void sTimerOverflowCallback)
+{
+	byte InterruptState;
+
+	if((HwTimer2Ctc::STATE_INIT == HwTimer2Ctc::getState()) && !RtcRunning) {
+		InterruptState = SREG;
+		cli();
+		/* interrupts of Timer2 have to be disabled while the clock source is changed */
+		TIMSK2 = 0;
+		writeBit(ASSR, EXCLK, 0);
+		writeBit(ASSR, AS2, 1);
+		/* mode 0: normal, the counter runs up to MAX */
+		TCNT2 = 0;
+		OCR2A = 0;
+		TCCR2A = 0;
+		TCCR2B = 0;
+		writeBitGroup(TCCR2B, TIMERTWO_REG_CS_GM, TIMERTWO_REG_CS_GP, TIMERTWO_REG_CS_PRESCALE_128);
+		while(ASSR & TIMERTWO_RTC_BUSY_MASK);
+		/* flags may have been set by the change of the clock source */
+		TIFR2 = (1 << OCF2B) | (1 << OCF2A) | (1 << TOV2);
+		RtcOverflows = 0;
+		RtcTime = 0;
+		/* the timer stays in INIT STATE, so the callback is only stored */
+		(void) HwTimer2Ctc::attachInterrupt(sTimerOverflowCallback);
+		writeBit(TIMSK2, TOIE2, 1);
+		RtcRunning = true;
+		SREG = InterruptState;
+		return E_OK;
+	} else {
+		return E_NOT_OK;
+	}
+} /* initRtc */
+
+
+/******************************************************************************************************************************************************
+  getRtcTicks()
+******************************************************************************************************************************************************/
+/*! \brief          read real time clock counter
+ *  \details        this function returns the counter value extended by the seconds since initRtc(), one tick is
+ *                  1 / 256 s. The value wraps around after 194 days, sleepUntil() handles the wrap around.
+ *  \return         ticks since initRtc()
+ *****************************************************************************************************************************************************/
+unsigned long TimerTwo::getRtcTicks()
+{
+	unsigned long Overflows;
+	byte CounterValue;
+	byte InterruptState = SREG;
+
+	cli();
+	CounterValue = TCNT2;
+	Overflows = RtcOverflows;
+	/* counter wrapped around but overflow interrupt is still pending */
+	if((TIFR2 & (1 << TOV2)) && CounterValue < (TIMERTWO_RESOLUTION / 2)) Overflows++;
+	SREG = InterruptState;
+	return (Overflows << TIMERTWO_NUMBER_OF_BITS) | CounterValue;
+} /* getRtcTicks */
+
+
+/******************************************************************************************************************************************************
+  sleepUntil()
+******************************************************************************************************************************************************/
+/*! \brief          sleep in power-save mode until a deadline
+ *  \details        the cpu is woken up by the overflow every second and, in the last second, by a compare match at the
+ *                  deadline. Only Timer2 keeps running in power-save mode, so millis() does not advance while sleeping.
+ *                  Before the counter is read and before sleep is entered again, one edge of the crystal clock is
+ *                  waited for, otherwise the old counter value is read and the interrupt which woke up the cpu wakes
+ *                  it up again at once.
+ *  \param[in]      Ticks						deadline, see getRtcTicks()
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre			real time clock has to be running, interrupts are enabled by this function
+ *****************************************************************************************************************************************************/
+stdReturnType TimerTwo::sleepUntil(unsigned long Ticks)
+{
+	long Remaining;
+
+	if(RtcRunning) {
+		set_sleep_mode(SLEEP_MODE_PWR_SAVE);
+		for(;;) {
+			syncRtc();
+			Remaining = (long) (Ticks - getRtcTicks());
+			if(Remaining <= 0) break;
+			if(Remaining < TIMERTWO_RTC_MIN_SLEEP_TICKS) continue;
+			if(Remaining < (long) TIMERTWO_RTC_TICK_FREQUENCY) {
+				/* deadline is before the next overflow but one, wake up by compare match */
+				OCR2A = (byte) Ticks;
+				while(ASSR & (1 << OCR2AUB));
+				TIFR2 = (1 << OCF2A);
+				writeBit(TIMSK2, OCIE2A, 1);
+			}
+			/* the instruction after sei() is executed before a pending interrupt, so no wakeup is lost */
+			cli();
+			sleep_enable();
+			sei();
+			sleep_cpu();
+			sleep_disable();
+		}
+		writeBit(TIMSK2, OCIE2A, 0);
+		return E_OK;
+	} else {
+		return E_NOT_OK;
+	}
+} /* sleepUntil */
+
+
+/******************************************************************************************************************************************************
+  setTime()
+******************************************************************************************************************************************************/
+/*! \brief          set time of the real time clock
+ *  \details        the counter is not reset, so running deadlines of sleepUntil() are kept and the next second starts
+ *                  at the next overflow
+ *  \param[in]      Seconds						seconds since 1970-01-01 00:00:00
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerTwo::setTime(unsigned long Seconds)
+{
+	byte InterruptState = SREG;
+
+	cli();
+	RtcTime = Seconds;
+	SREG = InterruptState;
+} /* setTime */
+
+
+/******************************************************************************************************************************************************
+  getTime()
+******************************************************************************************************************************************************/
+/*! \brief          read time of the real time clock
+ *  \details
+ *
+ *  \return         seconds since 1970-01-01 00:00:00
+ *****************************************************************************************************************************************************/
+unsigned long TimerTwo::getTime()
+{
+	unsigned long Seconds;
+	byte InterruptState = SREG;
+
+	cli();
+	Seconds = RtcTime;
+	SREG = InterruptState;
+	return Seconds;
+} /* getTime */
+
+
+/******************************************************************************************************************************************************
+  setDateTime()
+******************************************************************************************************************************************************/
+/*! \brief          set date and time of the real time clock
+ *  \details        the date is converted to days since 1970 with the 400 year cycle of the gregorian calendar, so
+ *                  only additions, multiplications and divisions by constants are needed. The weekday is ignored.
+ *  \param[in]      DateTime					date and time from 1970 to 2105
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *****************************************************************************************************************************************************/
+stdReturnType TimerTwo::setDateTime(const TimerTwoDateTimeType* DateTime)
+{
+	unsigned long Year;
+	unsigned long Era;
+	unsigned long YearOfEra;
+	unsigned long DayOfYear;
+	unsigned long Days;
+
+	if(DateTime->Year >= 1970 && DateTime->Year <= 2105 && DateTime->Month >= 1 && DateTime->Month <= 12 &&
+	   DateTime->Day >= 1 && DateTime->Day <= 31 && DateTime->Hour < 24 && DateTime->Minute < 60 && DateTime->Second < 60) {
+		/* the year starts in march, so the leap day is the last day of the year */
+		Year = DateTime->Year - (DateTime->Month <= 2 ? 1 : 0);
+		Era = Year / 400;
+		YearOfEra = Year - Era * 400;
+		DayOfYear = (153 * (DateTime->Month > 2 ? DateTime->Month - 3 : DateTime->Month + 9) + 2) / 5 + DateTime->Day - 1;
+		/* 719468 days from 0000-03-01 to 1970-01-01 */
+		Days = Era * 146097 + YearOfEra * 365 + YearOfEra / 4 - YearOfEra / 100 + DayOfYear - 719468;
+		setTime(Days * 86400 + DateTime->Hour * 3600UL + DateTime->Minute * 60U + DateTime->Second);
+		return E_OK;
+	} else {
+		return E_NOT_OK;
+	}
+} /* setDateTime */
+
+
+/******************************************************************************************************************************************************
+  getDateTime()
+******************************************************************************************************************************************************/
+/*! \brief          read date and time of the real time clock
+ *  \details        inverse of setDateTime()
+ *
+ *  \param[out]     DateTime					date and time
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerTwo::getDateTime(TimerTwoDateTimeType* DateTime)
+{
+	unsigned long Seconds = getTime();
+	unsigned long Days = Seconds / 86400;
+	unsigned long Era;
+	unsigned long DayOfEra;
+	unsigned long YearOfEra;
+	unsigned long DayOfYear;
+	unsigned long MonthIndex;
+
+	Seconds -= Days * 86400;
+	DateTime->Hour = Seconds / 3600;
+	DateTime->Minute = (Seconds / 60) % 60;
+	DateTime->Second = Seconds % 60;
+	/* 1970-01-01 was a thursday */
+	DateTime->Weekday = (Days + 4) % 7;
+	Days += 719468;
+	Era = Days / 146097;
+	DayOfEra = Days - Era * 146097;
+	YearOfEra = (DayOfEra - DayOfEra / 1460 + DayOfEra / 36524 - DayOfEra / 146096) / 365;
+	DayOfYear = DayOfEra - (365 * YearOfEra + YearOfEra / 4 - YearOfEra / 100);
+	MonthIndex = (5 * DayOfYear + 2) / 153;
+	DateTime->Day = DayOfYear - (153 * MonthIndex + 2) / 5 + 1;
+	DateTime->Month = MonthIndex < 10 ? MonthIndex + 3 : MonthIndex - 9;
+	DateTime->Year = Era * 400 + YearOfEra + (DateTime->Month <= 2 ? 1 : 0);
+} /* getDateTime */
+
+
+/******************************************************************************************************************************************************
+  rtcInterrupt()
+******************************************************************************************************************************************************/
+/*! \brief          count seconds of the real time clock
+ *  \details        this function is called by the Timer2 overflow interrupt
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerTwo::rtcInterrupt()
+{
+	RtcOverflows++;
+	RtcTime++;
+	HwTimer2Ctc::handleInterrupt();
+} /* rtcInterrupt */
+#endif
+
+
+/******************************************************************************************************************************************************
+  compareInterrupt()
+******************************************************************************************************************************************************/
+/*! \brief          handle timer compare interrupt
+ *  \details        with post-scaler only a decrement is done for most hardware periods, the remainder is handled
+ *                  once per callback
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerTwo::compareInterrupt()
+{
+#if (TIMERTWO_RTC == STD_ON)
+	/* in real time clock mode the compare match only wakes up sleepUntil() */
+	if(RtcRunning) {
+		writeBit(TIMSK2, OCIE2A, 0);
+		return;
+	}
+#endif
+#if (TIMERTWO_POSTSCALER == STD_ON)
+	if(--PostscalerCount != 0) return;
+	PostscalerCount = PostscalerReload;
+	PostscalerError += PostscalerRemainder;
+	/* one more hardware period, if the callback would be early by more than half a hardware period */
+	if(PostscalerError >= (long) (TIMERTWO_POSTSCALER_PERIOD_CYCLES / 2)) {
+		PostscalerCount++;
+		PostscalerError -= TIMERTWO_POSTSCALER_PERIOD_CYCLES;
+	}
+#endif
+	HwTimer2Ctc::handleInterrupt();
+} /* compareInterrupt */
+
+
+/******************************************************************************************************************************************************
+ * P R I V A T E   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  setPostscaler()
+******************************************************************************************************************************************************/
+/*! \brief          set post-scaler of the compare interrupt
+ *  \details        the first callback already includes the remainder
+ *
+ *  \param[in]      Reload				number of hardware periods per callback
+ *  \param[in]      Remainder			cpu cycles of the period in addition to the hardware periods
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerTwo::setPostscaler(unsigned long Reload, unsigned long Remainder)
+{
+#if (TIMERTWO_POSTSCALER == STD_ON)
+	unsigned long Count = Reload;
+	long Error = Remainder;
+	byte InterruptState;
+
+	/* the post-scaler of a hardware period keeps its values in the compare interrupt, so it is not written again */
+	if((1 == Reload) && (0 == Remainder) && (1 == PostscalerReload) && (0 == PostscalerRemainder)) return;
+	if(Error >= (long) (TIMERTWO_POSTSCALER_PERIOD_CYCLES / 2)) {
+		Count++;
+		Error -= TIMERTWO_POSTSCALER_PERIOD_CYCLES;
+	}
+	InterruptState = SREG;
+	cli();
+	PostscalerCount = Count;
+	PostscalerReload = Reload;
+	PostscalerRemainder = Remainder;
+	PostscalerError = Error;
+	SREG = InterruptState;
+#else
+	(void) Reload;
+	(void) Remainder;
+#endif
+} /* setPostscaler */
+
+
+#if (TIMERTWO_RTC == STD_ON)
+/******************************************************************************************************************************************************
+  syncRtc()
+******************************************************************************************************************************************************/
+/*! \brief          wait for an edge of the crystal clock
+ *  \details        TCCR2A is written with its value of mode 0 and its update busy flag is waited for
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerTwo::syncRtc()
+{
+	TCCR2A = 0;
+	while(ASSR & (1 << TCR2AUB));
+} /* syncRtc */
+#endif
 
 
 /******************************************************************************************************************************************************
@@ -323,8 +762,22 @@ stdReturnType TimerTwo::read(unsigned int* Microseconds)
 ******************************************************************************************************************************************************/
 ISR(TIMER2_COMPA_vect)
 {
-	Timer2.TimerOverflowCallback();
+	Timer2.compareInterrupt();
+}
+
+#if (TIMERTWO_RTC == STD_ON)
+ISR(TIMER2_OVF_vect)
+{
+	Timer2.rtcInterrupt();
+}
+#endif
+
+#if (TIMERTWO_TONE_DURATION == STD_ON)
+ISR(TIMER1_OVF_vect)
+{
+	Timer2.toneInterrupt();
 }
+#endif
 
 
 /******************************************************************************************************************************************************
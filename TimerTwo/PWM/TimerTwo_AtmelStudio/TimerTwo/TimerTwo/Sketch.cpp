@@ -2,8 +2,8 @@
 #include <TimerTwo.h>
 
 /*
- This example toggles the PIN13 cyclically all 1ms and starts the PWM for PIN3 and PIN11.
- The frequency depends on the period of the timer
+ This example toggles the PIN13 cyclically and starts the PWM for PIN3 and PIN11.
+ PIN11 needs a mode with fixed TOP, there the frequency depends on the prescaler only
 */
 
 #define PIN_TOGGLE          13u
@@ -14,7 +14,7 @@ void timerCallback() {
 
 void setup() {
   pinMode(PIN_TOGGLE, OUTPUT);
-  Timer2.init(16322u, timerCallback);
+  Timer2.init(16322u, timerCallback, TimerTwo::MODE_PHASE_CORRECT_FIXED_TOP);
   Timer2.start();
   Timer2.enablePwm(TimerTwo::PWM_PIN_3, 127);
   Timer2.enablePwm(TimerTwo::PWM_PIN_11, 10);
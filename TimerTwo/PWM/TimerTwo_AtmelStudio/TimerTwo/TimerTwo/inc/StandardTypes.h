@@ -47,6 +47,10 @@
 #define writeBitGroup(Var, BitGroupMask, BitGroupPosition, Value) \
 (Var = ((Var & ~((uint8_t)BitGroupMask)) | ((Value << BitGroupPosition) & ((uint8_t)BitGroupMask))))
 
+/* compile time assertion, Message has to be a valid identifier */
+#define STATIC_ASSERT(Condition, Message) \
+typedef char Message[(Condition) ? 1 : -1]
+
 
 /******************************************************************************************************************************************************
  *  GLOBAL DATA TYPES AND STRUCTURES
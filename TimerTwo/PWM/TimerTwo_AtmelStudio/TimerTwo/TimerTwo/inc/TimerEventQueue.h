@@ -0,0 +1,115 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       TimerEventQueue.h
+ *      \brief      Main header file of TimerEventQueue library
+ *
+ *      \details    Deferred execution of timer callbacks. The interrupt only posts the callback into a single producer
+ *                  single consumer queue, the callbacks are executed by process() from loop() or yield() with
+ *                  interrupts enabled.
+ *
+ *****************************************************************************************************************************************************/
+#ifndef _TIMEREVENTQUEUE_H_
+#define _TIMEREVENTQUEUE_H_
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include "Arduino.h"
+#include <StandardTypes.h>
+
+
+/******************************************************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *****************************************************************************************************************************************************/
+/* number of queued events, has to be a power of two and at most 128 */
+#define TIMEREVENTQUEUE_SIZE                        8u
+#define TIMEREVENTQUEUE_MASK                        (TIMEREVENTQUEUE_SIZE - 1u)
+
+/* process queued events in yield(), which is called by delay(); it replaces the yield() of the sketch */
+#ifndef TIMEREVENTQUEUE_YIELD
+#define TIMEREVENTQUEUE_YIELD                       STD_OFF
+#endif
+
+#if __cplusplus < 201103L
+# define nullptr NULL
+#endif
+
+/******************************************************************************************************************************************************
+ *  LOCAL FUNCTION MACROS
+ *****************************************************************************************************************************************************/
+
+
+/******************************************************************************************************************************************************
+ *  GLOBAL DATA TYPES AND STRUCTURES
+ *****************************************************************************************************************************************************/
+
+
+/******************************************************************************************************************************************************
+ *  CLASS  TimerEventQueue
+ *****************************************************************************************************************************************************/
+class TimerEventQueue
+{
+/******************************************************************************************************************************************************
+ *  P U B L I C   D A T A   T Y P E S   A N D   S T R U C T U R E S
+******************************************************************************************************************************************************/
+  public:
+    /* deferred callback function */
+    typedef void (*EventCallbackF_void)(void);
+
+    /* Type which includes the counters for tuning the queue size */
+    struct StatisticType {
+        /* events merged into a queued event of the same callback */
+        uint16_t Coalesced;
+        /* events lost because the queue was full */
+        uint16_t Overruns;
+        /* maximum number of queued events */
+        byte MaxFill;
+    };
+
+/******************************************************************************************************************************************************
+ *  P R I V A T E   D A T A   A N D   F U N C T I N O N S
+******************************************************************************************************************************************************/
+  private:
+    TimerEventQueue();
+    ~TimerEventQueue();
+    TimerEventQueue(const TimerEventQueue&);
+
+    EventCallbackF_void volatile Events[TIMEREVENTQUEUE_SIZE];
+    /* written by the interrupt only */
+    volatile byte Head;
+    /* written by process() only */
+    volatile byte Tail;
+    volatile StatisticType Statistic;
+
+/******************************************************************************************************************************************************
+ *  P U B L I C   F U N C T I O N S
+******************************************************************************************************************************************************/
+  public:
+    static TimerEventQueue& getInstance();
+
+    // get methods
+    byte getFill() const { return (byte) (Head - Tail); }
+    StatisticType getStatistic() const;
+
+    // set methods
+    void post(EventCallbackF_void);
+    void process();
+    void clearStatistic();
+};
+
+/* TimerEventQueue will be pre-instantiated in TimerEventQueue source file */
+extern TimerEventQueue& EventQueue;
+
+#endif
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
@@ -46,6 +46,49 @@
 
 #define TIMERTWO_MAX_PRESCALER                      1024u
 
+/* TOP of the modes which keep OCR2A for OC2A */
+#define TIMERTWO_FIXED_TOP                          0xFFu
+
+/* TOV2 is set at BOTTOM, OCF2A is set at TOP when OCR2A is TOP, with fixed TOP it is the compare match of OC2A */
+#define TIMERTWO_PHASE_FLAGS                        ((1u << TOV2) | (1u << OCF2A))
+
+/* duty to compare value table, costs 256 bytes RAM */
+#ifndef TIMERTWO_DUTY_TABLE
+#define TIMERTWO_DUTY_TABLE                         STD_OFF
+#endif
+
+/* overflow interrupt is defined by the sketch with TIMERTWO_ISR(Handler), attachInterrupt() only enables it */
+#ifndef TIMERTWO_STATIC_ISR
+#define TIMERTWO_STATIC_ISR                         STD_OFF
+#endif
+
+/* overflow interrupt only posts the callback to the TimerEventQueue, the callback is executed by EventQueue.process(),
+   with TIMEREVENTQUEUE_YIELD also while delay() waits */
+#ifndef TIMERTWO_DEFERRED_CALLBACK
+#define TIMERTWO_DEFERRED_CALLBACK                  STD_OFF
+#endif
+#if (TIMERTWO_DEFERRED_CALLBACK == STD_ON)
+# include <TimerEventQueue.h>
+#endif
+
+/* measure latency of the overflow interrupt in timer ticks, relative to BOTTOM */
+#ifndef TIMERTWO_LATENCY_HISTOGRAM
+#define TIMERTWO_LATENCY_HISTOGRAM                  STD_OFF
+#endif
+#if (TIMERTWO_LATENCY_HISTOGRAM == STD_ON)
+# include <LatencyHistogram.h>
+#endif
+
+/* measure run time of the overflow callback in timer ticks and count overruns, not used with deferred callbacks */
+#ifndef TIMERTWO_CALLBACK_PROFILER
+#define TIMERTWO_CALLBACK_PROFILER                  STD_OFF
+#endif
+
+/* setPeriodSync() changes TOP, prescaler and duty cycle together from the overflow interrupt */
+#ifndef TIMERTWO_SYNC_PERIOD
+#define TIMERTWO_SYNC_PERIOD                        STD_OFF
+#endif
+
 #if __cplusplus < 201103L
 # define nullptr NULL
 #endif
@@ -53,6 +96,10 @@
 /******************************************************************************************************************************************************
  *  LOCAL FUNCTION MACROS
  *****************************************************************************************************************************************************/
+#if (TIMERTWO_STATIC_ISR == STD_ON)
+/* handler is called directly and can be inlined, it has to be defined before and passed to init() or attachInterrupt() */
+# define TIMERTWO_ISR(Handler)                      ISR(TIMER2_OVF_vect) { Timer2.enterOverflowInterrupt(); Handler(); }
+#endif
 
 
 /******************************************************************************************************************************************************
@@ -80,6 +127,47 @@ class TimerTwo
         STATE_STOPPED
     };
 
+    /* Type which includes the supported pwm modes */
+    enum ModeType {
+        /* mode 5: dual slope, symmetric pulses */
+        MODE_PHASE_CORRECT,
+        /* mode 7: single slope, double pwm frequency at the same prescaler and resolution */
+        MODE_FAST_PWM,
+        /* mode 1: dual slope with TOP 0xFF, OC2A and OC2B have own duty cycles, period is set by prescaler only */
+        MODE_PHASE_CORRECT_FIXED_TOP,
+        /* mode 3: single slope with TOP 0xFF, OC2A and OC2B have own duty cycles, period is set by prescaler only */
+        MODE_FAST_PWM_FIXED_TOP
+    };
+
+    /* Type which includes the capabilities of the pwm modes, see getCapabilities() */
+    enum CapabilityType {
+        CAPABILITY_PWM_PIN_3 = 0x01u,
+        CAPABILITY_PWM_PIN_11 = 0x02u,
+        /* period is set by TOP and prescaler, otherwise the prescaler with the next longer period is used */
+        CAPABILITY_EXACT_PERIOD = 0x04u,
+        /* dual slope counter, pulses are centered in the period */
+        CAPABILITY_SYMMETRIC_PULSES = 0x08u
+    };
+
+    /* Type which describes the progress of a synchronized period change */
+    enum SyncStateType {
+        SYNC_IDLE,
+        /* new period is staged, compare buffers are loaded at the next BOTTOM */
+        SYNC_PENDING,
+        /* compare buffers hold the new TOP and duty cycle, prescaler is set at the next BOTTOM */
+        SYNC_COMPARE_LOADED
+    };
+
+    /* Type which describes the run time of the overflow callback */
+    struct ProfileType {
+        /* longest run time in timer ticks, exact up to two periods */
+        uint16_t MaxDuration;
+        /* callback was still running at the next BOTTOM, so the next interrupt was late */
+        uint16_t Overruns;
+        /* callback was running for at least a whole period */
+        uint16_t MissedPeriods;
+    };
+
     /* Type which includes the values of the Clock Select Bit Group */
     enum ClockSelectType {
         REG_CS_NO_CLOCK,
@@ -98,6 +186,31 @@ class TimerTwo
         PWM_PIN_3 = TIMERTWO_B_ARDUINO_PIN
     };
 
+    /* compile time calculation of prescaler and timer top value, same ladder as setPeriod(uint32_t) */
+    template <uint32_t Microseconds>
+    struct Period
+    {
+        /* counter runs backwards after TOP, interrupt is at BOTTOM so divide microseconds by 2 */
+        static const uint32_t TimerCycles = (F_CPU / 2000000uL) * Microseconds;
+        static const ClockSelectType ClockSelectBitGroup =
+            (TimerCycles < TIMERTWO_RESOLUTION)          ? REG_CS_NO_PRESCALER :
+            ((TimerCycles >> 3u) < TIMERTWO_RESOLUTION)  ? REG_CS_PRESCALE_8 :
+            ((TimerCycles >> 5u) < TIMERTWO_RESOLUTION)  ? REG_CS_PRESCALE_32 :
+            ((TimerCycles >> 6u) < TIMERTWO_RESOLUTION)  ? REG_CS_PRESCALE_64 :
+            ((TimerCycles >> 7u) < TIMERTWO_RESOLUTION)  ? REG_CS_PRESCALE_128 :
+            ((TimerCycles >> 8u) < TIMERTWO_RESOLUTION)  ? REG_CS_PRESCALE_256 : REG_CS_PRESCALE_1024;
+        static const byte PrescaleShiftScale =
+            (REG_CS_NO_PRESCALER == ClockSelectBitGroup) ? 0u :
+            (REG_CS_PRESCALE_8 == ClockSelectBitGroup)   ? 3u :
+            (REG_CS_PRESCALE_32 == ClockSelectBitGroup)  ? 5u :
+            (REG_CS_PRESCALE_64 == ClockSelectBitGroup)  ? 6u :
+            (REG_CS_PRESCALE_128 == ClockSelectBitGroup) ? 7u :
+            (REG_CS_PRESCALE_256 == ClockSelectBitGroup) ? 8u : 10u;
+        static const byte Top = TimerCycles >> PrescaleShiftScale;
+        /* request out of bounds? */
+        STATIC_ASSERT((Microseconds <= (0xFFFFFFFFuL / (F_CPU / 2000000uL))) && ((TimerCycles >> 10u) < TIMERTWO_RESOLUTION), PeriodOutOfBounds);
+    };
+
 /******************************************************************************************************************************************************
  *  P R I V A T E   D A T A   A N D   F U N C T I N O N S
 ******************************************************************************************************************************************************/
@@ -109,6 +222,42 @@ class TimerTwo
     TimerIsrCallbackF_void TimerOverflowCallback;
     StateType State;
     ClockSelectType ClockSelectBitGroup;
+    ModeType Mode;
+    /* copy of TOP (OCR2A or fixed TOP), updated by init, setPeriod and commitPeriod */
+    byte PwmPeriod;
+    /* counting direction, kept by read and overflow interrupt */
+    volatile bool CountingDown;
+#if (TIMERTWO_LATENCY_HISTOGRAM == STD_ON)
+    LatencyHistogram OverflowLatency;
+#endif
+#if (TIMERTWO_DUTY_TABLE == STD_ON)
+    byte DutyTable[TIMERTWO_RESOLUTION];
+#endif
+#if (TIMERTWO_CALLBACK_PROFILER == STD_ON)
+    ProfileType CallbackProfile;
+    void profileCallback(byte);
+#endif
+
+#if (TIMERTWO_SYNC_PERIOD == STD_ON)
+    /* duty cycles of OC2A and OC2B, needed to scale the compare values to a new TOP */
+    byte DutyCycleA;
+    byte DutyCycleB;
+    volatile SyncStateType SyncState;
+    byte SyncTop;
+    ClockSelectType SyncClockSelect;
+    TimerIsrCallbackF_void SyncCallback;
+    void commitPeriod();
+#endif
+
+    bool isDualSlope() const { return (MODE_PHASE_CORRECT == Mode) || (MODE_PHASE_CORRECT_FIXED_TOP == Mode); }
+    bool isTopFixed() const { return (MODE_PHASE_CORRECT_FIXED_TOP == Mode) || (MODE_FAST_PWM_FIXED_TOP == Mode); }
+    byte getTop() const { return PwmPeriod; }
+    /* longest period, dual slope counter needs twice the time */
+    uint32_t getMaxPeriod() const { return ((TIMERTWO_RESOLUTION / (F_CPU / 1000000uL)) * TIMERTWO_MAX_PRESCALER) << (isDualSlope() ? 1u : 0u); }
+    stdReturnType getPrescaleShiftScale(byte&) const;
+    stdReturnType calcPeriod(uint32_t, byte&, ClockSelectType&);
+    byte calcCompare(byte) const;
+    void updateDutyCache(byte);
 
 /******************************************************************************************************************************************************
  *  P U B L I C   F U N C T I O N S
@@ -118,11 +267,19 @@ class TimerTwo
 
     // get methods
 	StateType getState() const { return State; }
+	ModeType getMode() const { return Mode; }
+	byte getCapabilities() const;
+	bool hasCapability(CapabilityType Capability) const { return 0u != (getCapabilities() & Capability); }
 	TimerIsrCallbackF_void getTimerIsrCallbackFunction() const { return TimerOverflowCallback; }
 	
 	// set methods
-    stdReturnType init(uint32_t = 1000uL, TimerIsrCallbackF_void = nullptr);
+    stdReturnType init(uint32_t = 1000uL, TimerIsrCallbackF_void = nullptr, ModeType = MODE_PHASE_CORRECT);
     stdReturnType setPeriod(uint32_t);
+    template <uint32_t Microseconds> stdReturnType setPeriod();
+#if (TIMERTWO_SYNC_PERIOD == STD_ON)
+    stdReturnType setPeriodSync(uint32_t, TimerIsrCallbackF_void = nullptr);
+    bool isPeriodPending() const { return SYNC_IDLE != SyncState; }
+#endif
     stdReturnType enablePwm(PwmPinType, byte);
     stdReturnType disablePwm(PwmPinType);
     stdReturnType setPwmDuty(PwmPinType, byte);
@@ -132,9 +289,67 @@ class TimerTwo
     stdReturnType attachInterrupt(TimerIsrCallbackF_void);
     void detachInterrupt();
     stdReturnType read(uint32_t&);
-    void callOverflowCallback() { TimerOverflowCallback(); }
+    stdReturnType readCounter(uint16_t&);
+    stdReturnType getPwmFrequency(uint32_t&);
+    uint16_t getPwmResolution() const { return getTop() + 1u; }
+#if (TIMERTWO_LATENCY_HISTOGRAM == STD_ON)
+    void getLatency(LatencyHistogram&);
+    void clearLatency();
+    /* counter counts up from BOTTOM, so its value is the latency */
+    void enterOverflowInterrupt() { OverflowLatency.add(TCNT2); CountingDown = false; TIFR2 = (1u << OCF2A); commitPeriodPending(); }
+#else
+    void enterOverflowInterrupt() { CountingDown = false; TIFR2 = (1u << OCF2A); commitPeriodPending(); }
+#endif
+#if (TIMERTWO_SYNC_PERIOD == STD_ON)
+    void commitPeriodPending() { if(SYNC_IDLE != SyncState) commitPeriod(); }
+#else
+    void commitPeriodPending() { }
+#endif
+#if (TIMERTWO_CALLBACK_PROFILER == STD_ON)
+    void getProfile(ProfileType&);
+    void clearProfile();
+#endif
+#if (TIMERTWO_DEFERRED_CALLBACK == STD_ON)
+    void callOverflowCallback() { enterOverflowInterrupt(); if(TimerOverflowCallback != nullptr) EventQueue.post(TimerOverflowCallback); }
+#elif (TIMERTWO_CALLBACK_PROFILER == STD_ON)
+    void callOverflowCallback() { enterOverflowInterrupt(); byte Start = TCNT2; if(TimerOverflowCallback != nullptr) { TimerOverflowCallback(); profileCallback(Start); } }
+#else
+    /* overflow interrupt may be enabled by setPeriodSync() only */
+    void callOverflowCallback() { enterOverflowInterrupt(); if(TimerOverflowCallback != nullptr) TimerOverflowCallback(); }
+#endif
 };
 
+
+
+/******************************************************************************************************************************************************
+  setPeriod()
+******************************************************************************************************************************************************/
+/*! \brief          set period of Timer2 overflow interrupt at compile time
+ *  \details        prescaler and timer top value are calculated during compilation, so only the register stores
+ *                  remain. Out of bounds requests, from 32768 microseconds at 16 MHz, fail to compile. The
+ *                  calculation is done for the dual slope counter with OCR2A as TOP, in the other modes the period is
+ *                  calculated at run time.
+ *  \tparam         Microseconds				period of the timer overflow interrupt
+ *  \return         E_OK
+ *****************************************************************************************************************************************************/
+template <uint32_t Microseconds>
+stdReturnType TimerTwo::setPeriod()
+{
+    if(MODE_PHASE_CORRECT != Mode) return setPeriod(Microseconds);
+    ClockSelectBitGroup = Period<Microseconds>::ClockSelectBitGroup;
+    /* OCR2A is TOP in phase correct PWM mode */
+    PwmPeriod = Period<Microseconds>::Top;
+    OCR2A = Period<Microseconds>::Top;
+    updateDutyCache(Period<Microseconds>::Top);
+
+    if(STATE_RUNNING == State)
+    {
+        /* reset clock select register, and starts the clock */
+        writeBitGroup(TCCR2B, TIMERTWO_REG_CS_GM, TIMERTWO_REG_CS_GP, ClockSelectBitGroup);
+    }
+    return E_OK;
+} /* setPeriod */
+
 /* TimerTwo will be pre-instantiated in TimerTwo source file */
 extern TimerTwo& Timer2;
 
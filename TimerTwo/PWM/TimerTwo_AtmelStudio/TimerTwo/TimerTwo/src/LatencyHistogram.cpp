@@ -0,0 +1,105 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       LatencyHistogram.cpp
+ *      \brief      Main file of LatencyHistogram library
+ *
+ *      \details    Statistic of interrupt latencies.
+ *
+ *
+ *****************************************************************************************************************************************************/
+#define _LATENCYHISTOGRAM_SOURCE_
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include "LatencyHistogram.h"
+
+
+/******************************************************************************************************************************************************
+ * P U B L I C   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  dump()
+******************************************************************************************************************************************************/
+/*! \brief          write statistic in compact binary form
+ *  \details        count, minimum, maximum, mean and all bins are written as 16 bit little endian values
+ *
+ *  \param[out]     Buffer                      destination buffer
+ *  \param[in]      Size                        size of destination buffer
+ *  \return         number of written bytes, 0 if buffer is smaller than LATENCYHISTOGRAM_DUMP_SIZE
+ *****************************************************************************************************************************************************/
+byte LatencyHistogram::dump(byte* Buffer, byte Size) const
+{
+    uint16_t Values[4u + LATENCYHISTOGRAM_NUMBER_OF_BINS];
+
+    if(Size < LATENCYHISTOGRAM_DUMP_SIZE) return 0u;
+    Values[0] = Count;
+    Values[1] = Minimum;
+    Values[2] = Maximum;
+    Values[3] = getMean();
+    for(byte Bin = 0u; Bin < LATENCYHISTOGRAM_NUMBER_OF_BINS; Bin++) Values[4u + Bin] = Bins[Bin];
+    for(byte Index = 0u; Index < (4u + LATENCYHISTOGRAM_NUMBER_OF_BINS); Index++) {
+        *Buffer++ = (byte) Values[Index];
+        *Buffer++ = (byte) (Values[Index] >> 8u);
+    }
+    return LATENCYHISTOGRAM_DUMP_SIZE;
+} /* dump */
+
+
+/******************************************************************************************************************************************************
+  clear()
+******************************************************************************************************************************************************/
+/*! \brief          clear statistic
+ *  \details
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void LatencyHistogram::clear()
+{
+    Count = 0u;
+    Minimum = 0xFFFFu;
+    Maximum = 0u;
+    Sum = 0uL;
+    for(byte Bin = 0u; Bin < LATENCYHISTOGRAM_NUMBER_OF_BINS; Bin++) Bins[Bin] = 0u;
+} /* clear */
+
+
+/******************************************************************************************************************************************************
+  add()
+******************************************************************************************************************************************************/
+/*! \brief          add one latency
+ *  \details        has to be called with interrupts disabled, counters saturate
+ *
+ *  \param[in]      Latency                     latency in timer ticks
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void LatencyHistogram::add(uint16_t Latency)
+{
+    byte Bin = 0u;
+
+    if(Latency < Minimum) Minimum = Latency;
+    if(Latency > Maximum) Maximum = Latency;
+    if(Count < 0xFFFFu) {
+        Count++;
+        Sum += Latency;
+    }
+    while((Latency != 0u) && (Bin < (LATENCYHISTOGRAM_NUMBER_OF_BINS - 1u))) {
+        Latency >>= 1u;
+        Bin++;
+    }
+    if(Bins[Bin] < 0xFFFFu) Bins[Bin]++;
+} /* add */
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
@@ -0,0 +1,182 @@
+/******************************************************************************************************************************************************
+ *  COPYRIGHT
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  \verbatim
+ *  Copyright (c) Andreas Burnickl                                                                                                 All rights reserved.
+ *
+ *  \endverbatim
+ *  ---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -------------------------------------------------------------------------------------------------------------------------------------------------*/
+/**     \file       TimerEventQueue.cpp
+ *      \brief      Main file of TimerEventQueue library
+ *
+ *      \details    Deferred execution of timer callbacks.
+ *
+ *
+ *****************************************************************************************************************************************************/
+#define _TIMEREVENTQUEUE_SOURCE_
+
+/******************************************************************************************************************************************************
+ * INCLUDES
+ *****************************************************************************************************************************************************/
+#include "TimerEventQueue.h"
+#include <util/atomic.h>
+
+
+/******************************************************************************************************************************************************
+ * GLOBAL DATA
+ *****************************************************************************************************************************************************/
+TimerEventQueue& EventQueue = TimerEventQueue::getInstance();      // pre-instantiate TimerEventQueue
+
+
+/******************************************************************************************************************************************************
+ * C O N S T R U C T O R S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  CONSTRUCTOR OF TimerEventQueue
+******************************************************************************************************************************************************/
+/*! \brief          TimerEventQueue constructor
+ *  \details        Instantiation of the TimerEventQueue library
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+TimerEventQueue::TimerEventQueue()
+{
+    Head = 0u;
+    Tail = 0u;
+    Statistic.Coalesced = 0u;
+    Statistic.Overruns = 0u;
+    Statistic.MaxFill = 0u;
+} /* TimerEventQueue */
+
+
+/******************************************************************************************************************************************************
+  DESTRUCTOR OF TimerEventQueue
+******************************************************************************************************************************************************/
+TimerEventQueue::~TimerEventQueue()
+{
+
+} /* ~TimerEventQueue */
+
+
+/******************************************************************************************************************************************************
+  COPY CONSTRUCTOR OF TimerEventQueue
+******************************************************************************************************************************************************/
+TimerEventQueue& TimerEventQueue::getInstance()
+{
+    static TimerEventQueue SingletonInstance;
+    return SingletonInstance;
+}
+
+
+/******************************************************************************************************************************************************
+ * P U B L I C   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  getStatistic()
+******************************************************************************************************************************************************/
+/*! \brief          get counters of the queue
+ *  \details
+ *
+ *  \return         coalesced events, overruns and maximum fill level
+ *****************************************************************************************************************************************************/
+TimerEventQueue::StatisticType TimerEventQueue::getStatistic() const
+{
+    StatisticType Copy;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        Copy.Coalesced = Statistic.Coalesced;
+        Copy.Overruns = Statistic.Overruns;
+        Copy.MaxFill = Statistic.MaxFill;
+    }
+    return Copy;
+} /* getStatistic */
+
+
+/******************************************************************************************************************************************************
+  post()
+******************************************************************************************************************************************************/
+/*! \brief          queue callback for deferred execution
+ *  \details        has to be called from interrupt context. If the newest queued event has the same callback and is
+ *                  not read by process() yet, the event is merged into it.
+ *  \param[in]      Callback                    callback function
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerEventQueue::post(EventCallbackF_void Callback)
+{
+    byte Fill = Head - Tail;
+
+    /* the event at Tail may be read by process() right now, so only newer events are merged */
+    if((Fill > 1u) && (Events[(Head - 1u) & TIMEREVENTQUEUE_MASK] == Callback)) {
+        if(Statistic.Coalesced < 0xFFFFu) Statistic.Coalesced++;
+    } else if(Fill >= TIMEREVENTQUEUE_SIZE) {
+        if(Statistic.Overruns < 0xFFFFu) Statistic.Overruns++;
+    } else {
+        Events[Head & TIMEREVENTQUEUE_MASK] = Callback;
+        Head++;
+        if(++Fill > Statistic.MaxFill) Statistic.MaxFill = Fill;
+    }
+} /* post */
+
+
+/******************************************************************************************************************************************************
+  process()
+******************************************************************************************************************************************************/
+/*! \brief          execute queued callbacks
+ *  \details        has to be called from loop() or yield(), the callbacks are executed with interrupts enabled. Events
+ *                  posted while processing are left for the next call, so loop() is not starved.
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerEventQueue::process()
+{
+    EventCallbackF_void Callback;
+    byte LastHead = Head;
+
+    while(Tail != LastHead) {
+        Callback = Events[Tail & TIMEREVENTQUEUE_MASK];
+        Tail++;
+        Callback();
+    }
+} /* process */
+
+
+/******************************************************************************************************************************************************
+  clearStatistic()
+******************************************************************************************************************************************************/
+/*! \brief          clear counters of the queue
+ *  \details
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerEventQueue::clearStatistic()
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        Statistic.Coalesced = 0u;
+        Statistic.Overruns = 0u;
+        Statistic.MaxFill = 0u;
+    }
+} /* clearStatistic */
+
+
+#if (TIMEREVENTQUEUE_YIELD == STD_ON)
+/******************************************************************************************************************************************************
+  yield()
+******************************************************************************************************************************************************/
+/*! \brief          overrides the weak yield() of the arduino core
+ *  \details        delay() calls yield() while waiting
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void yield(void)
+{
+    EventQueue.process();
+} /* yield */
+#endif
+
+
+/******************************************************************************************************************************************************
+ *  E N D   O F   F I L E
+ *****************************************************************************************************************************************************/
\ No newline at end of file
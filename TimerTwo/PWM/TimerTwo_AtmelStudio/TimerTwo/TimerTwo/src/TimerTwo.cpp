@@ -46,6 +46,22 @@ TimerTwo::TimerTwo()
 	State = STATE_INIT;
 	TimerOverflowCallback = nullptr;
 	ClockSelectBitGroup = REG_CS_NO_CLOCK;
+	Mode = MODE_PHASE_CORRECT;
+	PwmPeriod = TIMERTWO_FIXED_TOP;
+	CountingDown = false;
+#if (TIMERTWO_CALLBACK_PROFILER == STD_ON)
+	CallbackProfile.MaxDuration = 0u;
+	CallbackProfile.Overruns = 0u;
+	CallbackProfile.MissedPeriods = 0u;
+#endif
+#if (TIMERTWO_SYNC_PERIOD == STD_ON)
+	DutyCycleA = 0u;
+	DutyCycleB = 0u;
+	SyncState = SYNC_IDLE;
+	SyncTop = 0u;
+	SyncClockSelect = REG_CS_NO_CLOCK;
+	SyncCallback = nullptr;
+#endif
 } /* TimerTwo */
 
 
@@ -80,11 +96,13 @@ TimerTwo& TimerTwo::getInstance()
  *                  
  *  \param[in]      Microseconds				period of the timer overflow interrupt
  *  \param[in]      sTimerOverflowCallback      Callback function which should be called when timer overflow interrupt occurs
+ *  \param[in]      sMode						pwm mode, fast pwm has the overflow interrupt at TOP, modes with fixed
+ *                                              TOP have pwm on both pins
  *  \return         E_OK
  *                  E_NOT_OK
  *  \pre			Timer has to be in NONE state
  *****************************************************************************************************************************************************/
-stdReturnType TimerTwo::init(uint32_t Microseconds, TimerIsrCallbackF_void sTimerOverflowCallback)
+stdReturnType TimerTwo::init(uint32_t Microseconds, TimerIsrCallbackF_void sTimerOverflowCallback, ModeType sMode)
 {
 	stdReturnType ReturnValue = E_NOT_OK;
 
@@ -94,10 +112,34 @@ stdReturnType TimerTwo::init(uint32_t Microseconds, TimerIsrCallbackF_void sTime
 	    TCCR2A = 0u;
 	    TCCR2B = 0u;
 	    
-	    /* set mode 5: phase correct PWM */
-	    writeBit(TCCR2A, WGM20, 1u);
-	    writeBit(TCCR2A, WGM21, 0u);
-	    writeBit(TCCR2B, WGM22, 1u);
+		Mode = sMode;
+		switch (Mode)
+		{
+			case MODE_FAST_PWM:
+				/* set mode 7: fast PWM with OCR2A as TOP */
+				writeBit(TCCR2A, WGM20, 1u);
+				writeBit(TCCR2A, WGM21, 1u);
+				writeBit(TCCR2B, WGM22, 1u);
+				break;
+			case MODE_PHASE_CORRECT_FIXED_TOP:
+				/* set mode 1: phase correct PWM with TOP 0xFF */
+				writeBit(TCCR2A, WGM20, 1u);
+				writeBit(TCCR2A, WGM21, 0u);
+				writeBit(TCCR2B, WGM22, 0u);
+				break;
+			case MODE_FAST_PWM_FIXED_TOP:
+				/* set mode 3: fast PWM with TOP 0xFF */
+				writeBit(TCCR2A, WGM20, 1u);
+				writeBit(TCCR2A, WGM21, 1u);
+				writeBit(TCCR2B, WGM22, 0u);
+				break;
+			default:
+				/* set mode 5: phase correct PWM */
+				Mode = MODE_PHASE_CORRECT;
+				writeBit(TCCR2A, WGM20, 1u);
+				writeBit(TCCR2A, WGM21, 0u);
+				writeBit(TCCR2B, WGM22, 1u);
+		}
 		
 		if(E_NOT_OK == setPeriod(Microseconds)) ReturnValue = E_NOT_OK;
 		if(sTimerOverflowCallback != nullptr) if(E_NOT_OK == attachInterrupt(sTimerOverflowCallback)) ReturnValue = E_NOT_OK;
@@ -113,7 +155,8 @@ stdReturnType TimerTwo::init(uint32_t Microseconds, TimerIsrCallbackF_void sTime
 ******************************************************************************************************************************************************/
 /*! \brief          set period of Timer2 overflow interrupt
  *  \details        this functions sets the period of the Timer2 overflow interrupt therefore 
- *                  prescaler and timer top value will be calculated
+ *                  prescaler and timer top value will be calculated. With fixed TOP the smallest prescaler which
+ *                  reaches the period is used, so the period is longer up to the next prescaler step.
  *  \param[in]      Microseconds				period of the timer overflow interrupt
  *  \return         E_OK
  *                  E_NOT_OK
@@ -121,29 +164,16 @@ stdReturnType TimerTwo::init(uint32_t Microseconds, TimerIsrCallbackF_void sTime
 stdReturnType TimerTwo::setPeriod(uint32_t Microseconds)
 {
 	stdReturnType ReturnValue = E_NOT_OK;
-	uint32_t TimerCycles;
-    const uint32_t MicrosecondsMax = ((TIMERTWO_RESOLUTION / (F_CPU / 1000000uL)) * TIMERTWO_MAX_PRESCALER * 2u);
-
-    if(Microseconds <= MicrosecondsMax) {
-        ReturnValue = E_OK;
-        /* calculate timer cycles to reach timer period, counter runs backwards after TOP, interrupt is at BOTTOM so divide microseconds by 2 */
-        TimerCycles = (F_CPU / 2000000uL) * Microseconds;
-        /* calculate timer pre-scaler */
-        if(TimerCycles < TIMERTWO_RESOLUTION)               ClockSelectBitGroup = REG_CS_NO_PRESCALER;
-        else if((TimerCycles >>= 3u) < TIMERTWO_RESOLUTION) ClockSelectBitGroup = REG_CS_PRESCALE_8;
-        else if((TimerCycles >>= 2u) < TIMERTWO_RESOLUTION) ClockSelectBitGroup = REG_CS_PRESCALE_32;
-        else if((TimerCycles >>= 1u) < TIMERTWO_RESOLUTION) ClockSelectBitGroup = REG_CS_PRESCALE_64;
-        else if((TimerCycles >>= 1u) < TIMERTWO_RESOLUTION) ClockSelectBitGroup = REG_CS_PRESCALE_128;
-        else if((TimerCycles >>= 1u) < TIMERTWO_RESOLUTION) ClockSelectBitGroup = REG_CS_PRESCALE_256;
-        else if((TimerCycles >>= 2u) < TIMERTWO_RESOLUTION) ClockSelectBitGroup = REG_CS_PRESCALE_1024;
-        else {
-            /* request was out of bounds, set as maximum */
-            TimerCycles = TIMERTWO_RESOLUTION - 1u;
-            ClockSelectBitGroup = REG_CS_PRESCALE_1024;
-            ReturnValue = E_NOT_OK;
+	byte Top;
+
+    if(Microseconds <= getMaxPeriod()) {
+        ReturnValue = calcPeriod(Microseconds, Top, ClockSelectBitGroup);
+        /* OCR2A is TOP, unless TOP is fixed */
+        if(!isTopFixed()) {
+            PwmPeriod = Top;
+            OCR2A = Top;
         }
-        /* OCR2A is TOP in phase correct PWM mode */
-        OCR2A = TimerCycles;
+        updateDutyCache(Top);
 
         if(STATE_RUNNING == State)
         {
@@ -155,11 +185,66 @@ stdReturnType TimerTwo::setPeriod(uint32_t Microseconds)
 } /* setPeriod */
 
 
+#if (TIMERTWO_SYNC_PERIOD == STD_ON)
+/******************************************************************************************************************************************************
+  setPeriodSync()
+******************************************************************************************************************************************************/
+/*! \brief          change period of running timer at BOTTOM
+ *  \details        the new TOP, prescaler and duty cycle are staged and applied by the overflow interrupt. In phase
+ *                  correct mode the compare buffers are loaded at the next BOTTOM, they are taken over by the hardware
+ *                  at TOP. The prescaler is set at the BOTTOM after that. Timer2 updates its compare registers at TOP,
+ *                  so the falling half of this one period already counts down from the new TOP, but with the old
+ *                  prescaler. In fast pwm mode compare buffers and prescaler are taken over at the same BOTTOM, see
+ *                  commitPeriod().
+ *                  If the timer is not running, the period is set immediately like setPeriod().
+ *  \param[in]      Microseconds				period of the timer overflow interrupt
+ *  \param[in]      sSyncCallback				called by the overflow interrupt when the new period is active
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *****************************************************************************************************************************************************/
+stdReturnType TimerTwo::setPeriodSync(uint32_t Microseconds, TimerIsrCallbackF_void sSyncCallback)
+{
+	stdReturnType ReturnValue = E_NOT_OK;
+	byte Top;
+	ClockSelectType ClockSelect;
+	byte InterruptState;
+	uint16_t Ticks;
+
+	if(STATE_RUNNING != State) return setPeriod(Microseconds);
+    if(Microseconds <= getMaxPeriod()) {
+        ReturnValue = calcPeriod(Microseconds, Top, ClockSelect);
+#if (TIMERTWO_DUTY_TABLE == STD_ON)
+        /* a pending change must not read the duty table while it is rebuilt, it is restarted below */
+        SyncState = SYNC_IDLE;
+        updateDutyCache(Top);
+#endif
+        InterruptState = SREG;
+        cli();
+        SyncTop = Top;
+        SyncClockSelect = ClockSelect;
+        SyncCallback = sSyncCallback;
+        SyncState = SYNC_PENDING;
+        SREG = InterruptState;
+        if(!(TIMSK2 & (1u << TOIE2))) {
+            /* an overflow flag of a BOTTOM passed before must not commit the period at once. In phase correct mode
+               readCounter() clears it and keeps the counting direction it shows. */
+            if(MODE_PHASE_CORRECT == Mode) readCounter(Ticks);
+            else TIFR2 = (1u << TOV2);
+        }
+        /* the overflow interrupt commits the period, even without callback */
+        writeBit(TIMSK2, TOIE2, 1u);
+    }
+	return ReturnValue;
+} /* setPeriodSync */
+#endif
+
+
 /******************************************************************************************************************************************************
   enablePwm()
 ******************************************************************************************************************************************************/
 /*! \brief          enable Pwm on given Pin
- *  \details        this function enables Pwm on given Pin with given duty cycle
+ *  \details        this function enables Pwm on given Pin with given duty cycle. Pin 11 needs a mode with fixed TOP,
+ *                  otherwise OCR2A is TOP.
  *
  *  \param[in]      PwmPin					pin where pwm should be enabled
  *  \param[in]      DutyCycle				duty cycle of pwm
@@ -178,7 +263,7 @@ stdReturnType TimerTwo::enablePwm(PwmPinType PwmPin, byte DutyCycle)
 			pinMode(PWM_PIN_3, OUTPUT);
 			/* activate compare output mode in timer control register */
 			writeBit(TCCR2A, COM2B1, 1u);
-		} else if(PWM_PIN_11 == PwmPin) {
+		} else if((PWM_PIN_11 == PwmPin) && isTopFixed()) {
            ReturnValue = E_OK;
            pinMode(PWM_PIN_11, OUTPUT);
            /* activate compare output mode in timer control register */
@@ -220,8 +305,8 @@ stdReturnType TimerTwo::disablePwm(PwmPinType PwmPin)
   setPwmDuty()
 ******************************************************************************************************************************************************/
 /*! \brief          set pwm duty cycle on given pin
- *  \details        
- *                  
+ *  \details        the compare value is calculated from TOP by an 8 x 8 bit multiplication or read from the duty
+ *                  table. Pin 11 needs a mode with fixed TOP, there the duty cycle is the compare value.
  *  \param[in]      PwmPin					pin where pwm duty cycle should be set
  *  \param[in]      DutyCycle				duty cycle of pwm
  *  \return         E_OK
@@ -231,18 +316,30 @@ stdReturnType TimerTwo::disablePwm(PwmPinType PwmPin)
 stdReturnType TimerTwo::setPwmDuty(PwmPinType PwmPin, byte DutyCycle)
 {
 	stdReturnType ReturnValue = E_NOT_OK;
-	uint32_t DutyCycleTrans;
 
 	if((STATE_IDLE == State) || (STATE_RUNNING == State) || (STATE_STOPPED == State)) {
 		/* duty cycle out of bound? */
 		if(DutyCycle <= TIMERTWO_RESOLUTION) {
-			/* use rule of three to calculate duty cycle related to timer top value */
-			DutyCycleTrans = OCR2A * DutyCycle;
-			DutyCycleTrans >>= TIMERTWO_NUMBER_OF_BITS;
 			/* set output compare register value for given pwm pin */
 			if(PWM_PIN_3 == PwmPin) {
                 ReturnValue = E_OK;
-                OCR2B = DutyCycleTrans;
+#if (TIMERTWO_SYNC_PERIOD == STD_ON)
+                /* while a period change is pending, the compare value is loaded by the overflow interrupt. Only
+                 * setPeriodSync() makes a change pending, so no critical section is needed: if none is pending here,
+                 * the interrupt does not change TOP until OCR2B is written. */
+                DutyCycleB = DutyCycle;
+                if(SYNC_PENDING != SyncState) OCR2B = calcCompare(DutyCycle);
+#else
+                OCR2B = calcCompare(DutyCycle);
+#endif
+            } else if((PWM_PIN_11 == PwmPin) && isTopFixed()) {
+                ReturnValue = E_OK;
+#if (TIMERTWO_SYNC_PERIOD == STD_ON)
+                DutyCycleA = DutyCycle;
+                if(SYNC_PENDING != SyncState) OCR2A = DutyCycle;
+#else
+                OCR2A = DutyCycle;
+#endif
             }
 		}
     }
@@ -265,8 +362,10 @@ stdReturnType TimerTwo::start()
 	byte TCNT2_tmp;
 
 	if((STATE_IDLE == State) || (STATE_STOPPED == State)) {
-		/* reset counter value */
+		/* reset counter value and direction */
 		TCNT2 = 0u;
+		CountingDown = false;
+		TIFR2 = TIMERTWO_PHASE_FLAGS;
 		/* start counter by setting clock select register */
 		writeBitGroup(TCCR2B, TIMERTWO_REG_CS_GM, TIMERTWO_REG_CS_GP, ClockSelectBitGroup);
 		/* set overflow interrupt, if callback is set */
@@ -345,6 +444,25 @@ stdReturnType TimerTwo::attachInterrupt(TimerIsrCallbackF_void sTimerOverflowCal
 } /* attachInterrupt */
 
 
+/******************************************************************************************************************************************************
+  getCapabilities()
+******************************************************************************************************************************************************/
+/*! \brief          get capabilities of the current pwm mode
+ *  \details        modes with OCR2A as TOP set the period exactly, modes with fixed TOP have pwm on both pins
+ *
+ *  \return         capabilities as CapabilityType bits
+ *****************************************************************************************************************************************************/
+byte TimerTwo::getCapabilities() const
+{
+    byte Capabilities = CAPABILITY_PWM_PIN_3;
+
+    if(isTopFixed()) Capabilities |= CAPABILITY_PWM_PIN_11;
+    else Capabilities |= CAPABILITY_EXACT_PERIOD;
+    if(isDualSlope()) Capabilities |= CAPABILITY_SYMMETRIC_PULSES;
+    return Capabilities;
+} /* getCapabilities */
+
+
 /******************************************************************************************************************************************************
   detachInterrupt()
 ******************************************************************************************************************************************************/
@@ -360,6 +478,86 @@ void TimerTwo::detachInterrupt()
 } /* detachInterrupt */
 
 
+#if (TIMERTWO_LATENCY_HISTOGRAM == STD_ON)
+/******************************************************************************************************************************************************
+  getLatency()
+******************************************************************************************************************************************************/
+/*! \brief          read latency statistic of the overflow interrupt
+ *  \details        latencies are in timer ticks, from BOTTOM to the entry of the overflow interrupt
+ *
+ *  \param[out]     Latency                     copy of the statistic
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerTwo::getLatency(LatencyHistogram& Latency)
+{
+    byte InterruptState = SREG;
+
+    cli();
+    Latency = OverflowLatency;
+    SREG = InterruptState;
+} /* getLatency */
+
+
+/******************************************************************************************************************************************************
+  clearLatency()
+******************************************************************************************************************************************************/
+/*! \brief          clear latency statistic of the overflow interrupt
+ *  \details
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerTwo::clearLatency()
+{
+    byte InterruptState = SREG;
+
+    cli();
+    OverflowLatency.clear();
+    SREG = InterruptState;
+} /* clearLatency */
+#endif
+
+
+#if (TIMERTWO_CALLBACK_PROFILER == STD_ON)
+/******************************************************************************************************************************************************
+  getProfile()
+******************************************************************************************************************************************************/
+/*! \brief          read run time statistic of the overflow callback
+ *  \details
+ *
+ *  \param[out]     Profile                     copy of the statistic
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerTwo::getProfile(ProfileType& Profile)
+{
+    byte InterruptState = SREG;
+
+    cli();
+    Profile = CallbackProfile;
+    SREG = InterruptState;
+} /* getProfile */
+
+
+/******************************************************************************************************************************************************
+  clearProfile()
+******************************************************************************************************************************************************/
+/*! \brief          clear run time statistic of the overflow callback
+ *  \details
+ *
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerTwo::clearProfile()
+{
+    byte InterruptState = SREG;
+
+    cli();
+    CallbackProfile.MaxDuration = 0u;
+    CallbackProfile.Overruns = 0u;
+    CallbackProfile.MissedPeriods = 0u;
+    SREG = InterruptState;
+} /* clearProfile */
+#endif
+
+
 /******************************************************************************************************************************************************
   read()
 ******************************************************************************************************************************************************/
@@ -374,58 +572,368 @@ void TimerTwo::detachInterrupt()
 stdReturnType TimerTwo::read(uint32_t& Microseconds)
 {
 	stdReturnType ReturnValue = E_NOT_OK;
-	byte TCNT2_tmp;
-	int CounterValue;
+	uint16_t CounterValue;
 	byte PrescaleShiftScale = 0u;
 
-	if((STATE_RUNNING == State) || (STATE_STOPPED == State)) {
+	if(E_OK == readCounter(CounterValue)) {
+		ReturnValue = getPrescaleShiftScale(PrescaleShiftScale);
+		/* transform counter value to microseconds in an efficient way */
+		Microseconds = ((CounterValue * 1000uL) / (F_CPU / 1000uL)) << PrescaleShiftScale;
+	}
+	return ReturnValue;
+} /* read */
+
+
+/******************************************************************************************************************************************************
+  readCounter()
+******************************************************************************************************************************************************/
+/*! \brief          read current position in the period in timer ticks
+ *  \details        the counting direction is taken from the TOP (OCF2A) and BOTTOM (TOV2) flags, so no waiting for the
+ *                  counter is needed. The result is not scaled by the prescaler.
+ *                  Only if neither the overflow interrupt is enabled nor read was called within half a period, both
+ *                  flags are set and the direction is found out by waiting one counter tick.
+ *                  In fast PWM mode the counter only counts up, so it is the position in the period. In phase correct
+ *                  mode with fixed TOP there is no TOP flag, so the direction is always found out by waiting one
+ *                  counter tick.
+ *  \param[out]     Ticks				timer ticks since BOTTOM, up to two times TOP
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre			Timer has to be in RUNNING or STOPPED STATE
+ *****************************************************************************************************************************************************/
+stdReturnType TimerTwo::readCounter(uint16_t& Ticks)
+{
+	stdReturnType ReturnValue = E_NOT_OK;
+	byte CounterValue;
+	byte CounterValueNext;
+	byte Top;
+	byte Flags;
+	byte InterruptState;
+
+	if(((STATE_RUNNING == State) || (STATE_STOPPED == State)) && !isDualSlope()) {
         ReturnValue = E_OK;
-		/* save current timer value */
+        Ticks = TCNT2;
+	} else if(((STATE_RUNNING == State) || (STATE_STOPPED == State)) && isTopFixed()) {
+        ReturnValue = E_OK;
+		InterruptState = SREG;
+		noInterrupts();
 		CounterValue = TCNT2;
-		switch (ClockSelectBitGroup)
-		{
-			case REG_CS_NO_PRESCALER:
-				PrescaleShiftScale = 0u;
-				break;
-			case REG_CS_PRESCALE_8:
-				PrescaleShiftScale = 3u;
-				break;
-			case REG_CS_PRESCALE_32:
-				PrescaleShiftScale = 5u;
-				break;
-			case REG_CS_PRESCALE_64:
-				PrescaleShiftScale = 6u;
-				break;
-			case REG_CS_PRESCALE_128:
-				PrescaleShiftScale = 7u;
-				break;
-			case REG_CS_PRESCALE_256:
-				PrescaleShiftScale = 8u;
-				break;
-			case REG_CS_PRESCALE_1024:
-				PrescaleShiftScale = 10u;
-				break;
-			default:
-				ReturnValue = E_NOT_OK;
+		if(STATE_RUNNING == State) {
+			do { CounterValueNext = TCNT2; } while (CounterValueNext == CounterValue);
+			CountingDown = (CounterValueNext < CounterValue);
+		}
+		SREG = InterruptState;
+		if(CountingDown) Ticks = (2u * TIMERTWO_FIXED_TOP) - CounterValue;
+		else Ticks = CounterValue;
+	} else if((STATE_RUNNING == State) || (STATE_STOPPED == State)) {
+        ReturnValue = E_OK;
+		InterruptState = SREG;
+		noInterrupts();
+		/* save current timer value, read it again if TOP or BOTTOM was passed while reading */
+		Flags = TIFR2 & TIMERTWO_PHASE_FLAGS;
+		CounterValue = TCNT2;
+		if(Flags != (TIFR2 & TIMERTWO_PHASE_FLAGS)) {
+			Flags = TIFR2 & TIMERTWO_PHASE_FLAGS;
+			CounterValue = TCNT2;
+		}
+		Top = PwmPeriod;
+		if((1u << OCF2A) == Flags) {
+			/* TOP was passed since last BOTTOM */
+			CountingDown = true;
+		} else if(Flags & (1u << TOV2)) {
+			if(((1u << TOV2) == Flags) || (TIMSK2 & (1u << TOIE2))) {
+				/* BOTTOM was passed, pending overflow interrupt means BOTTOM was passed last */
+				CountingDown = false;
+			} else if(STATE_RUNNING == State) {
+				/* TOP and BOTTOM were passed, wait one counter tick, needed to find out counter counting up or down */
+				do { CounterValueNext = TCNT2; } while (CounterValueNext == CounterValue);
+				CountingDown = (CounterValueNext < CounterValue);
+			}
 		}
-		/* wait one counter tick, needed to find out counter counting up or down */
-		do { TCNT2_tmp = TCNT2;	} while (TCNT2_tmp == CounterValue);
+		/* clear evaluated flags, a pending overflow interrupt is cleared by hardware */
+		if(TIMSK2 & (1u << TOIE2)) Flags &= ~(1u << TOV2);
+		TIFR2 = Flags;
+		SREG = InterruptState;
 		/* if counter counting down, add top value to current value */
-		if(TCNT2_tmp < CounterValue) CounterValue = (int) (OCR2A - CounterValue) + (int) OCR2A;
-		/* transform counter value to microseconds in an efficient way */
-		Microseconds = ((CounterValue * 1000uL) / (F_CPU / 1000uL)) << PrescaleShiftScale;
+		if(CountingDown) Ticks = (2u * Top) - CounterValue;
+		else Ticks = CounterValue;
 	}
 	return ReturnValue;
-} /* read */
+} /* readCounter */
+
+
+/******************************************************************************************************************************************************
+  getPwmFrequency()
+******************************************************************************************************************************************************/
+/*! \brief          read PWM frequency of current period and mode
+ *  \details        fast PWM has twice the frequency of phase correct PWM at the same TOP, the resolution is given
+ *                  by getPwmResolution()
+ *  \param[out]     Frequency			PWM frequency in hertz, rounded down
+ *  \return         E_OK
+ *                  E_NOT_OK
+ *  \pre			Timer has to be in IDLE, RUNNING or STOPPED state
+ *****************************************************************************************************************************************************/
+stdReturnType TimerTwo::getPwmFrequency(uint32_t& Frequency)
+{
+    stdReturnType ReturnValue = E_NOT_OK;
+    byte PrescaleShiftScale;
+    uint16_t TicksPerPeriod;
+
+    if((STATE_IDLE == State) || (STATE_RUNNING == State) || (STATE_STOPPED == State)) {
+        ReturnValue = getPrescaleShiftScale(PrescaleShiftScale);
+        /* single slope counts from BOTTOM to TOP, dual slope up and down again */
+        if(isDualSlope()) TicksPerPeriod = 2u * getTop();
+        else TicksPerPeriod = getTop() + 1u;
+        if((E_OK == ReturnValue) && (TicksPerPeriod != 0u)) Frequency = (F_CPU >> PrescaleShiftScale) / TicksPerPeriod;
+        else ReturnValue = E_NOT_OK;
+    }
+    return ReturnValue;
+} /* getPwmFrequency */
+
+
+/******************************************************************************************************************************************************
+ * P R I V A T E   F U N C T I O N S
+ *****************************************************************************************************************************************************/
+
+/******************************************************************************************************************************************************
+  calcPeriod()
+******************************************************************************************************************************************************/
+/*! \brief          calculate prescaler and timer top value of a period
+ *  \details
+ *
+ *  \param[in]      Microseconds				period of the timer overflow interrupt
+ *  \param[out]     Top						timer top value
+ *  \param[out]     ClockSelect				clock select bit group of the prescaler
+ *  \return         E_OK
+ *                  E_NOT_OK if period is too long, then it is set to the maximum
+ *****************************************************************************************************************************************************/
+stdReturnType TimerTwo::calcPeriod(uint32_t Microseconds, byte& Top, ClockSelectType& ClockSelect)
+{
+    stdReturnType ReturnValue = E_OK;
+    uint32_t TimerCycles;
+
+    /* calculate timer cycles to reach timer period, in dual slope mode counter runs backwards after TOP, interrupt is at BOTTOM so divide microseconds by 2 */
+    if(isDualSlope()) TimerCycles = (F_CPU / 2000000uL) * Microseconds;
+    else TimerCycles = (F_CPU / 1000000uL) * Microseconds;
+
+    /* calculate timer pre-scaler */
+    if(TimerCycles < TIMERTWO_RESOLUTION)               ClockSelect = REG_CS_NO_PRESCALER;
+    else if((TimerCycles >>= 3u) < TIMERTWO_RESOLUTION) ClockSelect = REG_CS_PRESCALE_8;
+    else if((TimerCycles >>= 2u) < TIMERTWO_RESOLUTION) ClockSelect = REG_CS_PRESCALE_32;
+    else if((TimerCycles >>= 1u) < TIMERTWO_RESOLUTION) ClockSelect = REG_CS_PRESCALE_64;
+    else if((TimerCycles >>= 1u) < TIMERTWO_RESOLUTION) ClockSelect = REG_CS_PRESCALE_128;
+    else if((TimerCycles >>= 1u) < TIMERTWO_RESOLUTION) ClockSelect = REG_CS_PRESCALE_256;
+    else if((TimerCycles >>= 2u) < TIMERTWO_RESOLUTION) ClockSelect = REG_CS_PRESCALE_1024;
+    else {
+        /* request was out of bounds, set as maximum */
+        TimerCycles = TIMERTWO_RESOLUTION - 1u;
+        ClockSelect = REG_CS_PRESCALE_1024;
+        ReturnValue = E_NOT_OK;
+    }
+    /* single slope period is TOP + 1 timer cycles */
+    if(isTopFixed()) TimerCycles = TIMERTWO_FIXED_TOP;
+    else if(!isDualSlope() && (TimerCycles > 0u)) TimerCycles--;
+    Top = TimerCycles;
+    return ReturnValue;
+} /* calcPeriod */
+
+
+/******************************************************************************************************************************************************
+  getPrescaleShiftScale()
+******************************************************************************************************************************************************/
+/*! \brief          get prescaler as power of two
+ *  \details
+ *
+ *  \param[out]     PrescaleShiftScale		prescaler of current clock select
+ *  \return         E_OK
+ *                  E_NOT_OK if no clock is selected
+ *****************************************************************************************************************************************************/
+stdReturnType TimerTwo::getPrescaleShiftScale(byte& PrescaleShiftScale) const
+{
+    stdReturnType ReturnValue = E_OK;
+
+    switch (ClockSelectBitGroup)
+    {
+        case REG_CS_NO_PRESCALER:
+            PrescaleShiftScale = 0u;
+            break;
+        case REG_CS_PRESCALE_8:
+            PrescaleShiftScale = 3u;
+            break;
+        case REG_CS_PRESCALE_32:
+            PrescaleShiftScale = 5u;
+            break;
+        case REG_CS_PRESCALE_64:
+            PrescaleShiftScale = 6u;
+            break;
+        case REG_CS_PRESCALE_128:
+            PrescaleShiftScale = 7u;
+            break;
+        case REG_CS_PRESCALE_256:
+            PrescaleShiftScale = 8u;
+            break;
+        case REG_CS_PRESCALE_1024:
+            PrescaleShiftScale = 10u;
+            break;
+        default:
+            PrescaleShiftScale = 0u;
+            ReturnValue = E_NOT_OK;
+    }
+    return ReturnValue;
+} /* getPrescaleShiftScale */
+
+
+/******************************************************************************************************************************************************
+  calcCompare()
+******************************************************************************************************************************************************/
+/*! \brief          calculate compare value of a duty cycle
+ *  \details        the compare value is calculated from the copy of TOP by an 8 x 8 bit multiplication or read from
+ *                  the duty table, so OCR2A is not read. With fixed TOP the duty cycle is the compare value.
+ *  \param[in]      DutyCycle				duty cycle of pwm
+ *  \return         compare value
+ *****************************************************************************************************************************************************/
+byte TimerTwo::calcCompare(byte DutyCycle) const
+{
+    if(isTopFixed()) return DutyCycle;
+#if (TIMERTWO_DUTY_TABLE == STD_ON)
+    return DutyTable[DutyCycle];
+#else
+    /* use rule of three to calculate duty cycle related to timer top value */
+    return ((uint16_t) PwmPeriod * DutyCycle) >> TIMERTWO_NUMBER_OF_BITS;
+#endif
+} /* calcCompare */
+
+
+#if (TIMERTWO_SYNC_PERIOD == STD_ON)
+/******************************************************************************************************************************************************
+  commitPeriod()
+******************************************************************************************************************************************************/
+/*! \brief          apply staged period
+ *  \details        this function is called by the overflow interrupt. In phase correct mode the counter has just left
+ *                  BOTTOM, the first call writes the compare buffers, OCR2A reads back the new TOP from then on. The
+ *                  second call sets the prescaler, the compare registers were taken over at TOP before.
+ *                  In fast pwm mode the interrupt is at TOP and the compare buffers are taken over at BOTTOM. The
+ *                  counter is held at TOP while they are written and restarted with the new prescaler, so TOP,
+ *                  compare value and prescaler change at the same BOTTOM. If the counter has already left TOP, the
+ *                  interrupt was late and the next call sets the prescaler, SyncTop keeps the TOP of the period in
+ *                  between. If the counter has already counted after BOTTOM when the prescaler is changed, it is
+ *                  converted to ticks of the new prescaler.
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerTwo::commitPeriod()
+{
+    /* TOP of the running period, OCR2A reads back the compare buffer */
+    byte Top = SyncTop;
+    uint16_t Ticks;
+    byte OldShiftScale;
+    byte NewShiftScale;
+
+    if(SYNC_PENDING == SyncState) {
+        Top = getTop();
+        if(!isDualSlope() && (TCNT2 == Top)) writeBitGroup(TCCR2B, TIMERTWO_REG_CS_GM, TIMERTWO_REG_CS_GP, REG_CS_NO_CLOCK);
+        if(isTopFixed()) {
+            OCR2A = calcCompare(DutyCycleA);
+        } else {
+            PwmPeriod = SyncTop;
+            OCR2A = SyncTop;
+        }
+        OCR2B = calcCompare(DutyCycleB);
+        SyncState = SYNC_COMPARE_LOADED;
+        if(isDualSlope() || (TCNT2 != Top)) {
+            if(!isDualSlope()) writeBitGroup(TCCR2B, TIMERTWO_REG_CS_GM, TIMERTWO_REG_CS_GP, ClockSelectBitGroup);
+            SyncTop = Top;
+            return;
+        }
+    }
+    /* in fast pwm mode the counter is at TOP of the old period or has already counted after BOTTOM */
+    Ticks = TCNT2;
+    getPrescaleShiftScale(OldShiftScale);
+    ClockSelectBitGroup = SyncClockSelect;
+    getPrescaleShiftScale(NewShiftScale);
+    writeBitGroup(TCCR2B, TIMERTWO_REG_CS_GM, TIMERTWO_REG_CS_GP, ClockSelectBitGroup);
+    if((Ticks > 0u) && (Ticks != Top)) {
+        /* interrupt was late, the ticks since BOTTOM were counted with the old prescaler */
+        Ticks = (Ticks << OldShiftScale) >> NewShiftScale;
+        Top = getTop();
+        TCNT2 = (Ticks < Top) ? Ticks : Top;
+    }
+    SyncState = SYNC_IDLE;
+    if(TimerOverflowCallback == nullptr) writeBit(TIMSK2, TOIE2, 0u);
+    if(SyncCallback != nullptr) SyncCallback();
+} /* commitPeriod */
+#endif
+
+
+#if (TIMERTWO_CALLBACK_PROFILER == STD_ON)
+/******************************************************************************************************************************************************
+  profileCallback()
+******************************************************************************************************************************************************/
+/*! \brief          update run time statistic of the overflow callback
+ *  \details        the counter position is measured from BOTTOM, counting up to TOP and down again. OCF2A shows TOP
+ *                  and TOV2 shows BOTTOM were passed during the callback. More than two periods can not be told apart
+ *                  from one by counter and flags. In fast PWM mode the counter only counts up and TOV2 shows the
+ *                  wrap at TOP.
+ *  \param[in]      Start                       counter value before the callback, counting up
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerTwo::profileCallback(byte Start)
+{
+    byte End = TCNT2;
+    byte Flags = TIFR2;
+    uint16_t Top = getTop();
+    uint16_t Period = isDualSlope() ? (2u * Top) : (Top + 1u);
+    uint16_t Duration;
+
+    if(Flags & (1u << TOV2)) {
+        /* next BOTTOM passed, counter counts up again */
+        Duration = Period + End - Start;
+        if(CallbackProfile.Overruns < 0xFFFFu) CallbackProfile.Overruns++;
+        if(End >= Start) {
+            if(CallbackProfile.MissedPeriods < 0xFFFFu) CallbackProfile.MissedPeriods++;
+        }
+    } else if((MODE_PHASE_CORRECT == Mode) && (Flags & (1u << OCF2A))) {
+        /* TOP passed, counter counts down */
+        Duration = Period - End - Start;
+    } else if((MODE_PHASE_CORRECT_FIXED_TOP == Mode) && (End < Start)) {
+        /* no TOP flag with fixed TOP, counter below start means TOP was passed */
+        Duration = Period - End - Start;
+    } else {
+        Duration = End - Start;
+    }
+    if(Duration > CallbackProfile.MaxDuration) CallbackProfile.MaxDuration = Duration;
+} /* profileCallback */
+#endif
+
+
+/******************************************************************************************************************************************************
+  updateDutyCache()
+******************************************************************************************************************************************************/
+/*! \brief          update duty table
+ *  \details        this function is called by setPeriod, only then TOP changes
+ *                  
+ *  \param[in]      Top						new value of OCR2A
+ *  \return         -
+ *****************************************************************************************************************************************************/
+void TimerTwo::updateDutyCache(byte Top)
+{
+#if (TIMERTWO_DUTY_TABLE == STD_ON)
+    for(uint16_t Index = 0u; Index < TIMERTWO_RESOLUTION; Index++) {
+        DutyTable[Index] = ((uint16_t) Top * Index) >> TIMERTWO_NUMBER_OF_BITS;
+    }
+#else
+    (void) Top;
+#endif
+} /* updateDutyCache */
 
 
 /******************************************************************************************************************************************************
   I S R   F U N C T I O N S
 ******************************************************************************************************************************************************/
+#if (TIMERTWO_STATIC_ISR == STD_OFF)
 ISR(TIMER2_OVF_vect)
 {
 	Timer2.callOverflowCallback();
 }
+#endif
 
 
 /******************************************************************************************************************************************************